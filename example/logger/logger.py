@@ -1,6 +1,7 @@
 import argparse
 import asyncio
 import csv
+import time
 import requests
 import websockets
 import websockets.asyncio
@@ -29,6 +30,10 @@ class OdroidPowerLogger:
         self.ws_url = f"ws://{self.host}/ws"
         self.output_file = output_file
         self.token = None
+        # Wall clock minus the device esp_timer clock, from the latest ClockSync
+        self.clock_offset_us = None
+        # While SensorBatch frames arrive, the CSV takes their samples instead of the windows
+        self.last_batch_time = 0.0
 
     def login(self):
         """Logs into the server to retrieve an authentication token."""
@@ -97,30 +102,39 @@ class OdroidPowerLogger:
                     status_message = status_pb2.StatusMessage()
                     status_message.ParseFromString(message_bytes)
 
-                    # Process only if the payload type is 'sensor_data'
-                    if status_message.WhichOneof('payload') == 'sensor_data':
-                        sensor_data = status_message.sensor_data
-                        ts_dt = datetime.fromtimestamp(sensor_data.timestamp_ms / 1000, tz=timezone.utc)
-                        ts_str_print = ts_dt.strftime('%Y-%m-%d %H:%M:%S UTC')
+                    payload = status_message.WhichOneof('payload')
+                    if payload == 'clock_sync':
+                        sync = status_message.clock_sync
+                        self.clock_offset_us = sync.wall_us - sync.uptime_us
+                        continue
 
-                        print(f"--- {ts_str_print} (Uptime: {sensor_data.uptime_ms / 1000}s) ---")
+                    # Every conversion of a SensorBatch goes to the CSV; the console keeps
+                    # showing the periodic windows.
+                    if payload == 'sensor_batch':
+                        self.last_batch_time = time.monotonic()
+                        if csv_writer:
+                            for reading in self.batch_readings(status_message.sensor_batch):
+                                self.write_csv_row(csv_writer, *reading)
+                        continue
 
-                        # Print data for each channel
-                        for name, channel in [('VIN', sensor_data.vin), ('MAIN', sensor_data.main),
-                                              ('USB', sensor_data.usb)]:
-                            print(
-                                f"  {name:<4}: {channel.voltage:5.2f} V | {channel.current:5.3f} A | {channel.power:5.2f} W")
+                    # Process only sensor payloads, converting the integer variant to volts and amps
+                    readings = self.sensor_readings(status_message)
+                    if readings is None:
+                        continue
+                    timestamp_ms, uptime_ms, channels = readings
+                    ts_dt = datetime.fromtimestamp(timestamp_ms / 1000, tz=timezone.utc)
+                    ts_str_print = ts_dt.strftime('%Y-%m-%d %H:%M:%S UTC')
 
-                        # Write to CSV if enabled
-                        if csv_writer:
-                            ts_iso_csv = ts_dt.isoformat(timespec='milliseconds').replace('+00:00', 'Z')
-                            row = [
-                                ts_iso_csv, sensor_data.uptime_ms,
-                                f"{sensor_data.vin.voltage:.3f}", f"{sensor_data.vin.current:.3f}", f"{sensor_data.vin.power:.3f}",
-                                f"{sensor_data.main.voltage:.3f}", f"{sensor_data.main.current:.3f}", f"{sensor_data.main.power:.3f}",
-                                f"{sensor_data.usb.voltage:.3f}", f"{sensor_data.usb.current:.3f}", f"{sensor_data.usb.power:.3f}"
-                            ]
-                            csv_writer.writerow(row)
+                    print(f"--- {ts_str_print} (Uptime: {uptime_ms / 1000}s) ---")
+
+                    # Print data for each channel
+                    for name in ('VIN', 'MAIN', 'USB'):
+                        voltage, current, power = channels[name]
+                        print(f"  {name:<4}: {voltage:5.2f} V | {current:5.3f} A | {power:5.2f} W")
+
+                    # Write to CSV if enabled
+                    if csv_writer and time.monotonic() - self.last_batch_time > 1.0:
+                        self.write_csv_row(csv_writer, timestamp_ms, uptime_ms, channels)
 
         except websockets.exceptions.ConnectionClosed as e:
             print(f"WebSocket connection closed: {e}")
@@ -131,6 +145,64 @@ class OdroidPowerLogger:
                 csv_file.close()
                 print(f"\nCSV file '{self.output_file}' saved.")
 
+    @staticmethod
+    def write_csv_row(csv_writer, timestamp_ms, uptime_ms, channels):
+        """Writes one reading; timestamp_ms may be fractional for SensorBatch samples."""
+        ts_dt = datetime.fromtimestamp(timestamp_ms / 1000, tz=timezone.utc)
+        timespec = 'milliseconds' if float(timestamp_ms).is_integer() else 'microseconds'
+        ts_iso_csv = ts_dt.isoformat(timespec=timespec).replace('+00:00', 'Z')
+        row = [ts_iso_csv, uptime_ms]
+        for name in ('VIN', 'MAIN', 'USB'):
+            row.extend(f"{value:.3f}" for value in channels[name])
+        csv_writer.writerow(row)
+
+    def batch_readings(self, batch):
+        """Expands a SensorBatch into (timestamp_ms, uptime_ms, {name: (V, A, W)}) per conversion."""
+        # Per-sample values are deltas against the previous sample, three channels per sample
+        # in USB, MAIN, VIN order. The wall time needs a ClockSync; it is 0 until one arrives.
+        names = ('USB', 'MAIN', 'VIN')
+        bus = [0, 0, 0]
+        shunt = [0, 0, 0]
+        conversion_us = batch.first_conversion_us
+        readings = []
+        for i in range(batch.sample_count):
+            if i > 0:
+                conversion_us += batch.conversion_delta_us[i - 1]
+            channels = {}
+            for index, name in enumerate(names):
+                bus[index] += batch.bus_mv[i * 3 + index]
+                shunt[index] += batch.shunt_raw[i * 3 + index]
+                if batch.disabled_channels & (1 << index):
+                    channels[name] = (0.0, 0.0, 0.0)
+                    continue
+                mohm = batch.shunt_mohm[index] if index < len(batch.shunt_mohm) else 0
+                voltage = bus[index] / 1000
+                current = shunt[index] * 0.005 / mohm if mohm else 0.0
+                channels[name] = (voltage, current, voltage * current)
+            timestamp_ms = (conversion_us + self.clock_offset_us) / 1000 if self.clock_offset_us is not None else 0
+            readings.append((timestamp_ms, conversion_us / 1000, channels))
+        return readings
+
+    @staticmethod
+    def sensor_readings(status_message):
+        """Returns (timestamp_ms, uptime_ms, {name: (V, A, W)}) for sensor payloads, else None."""
+        payload = status_message.WhichOneof('payload')
+        if payload == 'sensor_data':
+            data = status_message.sensor_data
+            channels = {name: (channel.voltage, channel.current, channel.power)
+                        for name, channel in (('USB', data.usb), ('MAIN', data.main), ('VIN', data.vin))}
+            return data.timestamp_ms, data.uptime_ms, channels
+        if payload == 'sensor_data_raw':
+            # Repeated fields are in USB, MAIN, VIN order, in mV and uA.
+            data = status_message.sensor_data_raw
+            channels = {}
+            for index, name in enumerate(('USB', 'MAIN', 'VIN')):
+                voltage = data.voltage_mv[index] / 1000 if index < len(data.voltage_mv) else 0.0
+                current = data.current_ua[index] / 1e6 if index < len(data.current_ua) else 0.0
+                channels[name] = (voltage, current, voltage * current)
+            return data.timestamp_ms, data.uptime_ms, channels
+        return None
+
     async def run(self):
         """Runs the logger."""
         if self.login():
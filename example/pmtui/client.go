@@ -62,6 +62,9 @@ type diagnostics struct {
 	UARTBufferFull      uint64 `json:"uart_buffer_full_events"`
 	UARTQueueDrops      uint64 `json:"uart_queue_drops"`
 	StatusQueueDrops    uint64 `json:"status_queue_drops"`
+	SensorSamples       uint64 `json:"sensor_samples"`
+	SensorMissed        uint64 `json:"sensor_missed_deadlines"`
+	SensorMaxJitterUS   uint64 `json:"sensor_max_jitter_us"`
 	WiFiConnected       bool   `json:"wifi_connected"`
 	WiFiRSSI            int32  `json:"wifi_rssi"`
 	WiFiSTAState        string `json:"wifi_sta_state"`
@@ -16,6 +16,8 @@ const (
 	payloadSwitch
 	payloadUART
 	payloadEvent
+	payloadSensorBatch
+	payloadClockSync
 )
 
 type channelData struct {
@@ -30,6 +32,16 @@ type sensorData struct {
 	VIN         channelData
 	TimestampMS uint64
 	UptimeMS    uint64
+	// SensorBatch samples only: esp_timer time of the conversion, and its wall time in
+	// microseconds once a ClockSync has been seen.
+	ConversionUS uint64
+	WallUS       uint64
+}
+
+// clockSync pairs the wall clock with the esp_timer clock SensorBatch times use.
+type clockSync struct {
+	WallUS   uint64
+	UptimeUS uint64
 }
 
 type wifiStatus struct {
@@ -58,6 +70,8 @@ type statusMessage struct {
 	Switch switchStatus
 	UART   []byte
 	Event  eventData
+	Batch  []sensorData
+	Clock  clockSync
 }
 
 func decodeStatusMessage(data []byte) (statusMessage, error) {
@@ -102,6 +116,15 @@ func decodeStatusMessage(data []byte) (statusMessage, error) {
 		case 5:
 			message.Kind = payloadEvent
 			message.Event, err = decodeEventData(value)
+		case 6:
+			message.Kind = payloadSensor
+			message.Sensor, err = decodeSensorDataRaw(value)
+		case 8:
+			message.Kind = payloadClockSync
+			message.Clock, err = decodeClockSync(value)
+		case 9:
+			message.Kind = payloadSensorBatch
+			message.Batch, err = decodeSensorBatch(value)
 		default:
 			continue
 		}
@@ -171,6 +194,257 @@ func decodeSensorData(data []byte) (sensorData, error) {
 	return sensor, nil
 }
 
+// decodeSensorDataRaw converts the integer SensorDataRaw variant (mV and uA per
+// channel in USB, MAIN, VIN order) into the same shape as SensorData.
+func decodeSensorDataRaw(data []byte) (sensorData, error) {
+	var sensor sensorData
+	var voltageMV, currentUA []int64
+
+	for len(data) > 0 {
+		number, wireType, tagLen := protowire.ConsumeTag(data)
+		if tagLen < 0 {
+			return sensor, protowire.ParseError(tagLen)
+		}
+		data = data[tagLen:]
+
+		switch number {
+		case 1, 2:
+			if wireType != protowire.VarintType {
+				return sensor, unexpectedWireType(number, wireType)
+			}
+			value, consumed := protowire.ConsumeVarint(data)
+			if consumed < 0 {
+				return sensor, protowire.ParseError(consumed)
+			}
+			data = data[consumed:]
+			if number == 1 {
+				sensor.TimestampMS = value
+			} else {
+				sensor.UptimeMS = value
+			}
+		case 4, 5:
+			values, consumed, err := consumeSint(wireType, data)
+			if err != nil {
+				return sensor, err
+			}
+			data = data[consumed:]
+			if number == 4 {
+				voltageMV = append(voltageMV, values...)
+			} else {
+				currentUA = append(currentUA, values...)
+			}
+		default:
+			consumed := protowire.ConsumeFieldValue(number, wireType, data)
+			if consumed < 0 {
+				return sensor, protowire.ParseError(consumed)
+			}
+			data = data[consumed:]
+		}
+	}
+
+	channels := []*channelData{&sensor.USB, &sensor.Main, &sensor.VIN}
+	for i, channel := range channels {
+		if i < len(voltageMV) {
+			channel.Voltage = float32(voltageMV[i]) / 1000
+		}
+		if i < len(currentUA) {
+			channel.Current = float32(currentUA[i]) / 1e6
+		}
+		channel.Power = channel.Voltage * channel.Current
+	}
+
+	return sensor, nil
+}
+
+// decodeSensorBatch expands a SensorBatch into one sensorData per conversion. Times and
+// values are delta-encoded against the previous sample; wall times are left to the caller.
+func decodeSensorBatch(data []byte) ([]sensorData, error) {
+	var count, disabled uint64
+	var firstUS uint64
+	var deltaUS, shuntMOhm []uint64
+	var busMV, shuntRaw []int64
+
+	for len(data) > 0 {
+		number, wireType, tagLen := protowire.ConsumeTag(data)
+		if tagLen < 0 {
+			return nil, protowire.ParseError(tagLen)
+		}
+		data = data[tagLen:]
+
+		switch number {
+		case 2, 3, 8:
+			if wireType != protowire.VarintType {
+				return nil, unexpectedWireType(number, wireType)
+			}
+			value, consumed := protowire.ConsumeVarint(data)
+			if consumed < 0 {
+				return nil, protowire.ParseError(consumed)
+			}
+			data = data[consumed:]
+			switch number {
+			case 2:
+				count = value
+			case 3:
+				firstUS = value
+			case 8:
+				disabled = value
+			}
+		case 4, 7:
+			values, consumed, err := consumeUint(wireType, data)
+			if err != nil {
+				return nil, err
+			}
+			data = data[consumed:]
+			if number == 4 {
+				deltaUS = append(deltaUS, values...)
+			} else {
+				shuntMOhm = append(shuntMOhm, values...)
+			}
+		case 5, 6:
+			values, consumed, err := consumeSint(wireType, data)
+			if err != nil {
+				return nil, err
+			}
+			data = data[consumed:]
+			if number == 5 {
+				busMV = append(busMV, values...)
+			} else {
+				shuntRaw = append(shuntRaw, values...)
+			}
+		default:
+			consumed := protowire.ConsumeFieldValue(number, wireType, data)
+			if consumed < 0 {
+				return nil, protowire.ParseError(consumed)
+			}
+			data = data[consumed:]
+		}
+	}
+
+	if uint64(len(busMV)) < count*3 || uint64(len(shuntRaw)) < count*3 {
+		return nil, fmt.Errorf("sensor batch of %d samples has %d bus and %d shunt values", count, len(busMV),
+			len(shuntRaw))
+	}
+
+	samples := make([]sensorData, count)
+	var bus, shunt [3]int64
+	conversionUS := firstUS
+	for i := range samples {
+		if i > 0 && i-1 < len(deltaUS) {
+			conversionUS += deltaUS[i-1]
+		}
+		sample := &samples[i]
+		sample.ConversionUS = conversionUS
+		sample.UptimeMS = conversionUS / 1000
+		channels := []*channelData{&sample.USB, &sample.Main, &sample.VIN}
+		for ch, channel := range channels {
+			bus[ch] += busMV[i*3+ch]
+			shunt[ch] += shuntRaw[i*3+ch]
+			if disabled&(1<<ch) != 0 {
+				continue
+			}
+			channel.Voltage = float32(bus[ch]) / 1000
+			if ch < len(shuntMOhm) && shuntMOhm[ch] > 0 {
+				channel.Current = float32(shunt[ch]) * 0.005 / float32(shuntMOhm[ch])
+			}
+			channel.Power = channel.Voltage * channel.Current
+		}
+	}
+
+	return samples, nil
+}
+
+func decodeClockSync(data []byte) (clockSync, error) {
+	var sync clockSync
+
+	for len(data) > 0 {
+		number, wireType, tagLen := protowire.ConsumeTag(data)
+		if tagLen < 0 {
+			return sync, protowire.ParseError(tagLen)
+		}
+		data = data[tagLen:]
+
+		if (number == 1 || number == 2) && wireType == protowire.VarintType {
+			value, consumed := protowire.ConsumeVarint(data)
+			if consumed < 0 {
+				return sync, protowire.ParseError(consumed)
+			}
+			data = data[consumed:]
+			if number == 1 {
+				sync.WallUS = value
+			} else {
+				sync.UptimeUS = value
+			}
+			continue
+		}
+
+		consumed := protowire.ConsumeFieldValue(number, wireType, data)
+		if consumed < 0 {
+			return sync, protowire.ParseError(consumed)
+		}
+		data = data[consumed:]
+	}
+
+	return sync, nil
+}
+
+// consumeUint reads a packed or unpacked unsigned varint repeated field.
+func consumeUint(wireType protowire.Type, data []byte) ([]uint64, int, error) {
+	if wireType == protowire.VarintType {
+		value, consumed := protowire.ConsumeVarint(data)
+		if consumed < 0 {
+			return nil, 0, protowire.ParseError(consumed)
+		}
+		return []uint64{value}, consumed, nil
+	}
+	if wireType != protowire.BytesType {
+		return nil, 0, fmt.Errorf("protobuf repeated field has unexpected wire type %d", wireType)
+	}
+
+	packed, consumed := protowire.ConsumeBytes(data)
+	if consumed < 0 {
+		return nil, 0, protowire.ParseError(consumed)
+	}
+	var values []uint64
+	for len(packed) > 0 {
+		value, n := protowire.ConsumeVarint(packed)
+		if n < 0 {
+			return nil, 0, protowire.ParseError(n)
+		}
+		packed = packed[n:]
+		values = append(values, value)
+	}
+	return values, consumed, nil
+}
+
+// consumeSint reads a packed or unpacked zigzag-encoded repeated field.
+func consumeSint(wireType protowire.Type, data []byte) ([]int64, int, error) {
+	if wireType == protowire.VarintType {
+		value, consumed := protowire.ConsumeVarint(data)
+		if consumed < 0 {
+			return nil, 0, protowire.ParseError(consumed)
+		}
+		return []int64{protowire.DecodeZigZag(value)}, consumed, nil
+	}
+	if wireType != protowire.BytesType {
+		return nil, 0, fmt.Errorf("protobuf repeated field has unexpected wire type %d", wireType)
+	}
+
+	packed, consumed := protowire.ConsumeBytes(data)
+	if consumed < 0 {
+		return nil, 0, protowire.ParseError(consumed)
+	}
+	var values []int64
+	for len(packed) > 0 {
+		value, n := protowire.ConsumeVarint(packed)
+		if n < 0 {
+			return nil, 0, protowire.ParseError(n)
+		}
+		packed = packed[n:]
+		values = append(values, protowire.DecodeZigZag(value))
+	}
+	return values, consumed, nil
+}
+
 func decodeChannelData(data []byte) (channelData, error) {
 	var channel channelData
 
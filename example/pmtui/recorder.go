@@ -90,7 +90,9 @@ func (r *recorder) Write(sensor sensorData) error {
 
 	hostTimestamp := time.Now().UTC()
 	deviceTimestamp := ""
-	if sensor.TimestampMS > 0 {
+	if sensor.WallUS > 0 {
+		deviceTimestamp = time.UnixMicro(int64(sensor.WallUS)).UTC().Format(time.RFC3339Nano)
+	} else if sensor.TimestampMS > 0 {
 		deviceTimestamp = time.UnixMilli(int64(sensor.TimestampMS)).UTC().Format(time.RFC3339Nano)
 	}
 
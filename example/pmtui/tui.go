@@ -16,6 +16,7 @@ import (
 const (
 	maxEventLines    = 500
 	mainReservedRows = 4
+	sensorBatchStale = time.Second
 )
 
 type page uint8
@@ -144,6 +145,11 @@ type tui struct {
 	sensorMu     sync.Mutex
 	latest       sensorData
 	sensorQueued atomic.Bool
+	// Wall minus esp_timer clock from the latest ClockSync, and when the last SensorBatch
+	// arrived; while batches flow the recorder takes their samples instead of the windows.
+	clockOffsetUS atomic.Int64
+	haveClock     atomic.Bool
+	lastBatchNano atomic.Int64
 
 	lastStatusUnixMS atomic.Int64
 	debugEpoch       uint64
@@ -438,14 +444,29 @@ func (t *tui) loginCmd(host, username, password string) tea.Cmd {
 }
 
 func (t *tui) enqueueStatus(message statusMessage) {
+	switch message.Kind {
+	case payloadClockSync:
+		t.clockOffsetUS.Store(int64(message.Clock.WallUS) - int64(message.Clock.UptimeUS))
+		t.haveClock.Store(true)
+		return
+	case payloadSensorBatch:
+		t.lastBatchNano.Store(time.Now().UnixNano())
+		for _, sample := range message.Batch {
+			if t.haveClock.Load() {
+				sample.WallUS = uint64(int64(sample.ConversionUS) + t.clockOffsetUS.Load())
+			}
+			if err := t.recorder.Write(sample); err != nil {
+				t.reportRecorderError(err)
+				break
+			}
+		}
+		return
+	}
+
 	if message.Kind == payloadSensor {
-		if err := t.recorder.Write(message.Sensor); err != nil {
-			select {
-			case t.statusCh <- actionResultMsg{
-				failure: "CSV write failed",
-				err:     err,
-			}:
-			default:
+		if time.Since(time.Unix(0, t.lastBatchNano.Load())) > sensorBatchStale {
+			if err := t.recorder.Write(message.Sensor); err != nil {
+				t.reportRecorderError(err)
 			}
 		}
 		t.sensorMu.Lock()
@@ -468,6 +489,16 @@ func (t *tui) enqueueStatus(message statusMessage) {
 	}
 }
 
+func (t *tui) reportRecorderError(err error) {
+	select {
+	case t.statusCh <- actionResultMsg{
+		failure: "CSV write failed",
+		err:     err,
+	}:
+	default:
+	}
+}
+
 func (t *tui) enqueueStatusState(connected bool, err error) {
 	select {
 	case t.statusCh <- statusStateMsg{connected: connected, err: err}:
@@ -1133,6 +1164,7 @@ func (t *tui) updateDebugContent() {
 			"UART errors         FIFO %d, buffer %d\n"+
 			"Queue drops         UART %d, status %d\n"+
 			"WS send failures    %d\n"+
+			"Sampling            %d samples, %d missed, max jitter %.1f ms\n"+
 			"Wi-Fi               %s\n"+
 			"STA state           %s\n"+
 			"Last disconnect     %s\n"+
@@ -1156,6 +1188,9 @@ func (t *tui) updateDebugContent() {
 		data.UARTQueueDrops,
 		data.StatusQueueDrops,
 		data.WebSocketFailures,
+		data.SensorSamples,
+		data.SensorMissed,
+		float64(data.SensorMaxJitterUS)/1000,
 		wifi,
 		staState,
 		lastDisconnect,
@@ -50,6 +50,15 @@ enum nconfig_type
     SENSOR_PERIOD_MS, ///< Sensor period
     RESTORE_OUTPUT_STATE, ///< Restore the last MAIN/USB output state after power loss.
     OUTPUT_STATE, ///< Last MAIN/USB output state.
+    ENERGY_CHECKPOINT, ///< Last saved per-channel energy and charge totals.
+    SENSOR_AVERAGING, ///< INA3221 samples averaged per conversion.
+    SENSOR_BUS_CT_US, ///< INA3221 bus voltage conversion time in microseconds.
+    SENSOR_SHUNT_CT_US, ///< INA3221 shunt voltage conversion time in microseconds.
+    SENSOR_FORMAT, ///< Sensor stream encoding: "float" (SensorData), "raw" (SensorDataRaw) or "batch" (SensorDataRaw plus SensorBatch).
+    STATS_STREAM, ///< Statistics window sent over WebSocket: "off", "1s", "1m" or "1h".
+    SENSOR_CHANNELS, ///< Enabled INA3221 channels, a comma separated subset of "usb,main,vin".
+    RULES_CONFIG, ///< Threshold rules: "type,channel,threshold,hysteresis,duration_ms,action;...".
+    VIN_SAG_THRESHOLD_MV, ///< VIN sag detector threshold in mV, "0" to keep the detector off.
     NCONFIG_TYPE_MAX,   ///< Sentinel for the maximum number of configuration types.
 };
 
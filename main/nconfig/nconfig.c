@@ -36,6 +36,15 @@ const static char* keys[NCONFIG_TYPE_MAX] = {
     [SENSOR_PERIOD_MS] = "sensor_period",
     [RESTORE_OUTPUT_STATE] = "restore_vout",
     [OUTPUT_STATE] = "vout_state",
+    [ENERGY_CHECKPOINT] = "energy",
+    [SENSOR_AVERAGING] = "sensor_avg",
+    [SENSOR_BUS_CT_US] = "sensor_bus_ct",
+    [SENSOR_SHUNT_CT_US] = "sensor_sht_ct",
+    [SENSOR_FORMAT] = "sensor_format",
+    [STATS_STREAM] = "stats_stream",
+    [SENSOR_CHANNELS] = "sensor_ch",
+    [RULES_CONFIG] = "rules",
+    [VIN_SAG_THRESHOLD_MV] = "vin_sag_mv",
 };
 
 struct default_value
@@ -66,6 +75,14 @@ struct default_value const default_values[] = {
     {SENSOR_PERIOD_MS, "1000"},
     {RESTORE_OUTPUT_STATE, "false"},
     {OUTPUT_STATE, "00"},
+    {SENSOR_AVERAGING, "16"},
+    {SENSOR_BUS_CT_US, "140"},
+    {SENSOR_SHUNT_CT_US, "1100"},
+    {SENSOR_FORMAT, "float"},
+    {STATS_STREAM, "off"},
+    {SENSOR_CHANNELS, "usb,main,vin"},
+    {RULES_CONFIG, ""},
+    {VIN_SAG_THRESHOLD_MV, "0"},
 };
 
 esp_err_t init_nconfig()
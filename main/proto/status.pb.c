@@ -12,6 +12,24 @@ PB_BIND(SensorChannelData, SensorChannelData, AUTO)
 PB_BIND(SensorData, SensorData, AUTO)
 
 
+PB_BIND(SensorDataRaw, SensorDataRaw, AUTO)
+
+
+PB_BIND(SensorBatch, SensorBatch, AUTO)
+
+
+PB_BIND(StatsSummary, StatsSummary, AUTO)
+
+
+PB_BIND(ChannelStats, ChannelStats, AUTO)
+
+
+PB_BIND(SensorStats, SensorStats, AUTO)
+
+
+PB_BIND(ClockSync, ClockSync, AUTO)
+
+
 PB_BIND(WifiStatus, WifiStatus, AUTO)
 
 
@@ -15,9 +15,15 @@ typedef struct _SensorChannelData {
     float voltage;
     float current;
     float power;
+    float voltage_min; /* window extremes since the previous SensorData */
+    float voltage_max;
+    float current_min;
+    float current_max;
+    float energy_wh; /* totals since the last energy reset */
+    float charge_mah;
 } SensorChannelData;
 
-/* Contains data for all sensor channels and system info */
+/* Contains data for all sensor channels and system info. Disabled channels are left out. */
 typedef struct _SensorData {
     bool has_usb;
     SensorChannelData usb;
@@ -27,8 +33,94 @@ typedef struct _SensorData {
     SensorChannelData vin;
     uint64_t timestamp_ms;
     uint64_t uptime_ms;
+    uint32_t sample_count; /* INA3221 conversions averaged into this message */
+    uint64_t first_conversion_us; /* esp_timer time the first and last averaged */
+    uint64_t last_conversion_us; /* conversions completed; see ClockSync */
 } SensorData;
 
+/* Integer variant of SensorData; clients do the unit conversion. Each repeated
+ field holds one entry per channel in USB, MAIN, VIN order. */
+typedef struct _SensorDataRaw {
+    uint64_t timestamp_ms;
+    uint64_t uptime_ms;
+    uint32_t sample_count;
+    pb_size_t voltage_mv_count;
+    int32_t voltage_mv[3]; /* window means */
+    pb_size_t current_ua_count;
+    int32_t current_ua[3];
+    pb_size_t voltage_min_mv_count;
+    int32_t voltage_min_mv[3]; /* window extremes since the previous message */
+    pb_size_t voltage_max_mv_count;
+    int32_t voltage_max_mv[3];
+    pb_size_t current_min_ua_count;
+    int32_t current_min_ua[3];
+    pb_size_t current_max_ua_count;
+    int32_t current_max_ua[3];
+    pb_size_t energy_uwh_count;
+    int64_t energy_uwh[3]; /* totals since the last energy reset */
+    pb_size_t charge_uah_count;
+    int64_t charge_uah[3];
+    uint64_t first_conversion_us; /* esp_timer time the first and last averaged */
+    uint64_t last_conversion_us; /* conversions completed; see ClockSync */
+    uint32_t disabled_channels; /* bit n set: entry n is not measured and reads 0 */
+} SensorDataRaw;
+
+/* Every conversion since the previous batch, in INA3221 counts, sent with the "batch"
+ sensor format. A batch is flushed when full or once its oldest sample reaches the
+ latency budget. Per-sample fields are delta-encoded: the first sample of a batch
+ against zero, each later one against the sample before it. */
+typedef struct _SensorBatch {
+    uint32_t seq; /* index of the first sample since boot; a gap means samples were dropped */
+    uint32_t sample_count;
+    uint64_t first_conversion_us; /* esp_timer time of the first sample; see ClockSync */
+    pb_callback_t conversion_delta_us; /* one per sample after the first */
+    pb_callback_t bus_mv; /* sample_count x 3 entries, USB, MAIN, VIN per sample */
+    pb_callback_t shunt_raw; /* same layout, 5 uV/LSB: mA = shunt_raw * 5 / shunt_mohm */
+    pb_size_t shunt_mohm_count;
+    uint32_t shunt_mohm[3]; /* USB, MAIN, VIN */
+    uint32_t disabled_channels; /* bit n set: channel n is not measured and reads 0 */
+} SensorBatch;
+
+/* Summary of one metric over a statistics window */
+typedef struct _StatsSummary {
+    float min;
+    float max;
+    float mean;
+    float stddev;
+    float p99; /* streaming estimate */
+} StatsSummary;
+
+typedef struct _ChannelStats {
+    bool has_voltage;
+    StatsSummary voltage;
+    bool has_current;
+    StatsSummary current;
+    bool has_power;
+    StatsSummary power;
+} ChannelStats;
+
+/* Sent when a statistics window of the selected length completes */
+typedef struct _SensorStats {
+    uint32_t window_ms;
+    uint32_t sample_count;
+    uint64_t timestamp_ms;
+    uint64_t uptime_ms;
+    bool has_usb;
+    ChannelStats usb;
+    bool has_main;
+    ChannelStats main;
+    bool has_vin;
+    ChannelStats vin;
+} SensorStats;
+
+/* Pairs the wall clock with the esp_timer clock the *_conversion_us fields use.
+ Sent periodically; wall time of a conversion is conversion_us + wall_us - uptime_us. */
+typedef struct _ClockSync {
+    uint64_t wall_us; /* microseconds since the Unix epoch, near zero until SNTP has synced */
+    uint64_t uptime_us;
+    uint32_t uncertainty_us; /* half the time taken to read both clocks */
+} ClockSync;
+
 /* Contains WiFi connection status */
 typedef struct _WifiStatus {
     bool connected;
@@ -42,6 +134,7 @@ typedef struct _EventData {
     uint64_t timestamp_ms;
     uint64_t uptime_ms;
     pb_callback_t message;
+    uint32_t seq; /* journal sequence number for GET /api/events?since=, 0 if not journaled */
 } EventData;
 
 /* Contains raw UART data */
@@ -64,6 +157,10 @@ typedef struct _StatusMessage {
         LoadSwStatus sw_status;
         UartData uart_data;
         EventData event_data;
+        SensorDataRaw sensor_data_raw;
+        SensorStats sensor_stats;
+        ClockSync clock_sync;
+        SensorBatch sensor_batch;
     } payload;
 } StatusMessage;
 
@@ -73,17 +170,29 @@ extern "C" {
 #endif
 
 /* Initializer values for message structs */
-#define SensorChannelData_init_default           {0, 0, 0}
-#define SensorData_init_default                  {false, SensorChannelData_init_default, false, SensorChannelData_init_default, false, SensorChannelData_init_default, 0, 0}
+#define SensorChannelData_init_default           {0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define SensorData_init_default                  {false, SensorChannelData_init_default, false, SensorChannelData_init_default, false, SensorChannelData_init_default, 0, 0, 0, 0, 0}
+#define SensorDataRaw_init_default               {0, 0, 0, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, 0, 0}
+#define SensorBatch_init_default                 {0, 0, 0, {{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}, 0, {0, 0, 0}, 0}
+#define StatsSummary_init_default                {0, 0, 0, 0, 0}
+#define ChannelStats_init_default                {false, StatsSummary_init_default, false, StatsSummary_init_default, false, StatsSummary_init_default}
+#define SensorStats_init_default                 {0, 0, 0, 0, false, ChannelStats_init_default, false, ChannelStats_init_default, false, ChannelStats_init_default}
+#define ClockSync_init_default                   {0, 0, 0}
 #define WifiStatus_init_default                  {0, {{NULL}, NULL}, 0, {{NULL}, NULL}}
-#define EventData_init_default                   {0, 0, 0, {{NULL}, NULL}}
+#define EventData_init_default                   {0, 0, 0, {{NULL}, NULL}, 0}
 #define UartData_init_default                    {{{NULL}, NULL}}
 #define LoadSwStatus_init_default                {0, 0}
 #define StatusMessage_init_default               {0, {SensorData_init_default}}
-#define SensorChannelData_init_zero              {0, 0, 0}
-#define SensorData_init_zero                     {false, SensorChannelData_init_zero, false, SensorChannelData_init_zero, false, SensorChannelData_init_zero, 0, 0}
+#define SensorChannelData_init_zero              {0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define SensorData_init_zero                     {false, SensorChannelData_init_zero, false, SensorChannelData_init_zero, false, SensorChannelData_init_zero, 0, 0, 0, 0, 0}
+#define SensorDataRaw_init_zero                  {0, 0, 0, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, {0, 0, 0}, 0, 0, 0}
+#define SensorBatch_init_zero                    {0, 0, 0, {{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}, 0, {0, 0, 0}, 0}
+#define StatsSummary_init_zero                   {0, 0, 0, 0, 0}
+#define ChannelStats_init_zero                   {false, StatsSummary_init_zero, false, StatsSummary_init_zero, false, StatsSummary_init_zero}
+#define SensorStats_init_zero                    {0, 0, 0, 0, false, ChannelStats_init_zero, false, ChannelStats_init_zero, false, ChannelStats_init_zero}
+#define ClockSync_init_zero                      {0, 0, 0}
 #define WifiStatus_init_zero                     {0, {{NULL}, NULL}, 0, {{NULL}, NULL}}
-#define EventData_init_zero                      {0, 0, 0, {{NULL}, NULL}}
+#define EventData_init_zero                      {0, 0, 0, {{NULL}, NULL}, 0}
 #define UartData_init_zero                       {{{NULL}, NULL}}
 #define LoadSwStatus_init_zero                   {0, 0}
 #define StatusMessage_init_zero                  {0, {SensorData_init_zero}}
@@ -92,11 +201,60 @@ extern "C" {
 #define SensorChannelData_voltage_tag            1
 #define SensorChannelData_current_tag            2
 #define SensorChannelData_power_tag              3
+#define SensorChannelData_voltage_min_tag        4
+#define SensorChannelData_voltage_max_tag        5
+#define SensorChannelData_current_min_tag        6
+#define SensorChannelData_current_max_tag        7
+#define SensorChannelData_energy_wh_tag          8
+#define SensorChannelData_charge_mah_tag         9
 #define SensorData_usb_tag                       1
 #define SensorData_main_tag                      2
 #define SensorData_vin_tag                       3
 #define SensorData_timestamp_ms_tag              4
 #define SensorData_uptime_ms_tag                 5
+#define SensorData_sample_count_tag              6
+#define SensorData_first_conversion_us_tag       7
+#define SensorData_last_conversion_us_tag        8
+#define SensorDataRaw_timestamp_ms_tag           1
+#define SensorDataRaw_uptime_ms_tag              2
+#define SensorDataRaw_sample_count_tag           3
+#define SensorDataRaw_voltage_mv_tag             4
+#define SensorDataRaw_current_ua_tag             5
+#define SensorDataRaw_voltage_min_mv_tag         6
+#define SensorDataRaw_voltage_max_mv_tag         7
+#define SensorDataRaw_current_min_ua_tag         8
+#define SensorDataRaw_current_max_ua_tag         9
+#define SensorDataRaw_energy_uwh_tag             10
+#define SensorDataRaw_charge_uah_tag             11
+#define SensorDataRaw_first_conversion_us_tag    12
+#define SensorDataRaw_last_conversion_us_tag     13
+#define SensorDataRaw_disabled_channels_tag      14
+#define SensorBatch_seq_tag                      1
+#define SensorBatch_sample_count_tag             2
+#define SensorBatch_first_conversion_us_tag      3
+#define SensorBatch_conversion_delta_us_tag      4
+#define SensorBatch_bus_mv_tag                   5
+#define SensorBatch_shunt_raw_tag                6
+#define SensorBatch_shunt_mohm_tag               7
+#define SensorBatch_disabled_channels_tag        8
+#define StatsSummary_min_tag                     1
+#define StatsSummary_max_tag                     2
+#define StatsSummary_mean_tag                    3
+#define StatsSummary_stddev_tag                  4
+#define StatsSummary_p99_tag                     5
+#define ChannelStats_voltage_tag                 1
+#define ChannelStats_current_tag                 2
+#define ChannelStats_power_tag                   3
+#define SensorStats_window_ms_tag                1
+#define SensorStats_sample_count_tag             2
+#define SensorStats_timestamp_ms_tag             3
+#define SensorStats_uptime_ms_tag                4
+#define SensorStats_usb_tag                      5
+#define SensorStats_main_tag                     6
+#define SensorStats_vin_tag                      7
+#define ClockSync_wall_us_tag                    1
+#define ClockSync_uptime_us_tag                  2
+#define ClockSync_uncertainty_us_tag             3
 #define WifiStatus_connected_tag                 1
 #define WifiStatus_ssid_tag                      2
 #define WifiStatus_rssi_tag                      3
@@ -105,6 +263,7 @@ extern "C" {
 #define EventData_timestamp_ms_tag               2
 #define EventData_uptime_ms_tag                  3
 #define EventData_message_tag                    4
+#define EventData_seq_tag                        5
 #define UartData_data_tag                        1
 #define LoadSwStatus_main_tag                    1
 #define LoadSwStatus_usb_tag                     2
@@ -113,12 +272,22 @@ extern "C" {
 #define StatusMessage_sw_status_tag              3
 #define StatusMessage_uart_data_tag              4
 #define StatusMessage_event_data_tag             5
+#define StatusMessage_sensor_data_raw_tag        6
+#define StatusMessage_sensor_stats_tag           7
+#define StatusMessage_clock_sync_tag             8
+#define StatusMessage_sensor_batch_tag           9
 
 /* Struct field encoding specification for nanopb */
 #define SensorChannelData_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, FLOAT,    voltage,           1) \
 X(a, STATIC,   SINGULAR, FLOAT,    current,           2) \
-X(a, STATIC,   SINGULAR, FLOAT,    power,             3)
+X(a, STATIC,   SINGULAR, FLOAT,    power,             3) \
+X(a, STATIC,   SINGULAR, FLOAT,    voltage_min,       4) \
+X(a, STATIC,   SINGULAR, FLOAT,    voltage_max,       5) \
+X(a, STATIC,   SINGULAR, FLOAT,    current_min,       6) \
+X(a, STATIC,   SINGULAR, FLOAT,    current_max,       7) \
+X(a, STATIC,   SINGULAR, FLOAT,    energy_wh,         8) \
+X(a, STATIC,   SINGULAR, FLOAT,    charge_mah,        9)
 #define SensorChannelData_CALLBACK NULL
 #define SensorChannelData_DEFAULT NULL
 
@@ -127,13 +296,86 @@ X(a, STATIC,   OPTIONAL, MESSAGE,  usb,               1) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  main,              2) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  vin,               3) \
 X(a, STATIC,   SINGULAR, UINT64,   timestamp_ms,      4) \
-X(a, STATIC,   SINGULAR, UINT64,   uptime_ms,         5)
+X(a, STATIC,   SINGULAR, UINT64,   uptime_ms,         5) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_count,      6) \
+X(a, STATIC,   SINGULAR, UINT64,   first_conversion_us,   7) \
+X(a, STATIC,   SINGULAR, UINT64,   last_conversion_us,   8)
 #define SensorData_CALLBACK NULL
 #define SensorData_DEFAULT NULL
 #define SensorData_usb_MSGTYPE SensorChannelData
 #define SensorData_main_MSGTYPE SensorChannelData
 #define SensorData_vin_MSGTYPE SensorChannelData
 
+#define SensorDataRaw_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT64,   timestamp_ms,      1) \
+X(a, STATIC,   SINGULAR, UINT64,   uptime_ms,         2) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_count,      3) \
+X(a, STATIC,   REPEATED, SINT32,   voltage_mv,        4) \
+X(a, STATIC,   REPEATED, SINT32,   current_ua,        5) \
+X(a, STATIC,   REPEATED, SINT32,   voltage_min_mv,    6) \
+X(a, STATIC,   REPEATED, SINT32,   voltage_max_mv,    7) \
+X(a, STATIC,   REPEATED, SINT32,   current_min_ua,    8) \
+X(a, STATIC,   REPEATED, SINT32,   current_max_ua,    9) \
+X(a, STATIC,   REPEATED, SINT64,   energy_uwh,       10) \
+X(a, STATIC,   REPEATED, SINT64,   charge_uah,       11) \
+X(a, STATIC,   SINGULAR, UINT64,   first_conversion_us,  12) \
+X(a, STATIC,   SINGULAR, UINT64,   last_conversion_us,  13) \
+X(a, STATIC,   SINGULAR, UINT32,   disabled_channels,  14)
+#define SensorDataRaw_CALLBACK NULL
+#define SensorDataRaw_DEFAULT NULL
+
+#define SensorBatch_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   seq,               1) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_count,      2) \
+X(a, STATIC,   SINGULAR, UINT64,   first_conversion_us,   3) \
+X(a, CALLBACK, REPEATED, UINT32,   conversion_delta_us,   4) \
+X(a, CALLBACK, REPEATED, SINT32,   bus_mv,            5) \
+X(a, CALLBACK, REPEATED, SINT32,   shunt_raw,         6) \
+X(a, STATIC,   REPEATED, UINT32,   shunt_mohm,        7) \
+X(a, STATIC,   SINGULAR, UINT32,   disabled_channels,   8)
+#define SensorBatch_CALLBACK pb_default_field_callback
+#define SensorBatch_DEFAULT NULL
+
+#define StatsSummary_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, FLOAT,    min,               1) \
+X(a, STATIC,   SINGULAR, FLOAT,    max,               2) \
+X(a, STATIC,   SINGULAR, FLOAT,    mean,              3) \
+X(a, STATIC,   SINGULAR, FLOAT,    stddev,            4) \
+X(a, STATIC,   SINGULAR, FLOAT,    p99,               5)
+#define StatsSummary_CALLBACK NULL
+#define StatsSummary_DEFAULT NULL
+
+#define ChannelStats_FIELDLIST(X, a) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  voltage,           1) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  current,           2) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  power,             3)
+#define ChannelStats_CALLBACK NULL
+#define ChannelStats_DEFAULT NULL
+#define ChannelStats_voltage_MSGTYPE StatsSummary
+#define ChannelStats_current_MSGTYPE StatsSummary
+#define ChannelStats_power_MSGTYPE StatsSummary
+
+#define SensorStats_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   window_ms,         1) \
+X(a, STATIC,   SINGULAR, UINT32,   sample_count,      2) \
+X(a, STATIC,   SINGULAR, UINT64,   timestamp_ms,      3) \
+X(a, STATIC,   SINGULAR, UINT64,   uptime_ms,         4) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  usb,               5) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  main,              6) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  vin,               7)
+#define SensorStats_CALLBACK NULL
+#define SensorStats_DEFAULT NULL
+#define SensorStats_usb_MSGTYPE ChannelStats
+#define SensorStats_main_MSGTYPE ChannelStats
+#define SensorStats_vin_MSGTYPE ChannelStats
+
+#define ClockSync_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT64,   wall_us,           1) \
+X(a, STATIC,   SINGULAR, UINT64,   uptime_us,         2) \
+X(a, STATIC,   SINGULAR, UINT32,   uncertainty_us,    3)
+#define ClockSync_CALLBACK NULL
+#define ClockSync_DEFAULT NULL
+
 #define WifiStatus_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, BOOL,     connected,         1) \
 X(a, CALLBACK, SINGULAR, STRING,   ssid,              2) \
@@ -146,7 +388,8 @@ X(a, CALLBACK, SINGULAR, STRING,   ip_address,        4)
 X(a, STATIC,   SINGULAR, INT32,    level,             1) \
 X(a, STATIC,   SINGULAR, UINT64,   timestamp_ms,      2) \
 X(a, STATIC,   SINGULAR, UINT64,   uptime_ms,         3) \
-X(a, CALLBACK, SINGULAR, STRING,   message,           4)
+X(a, CALLBACK, SINGULAR, STRING,   message,           4) \
+X(a, STATIC,   SINGULAR, UINT32,   seq,               5)
 #define EventData_CALLBACK pb_default_field_callback
 #define EventData_DEFAULT NULL
 
@@ -166,7 +409,11 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (payload,sensor_data,payload.sensor_data),
 X(a, STATIC,   ONEOF,    MESSAGE,  (payload,wifi_status,payload.wifi_status),   2) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (payload,sw_status,payload.sw_status),   3) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (payload,uart_data,payload.uart_data),   4) \
-X(a, STATIC,   ONEOF,    MESSAGE,  (payload,event_data,payload.event_data),   5)
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,event_data,payload.event_data),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,sensor_data_raw,payload.sensor_data_raw),   6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,sensor_stats,payload.sensor_stats),   7) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,clock_sync,payload.clock_sync),   8) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (payload,sensor_batch,payload.sensor_batch),   9)
 #define StatusMessage_CALLBACK NULL
 #define StatusMessage_DEFAULT NULL
 #define StatusMessage_payload_sensor_data_MSGTYPE SensorData
@@ -174,9 +421,19 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (payload,event_data,payload.event_data),   5)
 #define StatusMessage_payload_sw_status_MSGTYPE LoadSwStatus
 #define StatusMessage_payload_uart_data_MSGTYPE UartData
 #define StatusMessage_payload_event_data_MSGTYPE EventData
+#define StatusMessage_payload_sensor_data_raw_MSGTYPE SensorDataRaw
+#define StatusMessage_payload_sensor_stats_MSGTYPE SensorStats
+#define StatusMessage_payload_clock_sync_MSGTYPE ClockSync
+#define StatusMessage_payload_sensor_batch_MSGTYPE SensorBatch
 
 extern const pb_msgdesc_t SensorChannelData_msg;
 extern const pb_msgdesc_t SensorData_msg;
+extern const pb_msgdesc_t SensorDataRaw_msg;
+extern const pb_msgdesc_t SensorBatch_msg;
+extern const pb_msgdesc_t StatsSummary_msg;
+extern const pb_msgdesc_t ChannelStats_msg;
+extern const pb_msgdesc_t SensorStats_msg;
+extern const pb_msgdesc_t ClockSync_msg;
 extern const pb_msgdesc_t WifiStatus_msg;
 extern const pb_msgdesc_t EventData_msg;
 extern const pb_msgdesc_t UartData_msg;
@@ -186,6 +443,12 @@ extern const pb_msgdesc_t StatusMessage_msg;
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define SensorChannelData_fields &SensorChannelData_msg
 #define SensorData_fields &SensorData_msg
+#define SensorDataRaw_fields &SensorDataRaw_msg
+#define SensorBatch_fields &SensorBatch_msg
+#define StatsSummary_fields &StatsSummary_msg
+#define ChannelStats_fields &ChannelStats_msg
+#define SensorStats_fields &SensorStats_msg
+#define ClockSync_fields &ClockSync_msg
 #define WifiStatus_fields &WifiStatus_msg
 #define EventData_fields &EventData_msg
 #define UartData_fields &UartData_msg
@@ -193,14 +456,20 @@ extern const pb_msgdesc_t StatusMessage_msg;
 #define StatusMessage_fields &StatusMessage_msg
 
 /* Maximum encoded size of messages (where known) */
+/* SensorBatch_size depends on runtime parameters */
 /* WifiStatus_size depends on runtime parameters */
 /* EventData_size depends on runtime parameters */
 /* UartData_size depends on runtime parameters */
 /* StatusMessage_size depends on runtime parameters */
+#define ChannelStats_size                        81
+#define ClockSync_size                           28
 #define LoadSwStatus_size                        4
-#define STATUS_PB_H_MAX_SIZE                     SensorData_size
-#define SensorChannelData_size                   15
-#define SensorData_size                          73
+#define STATUS_PB_H_MAX_SIZE                     SensorStats_size
+#define SensorChannelData_size                   45
+#define SensorDataRaw_size                       222
+#define SensorData_size                          191
+#define SensorStats_size                         283
+#define StatsSummary_size                        25
 
 #ifdef __cplusplus
 } /* extern "C" */
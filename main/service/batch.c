@@ -0,0 +1,254 @@
+#include "batch.h"
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "pb_encode.h"
+#include "pbmsg.h"
+#include "webserver.h"
+
+static const char* TAG = "batch";
+
+// Conversion times are kept as deltas so a sample fits in 16 bytes.
+typedef struct
+{
+    uint32_t delta_us; // since the previous sample of the batch, 0 for the first
+    int16_t bus_raw[SENSOR_CHANNEL_COUNT];
+    int16_t shunt_raw[SENSOR_CHANNEL_COUNT];
+} batch_sample_t;
+
+typedef struct
+{
+    uint32_t seq;
+    uint16_t count;
+    int64_t first_us;
+    int64_t last_us;
+    batch_sample_t samples[SENSOR_BATCH_MAX_SAMPLES];
+} batch_buffer_t;
+
+enum batch_field
+{
+    BATCH_FIELD_DELTA_US,
+    BATCH_FIELD_BUS,
+    BATCH_FIELD_SHUNT,
+};
+
+typedef struct
+{
+    const batch_buffer_t* buffer;
+    enum batch_field field;
+} batch_field_arg_t;
+
+// The acquisition task fills one buffer while the batch task encodes the other. The
+// pointer swap is the only shared step and happens under batch_lock.
+static batch_buffer_t batch_buffers[2];
+static batch_buffer_t* batch_fill = &batch_buffers[0];
+static portMUX_TYPE batch_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool batch_enabled;
+static uint32_t batch_next_seq;
+static TaskHandle_t batch_task_handle;
+static sensor_batch_diagnostics_t batch_diagnostics;
+
+void sensor_batch_add(const sensor_data_t* sample, int64_t conversion_us)
+{
+    if (!batch_enabled)
+        return;
+
+    taskENTER_CRITICAL(&batch_lock);
+    uint32_t seq = batch_next_seq++;
+    batch_buffer_t* buffer = batch_fill;
+    if (buffer->count >= SENSOR_BATCH_MAX_SAMPLES)
+    {
+        // The batch task has not taken the full buffer yet; it was already notified.
+        batch_diagnostics.dropped++;
+        taskEXIT_CRITICAL(&batch_lock);
+        return;
+    }
+
+    batch_sample_t* entry = &buffer->samples[buffer->count];
+    if (buffer->count == 0)
+    {
+        buffer->seq = seq;
+        buffer->first_us = conversion_us;
+        entry->delta_us = 0;
+    }
+    else
+    {
+        entry->delta_us = (uint32_t)(conversion_us - buffer->last_us);
+    }
+    buffer->last_us = conversion_us;
+    memcpy(entry->bus_raw, sample->bus_raw, sizeof(entry->bus_raw));
+    memcpy(entry->shunt_raw, sample->shunt_raw, sizeof(entry->shunt_raw));
+    bool full = ++buffer->count == SENSOR_BATCH_MAX_SAMPLES;
+    taskEXIT_CRITICAL(&batch_lock);
+
+    if (full && batch_task_handle)
+        xTaskNotifyGive(batch_task_handle);
+}
+
+static bool encode_batch_values(pb_ostream_t* stream, const batch_field_arg_t* arg)
+{
+    const batch_buffer_t* buffer = arg->buffer;
+
+    if (arg->field == BATCH_FIELD_DELTA_US)
+    {
+        for (uint16_t i = 1; i < buffer->count; i++)
+        {
+            if (!pb_encode_varint(stream, buffer->samples[i].delta_us))
+                return false;
+        }
+        return true;
+    }
+
+    int16_t prev[SENSOR_CHANNEL_COUNT] = {0};
+    for (uint16_t i = 0; i < buffer->count; i++)
+    {
+        const int16_t* values =
+            arg->field == BATCH_FIELD_BUS ? buffer->samples[i].bus_raw : buffer->samples[i].shunt_raw;
+        for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++)
+        {
+            if (!pb_encode_svarint(stream, (int32_t)values[ch] - prev[ch]))
+                return false;
+            prev[ch] = values[ch];
+        }
+    }
+    return true;
+}
+
+// Writes one packed repeated field; the length prefix comes from a sizing pass.
+static bool encode_batch_field(pb_ostream_t* stream, const pb_field_t* field, void* const* arg)
+{
+    const batch_field_arg_t* field_arg = *arg;
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    if (!encode_batch_values(&sizing, field_arg))
+        return false;
+    if (sizing.bytes_written == 0)
+        return true;
+
+    return pb_encode_tag(stream, PB_WT_STRING, field->tag) && pb_encode_varint(stream, sizing.bytes_written) &&
+           encode_batch_values(stream, field_arg);
+}
+
+static void send_batch(const batch_buffer_t* buffer)
+{
+    if (!ws_payload_subscribed(StatusMessage_sensor_batch_tag))
+        return;
+
+    batch_field_arg_t delta_arg = {.buffer = buffer, .field = BATCH_FIELD_DELTA_US};
+    batch_field_arg_t bus_arg = {.buffer = buffer, .field = BATCH_FIELD_BUS};
+    batch_field_arg_t shunt_arg = {.buffer = buffer, .field = BATCH_FIELD_SHUNT};
+
+    StatusMessage message = StatusMessage_init_zero;
+    message.which_payload = StatusMessage_sensor_batch_tag;
+    SensorBatch* batch = &message.payload.sensor_batch;
+    batch->seq = buffer->seq;
+    batch->sample_count = buffer->count;
+    batch->first_conversion_us = buffer->first_us;
+    batch->conversion_delta_us.funcs.encode = &encode_batch_field;
+    batch->conversion_delta_us.arg = &delta_arg;
+    batch->bus_mv.funcs.encode = &encode_batch_field;
+    batch->bus_mv.arg = &bus_arg;
+    batch->shunt_raw.funcs.encode = &encode_batch_field;
+    batch->shunt_raw.arg = &shunt_arg;
+    batch->shunt_mohm_count = SENSOR_CHANNEL_COUNT;
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        batch->shunt_mohm[i] = sensor_shunt_mohm(i);
+    batch->disabled_channels = ~sensor_get_channel_mask() & SENSOR_CHANNEL_MASK_ALL;
+
+    ws_frame_t* frame = ws_frame_alloc(SENSOR_BATCH_FRAME_SIZE);
+    if (!frame)
+    {
+        taskENTER_CRITICAL(&batch_lock);
+        batch_diagnostics.dropped += buffer->count;
+        taskEXIT_CRITICAL(&batch_lock);
+        return;
+    }
+
+    pb_ostream_t stream = pb_ostream_from_buffer(frame->data, frame->capacity);
+    if (!pb_encode(&stream, StatusMessage_fields, &message))
+    {
+        taskENTER_CRITICAL(&batch_lock);
+        batch_diagnostics.encode_errors++;
+        taskEXIT_CRITICAL(&batch_lock);
+        ESP_LOGE(TAG, "Failed to encode sensor batch: %s", PB_GET_ERROR(&stream));
+        ws_frame_release(frame);
+        return;
+    }
+
+    // The acquisition task counts its drops in the same structure.
+    taskENTER_CRITICAL(&batch_lock);
+    batch_diagnostics.frames++;
+    batch_diagnostics.samples += buffer->count;
+    if (stream.bytes_written > batch_diagnostics.max_frame_bytes)
+        batch_diagnostics.max_frame_bytes = stream.bytes_written;
+    taskEXIT_CRITICAL(&batch_lock);
+    frame->len = stream.bytes_written;
+    frame->payload = StatusMessage_sensor_batch_tag;
+    push_frame_to_ws(frame);
+}
+
+// Sends the filling buffer once it is full or its first sample has waited
+// SENSOR_BATCH_LATENCY_MS, whichever comes first.
+static void sensor_batch_task(void* pvParameters)
+{
+    TickType_t wait = portMAX_DELAY;
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, wait);
+        wait = batch_enabled ? pdMS_TO_TICKS(SENSOR_BATCH_LATENCY_MS) : portMAX_DELAY;
+
+        int64_t now_us = esp_timer_get_time();
+        batch_buffer_t* ready = NULL;
+        taskENTER_CRITICAL(&batch_lock);
+        batch_buffer_t* buffer = batch_fill;
+        uint16_t pending = buffer->count;
+        int64_t age_us = now_us - buffer->first_us;
+        if (pending && (pending == SENSOR_BATCH_MAX_SAMPLES || age_us >= SENSOR_BATCH_LATENCY_MS * 1000LL))
+        {
+            ready = buffer;
+            batch_fill = buffer == &batch_buffers[0] ? &batch_buffers[1] : &batch_buffers[0];
+            batch_fill->count = 0;
+        }
+        taskEXIT_CRITICAL(&batch_lock);
+
+        if (!ready)
+        {
+            // A partial batch started during the last wait; sleep until it is due.
+            if (pending && batch_enabled)
+                wait = pdMS_TO_TICKS((SENSOR_BATCH_LATENCY_MS * 1000LL - age_us) / 1000) + 1;
+            continue;
+        }
+
+        send_batch(ready);
+    }
+}
+
+void sensor_batch_enable(bool enable)
+{
+    taskENTER_CRITICAL(&batch_lock);
+    batch_enabled = enable;
+    if (!enable)
+        batch_fill->count = 0;
+    taskEXIT_CRITICAL(&batch_lock);
+
+    if (batch_task_handle)
+        xTaskNotifyGive(batch_task_handle);
+}
+
+void sensor_batch_get_diagnostics(sensor_batch_diagnostics_t* diagnostics)
+{
+    if (!diagnostics)
+        return;
+
+    taskENTER_CRITICAL(&batch_lock);
+    *diagnostics = batch_diagnostics;
+    taskEXIT_CRITICAL(&batch_lock);
+}
+
+void sensor_batch_init(void)
+{
+    xTaskCreate(sensor_batch_task, "sensor_batch", 1024 * 4, NULL, 7, &batch_task_handle);
+}
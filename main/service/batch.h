@@ -0,0 +1,30 @@
+#ifndef ODROID_POWER_MATE_BATCH_H
+#define ODROID_POWER_MATE_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "monitor.h"
+
+#define SENSOR_BATCH_MAX_SAMPLES 64
+#define SENSOR_BATCH_LATENCY_MS 50 // oldest sample of a partial batch is sent after at most this
+// Worst case: 5-byte time deltas and 3-byte value deltas for every sample, plus the header.
+#define SENSOR_BATCH_FRAME_SIZE (SENSOR_BATCH_MAX_SAMPLES * (5 + SENSOR_CHANNEL_COUNT * 2 * 3) + 64)
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t samples;
+    uint32_t dropped; // samples lost because both buffers were full or no frame was free
+    uint32_t encode_errors;
+    uint32_t max_frame_bytes;
+} sensor_batch_diagnostics_t;
+
+void sensor_batch_init(void);
+void sensor_batch_enable(bool enable);
+
+// Called by the acquisition task for every conversion while batching is enabled.
+void sensor_batch_add(const sensor_data_t* sample, int64_t conversion_us);
+void sensor_batch_get_diagnostics(sensor_batch_diagnostics_t* diagnostics);
+
+#endif // ODROID_POWER_MATE_BATCH_H
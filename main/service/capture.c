@@ -0,0 +1,393 @@
+#include "capture.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "event.h"
+#include "freertos/FreeRTOS.h"
+#include "webserver.h"
+
+#define CAPTURE_SIZE (CAPTURE_PRE_SAMPLES + CAPTURE_POST_SAMPLES)
+#define CAPTURE_CHUNK_RECORDS 32
+
+static const char* TAG = "capture";
+
+static const char* const channel_names[SENSOR_CHANNEL_COUNT] = {"usb", "main", "vin"};
+static const char* const state_names[] = {"armed", "triggered", "frozen"};
+static const char* const source_names[] = {"none", "critical", "warning", "threshold", "manual"};
+
+static sensor_data_t records[CAPTURE_SIZE];
+// Same indexing as the history log: record seq lives at (seq % CAPTURE_SIZE).
+static uint32_t total_records;
+static uint32_t trigger_seq;
+static uint32_t generation; // bumped on every re-arm so a download can detect it
+static enum capture_state state = CAPTURE_ARMED;
+static enum capture_source source = CAPTURE_SOURCE_NONE;
+static uint16_t trigger_flags;
+static uint32_t trigger_uptime_ms;
+static uint64_t trigger_timestamp_ms;
+// Software trigger level per channel as |shunt_raw|, 0 when disabled.
+static int32_t threshold_raw[SENSOR_CHANNEL_COUNT];
+static uint8_t threshold_above; // channels currently at or above their level
+static portMUX_TYPE capture_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// INA3221 flag layout: BIT2=IN1/USB, BIT1=IN2/MAIN, BIT0=IN3/VIN.
+static uint16_t channel_flag(int channel)
+{
+    return 1 << (SENSOR_CHANNEL_COUNT - 1 - channel);
+}
+
+static uint16_t pre_count_locked(void)
+{
+    return trigger_seq < CAPTURE_PRE_SAMPLES ? trigger_seq : CAPTURE_PRE_SAMPLES;
+}
+
+// Must hold capture_lock. The trigger sample is the newest one already recorded.
+static void trigger_locked(enum capture_source trigger_source, uint16_t flags)
+{
+    trigger_seq = total_records - 1;
+    state = CAPTURE_TRIGGERED;
+    source = trigger_source;
+    trigger_flags = flags;
+    trigger_uptime_ms = records[trigger_seq % CAPTURE_SIZE].uptime_ms;
+}
+
+static void set_trigger_timestamp(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t now_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
+
+    portENTER_CRITICAL(&capture_lock);
+    trigger_timestamp_ms = now_ms;
+    portEXIT_CRITICAL(&capture_lock);
+}
+
+// Called by the acquisition task for every conversion.
+void capture_add(const sensor_data_t* sample)
+{
+    bool triggered = false;
+    bool frozen = false;
+
+    portENTER_CRITICAL(&capture_lock);
+    if (state != CAPTURE_FROZEN)
+    {
+        records[total_records % CAPTURE_SIZE] = *sample;
+        total_records++;
+
+        uint8_t above = 0;
+        for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        {
+            if (threshold_raw[i] && abs(sample->shunt_raw[i]) >= threshold_raw[i])
+                above |= 1 << i;
+        }
+        uint8_t crossed = above & ~threshold_above;
+        threshold_above = above;
+
+        if (state == CAPTURE_ARMED && crossed)
+        {
+            uint16_t flags = 0;
+            for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+            {
+                if (crossed & (1 << i))
+                    flags |= channel_flag(i);
+            }
+            trigger_locked(CAPTURE_SOURCE_THRESHOLD, flags);
+            triggered = true;
+        }
+
+        if (state == CAPTURE_TRIGGERED && total_records - trigger_seq >= CAPTURE_POST_SAMPLES)
+        {
+            state = CAPTURE_FROZEN;
+            frozen = true;
+        }
+    }
+    portEXIT_CRITICAL(&capture_lock);
+
+    if (triggered)
+        set_trigger_timestamp();
+    if (frozen)
+    {
+        ESP_LOGI(TAG, "Capture frozen: source=%s flags=0x%x", source_names[source], trigger_flags);
+        push_eventf(EV_INFO, "capture frozen: source=%s", source_names[source]);
+    }
+}
+
+// Freezes the history around the latest sample. Ignored unless armed, so the first
+// alert of a burst owns the capture.
+void capture_trigger(enum capture_source trigger_source, uint16_t flags)
+{
+    bool triggered = false;
+
+    portENTER_CRITICAL(&capture_lock);
+    if (state == CAPTURE_ARMED && total_records > 0)
+    {
+        trigger_locked(trigger_source, flags);
+        triggered = true;
+    }
+    portEXIT_CRITICAL(&capture_lock);
+
+    if (triggered)
+        set_trigger_timestamp();
+}
+
+void capture_arm(void)
+{
+    portENTER_CRITICAL(&capture_lock);
+    total_records = 0;
+    trigger_seq = 0;
+    generation++;
+    state = CAPTURE_ARMED;
+    source = CAPTURE_SOURCE_NONE;
+    trigger_flags = 0;
+    trigger_uptime_ms = 0;
+    trigger_timestamp_ms = 0;
+    portEXIT_CRITICAL(&capture_lock);
+}
+
+esp_err_t capture_set_threshold(int channel, float current_a)
+{
+    if (channel < 0 || channel >= SENSOR_CHANNEL_COUNT || current_a < 0)
+        return ESP_ERR_INVALID_ARG;
+
+    // shunt_raw is 5 uV/LSB
+    float raw = current_a * sensor_shunt_mohm(channel) / 0.005f;
+    if (raw > INT16_MAX)
+        return ESP_ERR_INVALID_ARG;
+
+    portENTER_CRITICAL(&capture_lock);
+    threshold_raw[channel] = (int32_t)raw;
+    threshold_above &= ~(1 << channel);
+    portEXIT_CRITICAL(&capture_lock);
+    return ESP_OK;
+}
+
+static void add_status(cJSON* root)
+{
+    portENTER_CRITICAL(&capture_lock);
+    enum capture_state s = state;
+    enum capture_source src = source;
+    uint16_t flags = trigger_flags;
+    uint16_t pre = s == CAPTURE_ARMED ? 0 : pre_count_locked();
+    uint32_t post = s == CAPTURE_ARMED ? 0 : total_records - trigger_seq;
+    uint32_t uptime_ms = trigger_uptime_ms;
+    uint64_t timestamp_ms = trigger_timestamp_ms;
+    int32_t thresholds[SENSOR_CHANNEL_COUNT];
+    memcpy(thresholds, threshold_raw, sizeof(thresholds));
+    portEXIT_CRITICAL(&capture_lock);
+
+    cJSON_AddStringToObject(root, "state", state_names[s]);
+    cJSON_AddStringToObject(root, "source", source_names[src]);
+    cJSON_AddNumberToObject(root, "flags", flags);
+    cJSON_AddNumberToObject(root, "pre_count", pre);
+    cJSON_AddNumberToObject(root, "post_count", post);
+    cJSON_AddNumberToObject(root, "pre_capacity", CAPTURE_PRE_SAMPLES);
+    cJSON_AddNumberToObject(root, "post_capacity", CAPTURE_POST_SAMPLES);
+    cJSON_AddNumberToObject(root, "trigger_uptime_ms", uptime_ms);
+    cJSON_AddNumberToObject(root, "trigger_timestamp_ms", timestamp_ms);
+
+    cJSON* threshold = cJSON_AddObjectToObject(root, "threshold_a");
+    if (!threshold)
+        return;
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        cJSON_AddNumberToObject(threshold, channel_names[i], thresholds[i] * 0.005f / sensor_shunt_mohm(i));
+}
+
+static esp_err_t send_status(httpd_req_t* req)
+{
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+    add_status(root);
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    esp_err_t err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+static esp_err_t capture_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    return send_status(req);
+}
+
+static esp_err_t capture_post_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    char buf[192];
+    int ret, remaining = req->content_len;
+
+    if (remaining >= sizeof(buf))
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Request content too long");
+        return ESP_FAIL;
+    }
+
+    ret = httpd_req_recv(req, buf, remaining);
+    if (ret <= 0)
+    {
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(req);
+        return ESP_FAIL;
+    }
+    buf[ret] = '\0';
+
+    cJSON* root = cJSON_Parse(buf);
+    if (root == NULL)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON format");
+        return ESP_FAIL;
+    }
+
+    // Validate every threshold before applying any of them.
+    cJSON* threshold = cJSON_GetObjectItem(root, "threshold_a");
+    if (threshold)
+    {
+        bool valid = cJSON_IsObject(threshold);
+        for (int i = 0; valid && i < SENSOR_CHANNEL_COUNT; i++)
+        {
+            cJSON* item = cJSON_GetObjectItem(threshold, channel_names[i]);
+            if (item && (!cJSON_IsNumber(item) || item->valuedouble < 0 ||
+                         item->valuedouble * sensor_shunt_mohm(i) / 0.005 > INT16_MAX))
+                valid = false;
+        }
+        if (!valid)
+        {
+            cJSON_Delete(root);
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid threshold");
+            return ESP_FAIL;
+        }
+        for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        {
+            cJSON* item = cJSON_GetObjectItem(threshold, channel_names[i]);
+            if (item)
+                capture_set_threshold(i, item->valuedouble);
+        }
+    }
+
+    bool arm = cJSON_IsTrue(cJSON_GetObjectItem(root, "arm"));
+    bool trigger = cJSON_IsTrue(cJSON_GetObjectItem(root, "trigger"));
+    cJSON_Delete(root);
+
+    if (!threshold && !arm && !trigger)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Nothing to do");
+        return ESP_FAIL;
+    }
+
+    if (arm)
+        capture_arm();
+    if (trigger)
+        capture_trigger(CAPTURE_SOURCE_MANUAL, 0);
+
+    return send_status(req);
+}
+
+// Streams the frozen capture: a capture_header_t followed by the records in time order.
+static esp_err_t capture_data_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    capture_header_t header = {
+        .magic = CAPTURE_MAGIC,
+        .version = CAPTURE_VERSION,
+        .record_size = sizeof(sensor_data_t),
+        .channel_count = SENSOR_CHANNEL_COUNT,
+        .enabled_channels = sensor_get_channel_mask(),
+    };
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        header.shunt_mohm[i] = sensor_shunt_mohm(i);
+
+    portENTER_CRITICAL(&capture_lock);
+    bool frozen = state == CAPTURE_FROZEN;
+    uint32_t gen = generation;
+    uint32_t trigger = trigger_seq;
+    header.state = state;
+    header.source = source;
+    header.flags = trigger_flags;
+    header.pre_count = pre_count_locked();
+    header.post_count = total_records - trigger_seq;
+    header.trigger_uptime_ms = trigger_uptime_ms;
+    header.trigger_timestamp_ms = trigger_timestamp_ms;
+    portEXIT_CRITICAL(&capture_lock);
+
+    if (!frozen)
+    {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "No frozen capture");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"capture.bin\"");
+    err = httpd_resp_send_chunk(req, (const char*)&header, sizeof(header));
+    if (err != ESP_OK)
+        return err;
+
+    sensor_data_t chunk[CAPTURE_CHUNK_RECORDS];
+    uint32_t seq = trigger - header.pre_count;
+    uint32_t end_seq = trigger + header.post_count;
+    while (seq < end_seq)
+    {
+        size_t count = 0;
+        portENTER_CRITICAL(&capture_lock);
+        bool rearmed = generation != gen;
+        while (!rearmed && count < CAPTURE_CHUNK_RECORDS && seq < end_seq)
+            chunk[count++] = records[seq++ % CAPTURE_SIZE];
+        portEXIT_CRITICAL(&capture_lock);
+
+        if (rearmed)
+        {
+            ESP_LOGW(TAG, "Capture re-armed during download");
+            return ESP_FAIL;
+        }
+
+        err = httpd_resp_send_chunk(req, (const char*)chunk, count * sizeof(sensor_data_t));
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Capture transfer aborted: %s", esp_err_to_name(err));
+            return err;
+        }
+    }
+
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+void register_capture_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {
+        .uri = "/api/capture", .method = HTTP_GET, .handler = capture_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+
+    httpd_uri_t post_uri = {
+        .uri = "/api/capture", .method = HTTP_POST, .handler = capture_post_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &post_uri);
+
+    httpd_uri_t data_uri = {
+        .uri = "/api/capture/data", .method = HTTP_GET, .handler = capture_data_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &data_uri);
+}
@@ -0,0 +1,54 @@
+#ifndef ODROID_POWER_MATE_CAPTURE_H
+#define ODROID_POWER_MATE_CAPTURE_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "monitor.h"
+
+#define CAPTURE_PRE_SAMPLES 500
+#define CAPTURE_POST_SAMPLES 500
+#define CAPTURE_MAGIC 0x31434d50 // "PMC1"
+#define CAPTURE_VERSION 2
+
+enum capture_state
+{
+    CAPTURE_ARMED = 0,     // recording pre-trigger history
+    CAPTURE_TRIGGERED = 1, // recording post-trigger samples
+    CAPTURE_FROZEN = 2,    // complete, kept until re-armed
+};
+
+enum capture_source
+{
+    CAPTURE_SOURCE_NONE = 0,
+    CAPTURE_SOURCE_CRITICAL = 1,
+    CAPTURE_SOURCE_WARNING = 2,
+    CAPTURE_SOURCE_THRESHOLD = 3,
+    CAPTURE_SOURCE_MANUAL = 4,
+};
+
+// Little-endian header sent ahead of the raw sensor_data_t records by /api/capture/data.
+// Records are in time order; the trigger sample is records[pre_count].
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint16_t channel_count;
+    uint16_t shunt_mohm[SENSOR_CHANNEL_COUNT];
+    uint8_t state;
+    uint8_t source;
+    uint16_t flags; // INA3221 flag bits of the trigger: BIT2=USB, BIT1=MAIN, BIT0=VIN
+    uint16_t pre_count;
+    uint16_t post_count;
+    uint32_t trigger_uptime_ms;
+    uint64_t trigger_timestamp_ms; // wall clock at the trigger, 0 if the clock was not set
+    uint16_t enabled_channels; // bit n = channel n; disabled channels are recorded as 0
+} capture_header_t;
+
+void capture_add(const sensor_data_t* sample);
+void capture_trigger(enum capture_source source, uint16_t flags);
+void capture_arm(void);
+esp_err_t capture_set_threshold(int channel, float current_a);
+
+#endif // ODROID_POWER_MATE_CAPTURE_H
@@ -19,6 +19,34 @@
 #define USB_CRITICAL_CURRENT_LIMIT_MAX 6.0f
 #define CRITICAL_CURRENT_LIMIT_MIN 1.0f
 
+enum climit_slot
+{
+    CLIMIT_VIN = 0,
+    CLIMIT_MAIN,
+    CLIMIT_USB,
+    CLIMIT_CRITICAL_VIN,
+    CLIMIT_CRITICAL_MAIN,
+    CLIMIT_CRITICAL_USB,
+    CLIMIT_SLOT_COUNT
+};
+
+// Limits to program together; only slots with their bit in staged are written.
+typedef struct
+{
+    uint8_t staged; // BIT(slot)
+    double value[CLIMIT_SLOT_COUNT]; // A, 0 disables a warning limit
+} climit_batch_t;
+
+typedef struct
+{
+    uint8_t written; // BIT(slot) of limits written to the INA3221
+    uint8_t verified; // BIT(slot) of limits whose readback matched
+    bool readback; // applied_a and raw hold all six registers
+    float applied_a[CLIMIT_SLOT_COUNT];
+    uint16_t raw[CLIMIT_SLOT_COUNT];
+    esp_err_t err[CLIMIT_SLOT_COUNT]; // per staged slot
+} climit_batch_result_t;
+
 esp_err_t climit_set_vin(double value);
 esp_err_t climit_set_main(double value);
 esp_err_t climit_set_usb(double value);
@@ -31,6 +59,9 @@ esp_err_t climit_get_usb(float* limit_a, uint16_t* raw);
 esp_err_t climit_get_critical_vin(float* limit_a, uint16_t* raw);
 esp_err_t climit_get_critical_main(float* limit_a, uint16_t* raw);
 esp_err_t climit_get_critical_usb(float* limit_a, uint16_t* raw);
+void climit_batch_stage(climit_batch_t* batch, enum climit_slot slot, double value);
+// Returns ESP_OK when every staged limit was written and verified, else the first error.
+esp_err_t climit_apply_batch(const climit_batch_t* batch, climit_batch_result_t* result);
 bool is_overcurrent();
 
 #endif // ODROID_POWER_MATE_CLIMIT_H
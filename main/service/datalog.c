@@ -0,0 +1,190 @@
+#include "datalog.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "auth.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "webserver.h"
+
+#define DATALOG_CHUNK_RECORDS 32
+
+static const char* TAG = "datalog";
+
+static sensor_data_t records[SENSOR_BUFFER_SIZE];
+// Total number of records ever written. The oldest retained record is
+// max(0, total - SENSOR_BUFFER_SIZE) and lives at index (seq % SENSOR_BUFFER_SIZE).
+static uint32_t total_records;
+static portMUX_TYPE datalog_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void datalog_add(const sensor_data_t* sample)
+{
+    portENTER_CRITICAL(&datalog_lock);
+    records[total_records % SENSOR_BUFFER_SIZE] = *sample;
+    total_records++;
+    portEXIT_CRITICAL(&datalog_lock);
+}
+
+static uint32_t oldest_seq(uint32_t total)
+{
+    return total > SENSOR_BUFFER_SIZE ? total - SENSOR_BUFFER_SIZE : 0;
+}
+
+// Records carry a 32-bit uptime that wraps every 49.7 days. The ring spans far
+// less than that, so a record's full uptime is recovered from its age relative
+// to now_ms, which must not precede the record.
+static uint64_t record_uptime_ms(const sensor_data_t* record, uint64_t now_ms)
+{
+    return now_ms - (uint32_t)((uint32_t)now_ms - record->uptime_ms);
+}
+
+// Returns the first retained sequence number before end_seq whose uptime is >= from_ms.
+static uint32_t find_first_seq(uint64_t from_ms, uint32_t end_seq, uint64_t now_ms)
+{
+    portENTER_CRITICAL(&datalog_lock);
+    uint32_t lo = oldest_seq(total_records);
+    uint32_t hi = end_seq;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (record_uptime_ms(&records[mid % SENSOR_BUFFER_SIZE], now_ms) < from_ms)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    portEXIT_CRITICAL(&datalog_lock);
+    return lo;
+}
+
+// Copies up to max records starting at *seq. Records overwritten since the
+// caller's last read are skipped. Returns the number of records copied.
+static size_t copy_records(uint32_t* seq, uint32_t end_seq, sensor_data_t* out, size_t max)
+{
+    size_t count = 0;
+
+    portENTER_CRITICAL(&datalog_lock);
+    uint32_t oldest = oldest_seq(total_records);
+    if (*seq < oldest)
+        *seq = oldest;
+    while (count < max && *seq < end_seq)
+    {
+        out[count++] = records[*seq % SENSOR_BUFFER_SIZE];
+        (*seq)++;
+    }
+    portEXIT_CRITICAL(&datalog_lock);
+
+    return count;
+}
+
+static uint64_t query_u64(const char* query, const char* key, uint64_t default_value)
+{
+    char value[24];
+    if (!query || httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK)
+        return default_value;
+    return strtoull(value, NULL, 10);
+}
+
+static esp_err_t history_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    char* query = NULL;
+    size_t query_len = httpd_req_get_url_query_len(req) + 1;
+    if (query_len > 1)
+    {
+        query = malloc(query_len);
+        if (query && httpd_req_get_url_query_str(req, query, query_len) != ESP_OK)
+        {
+            free(query);
+            query = NULL;
+        }
+    }
+
+    uint64_t from_ms = query_u64(query, "from", 0);
+    uint64_t to_ms = query_u64(query, "to", UINT64_MAX);
+    free(query);
+
+    if (from_ms > to_ms)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "from must not be after to");
+        return ESP_FAIL;
+    }
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    datalog_header_t header = {
+        .magic = DATALOG_MAGIC,
+        .version = DATALOG_VERSION,
+        .record_size = sizeof(sensor_data_t),
+        .channel_count = SENSOR_CHANNEL_COUNT,
+        .capacity = SENSOR_BUFFER_SIZE,
+        .timestamp_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000,
+        .uptime_ms = (uint64_t)esp_timer_get_time() / 1000,
+        .enabled_channels = sensor_get_channel_mask(),
+    };
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        header.shunt_mohm[i] = sensor_shunt_mohm(i);
+
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    err = httpd_resp_send_chunk(req, (const char*)&header, sizeof(header));
+    if (err != ESP_OK)
+        return err;
+
+    // Only stream what existed when the request arrived so a fast sampler
+    // cannot keep the response open indefinitely.
+    portENTER_CRITICAL(&datalog_lock);
+    uint32_t end_seq = total_records;
+    portEXIT_CRITICAL(&datalog_lock);
+    // Taken after the snapshot so no record up to end_seq is newer than it.
+    uint64_t now_ms = (uint64_t)esp_timer_get_time() / 1000;
+
+    sensor_data_t chunk[DATALOG_CHUNK_RECORDS];
+    uint32_t seq = find_first_seq(from_ms, end_seq, now_ms);
+    bool done = false;
+    while (!done)
+    {
+        size_t count = copy_records(&seq, end_seq, chunk, DATALOG_CHUNK_RECORDS);
+        if (count == 0)
+            break;
+
+        size_t send_count = count;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (record_uptime_ms(&chunk[i], now_ms) > to_ms)
+            {
+                send_count = i;
+                done = true;
+                break;
+            }
+        }
+
+        if (send_count > 0)
+        {
+            err = httpd_resp_send_chunk(req, (const char*)chunk, send_count * sizeof(sensor_data_t));
+            if (err != ESP_OK)
+            {
+                ESP_LOGW(TAG, "History transfer aborted: %s", esp_err_to_name(err));
+                return err;
+            }
+        }
+    }
+
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+void register_history_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t history = {
+        .uri = "/api/history",
+        .method = HTTP_GET,
+        .handler = history_get_handler,
+        .user_ctx = NULL,
+    };
+    httpd_register_uri_handler(server, &history);
+}
@@ -0,0 +1,27 @@
+#ifndef ODROID_POWER_MATE_DATALOG_H
+#define ODROID_POWER_MATE_DATALOG_H
+
+#include <stdint.h>
+
+#include "monitor.h"
+
+#define DATALOG_MAGIC 0x31484d50 // "PMH1"
+#define DATALOG_VERSION 2
+
+// Little-endian header sent ahead of the raw sensor_data_t records by /api/history.
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint16_t channel_count;
+    uint16_t shunt_mohm[SENSOR_CHANNEL_COUNT];
+    uint32_t capacity;
+    uint64_t timestamp_ms; // wall clock when the response was generated
+    uint64_t uptime_ms;    // uptime matching timestamp_ms
+    uint16_t enabled_channels; // bit n = channel n; disabled channels are recorded as 0
+} datalog_header_t;
+
+void datalog_add(const sensor_data_t* sample);
+
+#endif // ODROID_POWER_MATE_DATALOG_H
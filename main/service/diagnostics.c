@@ -1,4 +1,5 @@
 #include "auth.h"
+#include "batch.h"
 #include "cJSON.h"
 #include <stdlib.h>
 #include "esp_heap_caps.h"
@@ -6,7 +7,10 @@
 #include "esp_netif.h"
 #include "esp_system.h"
 #include "esp_timer.h"
+#include "event.h"
+#include "monitor.h"
 #include "nconfig.h"
+#include "sag.h"
 #include "webserver.h"
 #include "wifi.h"
 
@@ -73,6 +77,78 @@ static esp_err_t diagnostics_get_handler(httpd_req_t* req)
     cJSON_AddNumberToObject(root, "uart_buffer_full_events", ws_diagnostics.uart_buffer_full_events);
     cJSON_AddNumberToObject(root, "uart_queue_drops", ws_diagnostics.uart_queue_drops);
     cJSON_AddNumberToObject(root, "status_queue_drops", ws_diagnostics.status_queue_drops);
+    cJSON_AddNumberToObject(root, "ws_frame_alloc_failures", ws_diagnostics.frame_alloc_failures);
+    cJSON_AddNumberToObject(root, "ws_small_frames_free", ws_diagnostics.small_frames_free);
+    cJSON_AddNumberToObject(root, "ws_small_frames_low_water", ws_diagnostics.small_frames_low_water);
+    cJSON_AddNumberToObject(root, "ws_large_frames_free", ws_diagnostics.large_frames_free);
+    cJSON_AddNumberToObject(root, "ws_large_frames_low_water", ws_diagnostics.large_frames_low_water);
+
+    cJSON* ws_clients = cJSON_AddArrayToObject(root, "websocket_sessions");
+    for (uint8_t i = 0; ws_clients && i < ws_diagnostics.client_count; ++i)
+    {
+        const websocket_client_diagnostics_t* client = &ws_diagnostics.clients[i];
+        cJSON* entry = cJSON_CreateObject();
+        if (!entry)
+            break;
+        cJSON_AddNumberToObject(entry, "fd", client->fd);
+        cJSON_AddStringToObject(entry, "stream", client->uart ? "uart" : "status");
+        cJSON_AddNumberToObject(entry, "queue_depth", client->queue_depth);
+        cJSON_AddNumberToObject(entry, "max_queue_depth", client->max_queue_depth);
+        cJSON_AddNumberToObject(entry, "lag_ms", client->lag_ms);
+        cJSON_AddNumberToObject(entry, "max_lag_ms", client->max_lag_ms);
+        cJSON_AddNumberToObject(entry, "sent", client->sent);
+        cJSON_AddNumberToObject(entry, "dropped", client->dropped);
+        cJSON_AddItemToArray(ws_clients, entry);
+    }
+
+    event_diagnostics_t event_diagnostics;
+    event_get_diagnostics(&event_diagnostics);
+    cJSON_AddNumberToObject(root, "event_queued", event_diagnostics.queued);
+    cJSON_AddNumberToObject(root, "event_dropped", event_diagnostics.dropped);
+    cJSON_AddNumberToObject(root, "event_text_fallbacks", event_diagnostics.text_fallbacks);
+    cJSON_AddNumberToObject(root, "event_queue_high_water", event_diagnostics.high_water);
+    cJSON_AddNumberToObject(root, "event_queue_capacity", EVENT_RING_SIZE);
+
+    sensor_diagnostics_t sensor_diagnostics;
+    sensor_get_diagnostics(&sensor_diagnostics);
+    cJSON_AddNumberToObject(root, "sensor_conversion_time_us", sensor_diagnostics.conversion_time_us);
+    cJSON_AddNumberToObject(root, "sensor_samples", sensor_diagnostics.samples);
+    cJSON_AddNumberToObject(root, "sensor_missed_deadlines", sensor_diagnostics.missed_deadlines);
+    cJSON_AddNumberToObject(root, "sensor_ready_timeouts", sensor_diagnostics.ready_timeouts);
+    cJSON_AddNumberToObject(root, "sensor_read_errors", sensor_diagnostics.read_errors);
+    cJSON_AddNumberToObject(root, "sensor_max_jitter_us", sensor_diagnostics.max_jitter_us);
+    cJSON* jitter_histogram = cJSON_AddArrayToObject(root, "sensor_jitter_histogram");
+    for (int i = 0; jitter_histogram && i < SENSOR_JITTER_BUCKETS; ++i)
+        cJSON_AddItemToArray(jitter_histogram, cJSON_CreateNumber(sensor_diagnostics.jitter_histogram[i]));
+    cJSON_AddNumberToObject(root, "sensor_publish_count", sensor_diagnostics.publish_count);
+    cJSON_AddNumberToObject(root, "sensor_publish_overruns", sensor_diagnostics.publish_overruns);
+    cJSON_AddNumberToObject(root, "sensor_register_scrubs", sensor_diagnostics.scrubs);
+    cJSON_AddNumberToObject(root, "sensor_register_scrub_errors", sensor_diagnostics.scrub_errors);
+    cJSON_AddNumberToObject(root, "sensor_limit_drift", sensor_diagnostics.limit_drift);
+    cJSON_AddNumberToObject(root, "sensor_config_drift", sensor_diagnostics.config_drift);
+
+    sensor_batch_diagnostics_t batch_diagnostics;
+    sensor_batch_get_diagnostics(&batch_diagnostics);
+    cJSON_AddNumberToObject(root, "sensor_batch_frames", batch_diagnostics.frames);
+    cJSON_AddNumberToObject(root, "sensor_batch_samples", batch_diagnostics.samples);
+    cJSON_AddNumberToObject(root, "sensor_batch_dropped", batch_diagnostics.dropped);
+    cJSON_AddNumberToObject(root, "sensor_batch_encode_errors", batch_diagnostics.encode_errors);
+    cJSON_AddNumberToObject(root, "sensor_batch_max_frame_bytes", batch_diagnostics.max_frame_bytes);
+
+    sag_diagnostics_t sag_diagnostics;
+    sag_get_diagnostics(&sag_diagnostics);
+    cJSON_AddNumberToObject(root, "vin_sag_threshold_mv", sag_diagnostics.threshold_mv);
+    cJSON_AddNumberToObject(root, "vin_sag_count", sag_diagnostics.count);
+    cJSON_AddNumberToObject(root, "vin_sag_events_folded", sag_diagnostics.events_folded);
+    cJSON_AddNumberToObject(root, "vin_sag_deepest_mv", sag_diagnostics.deepest_mv);
+    cJSON_AddNumberToObject(root, "vin_sag_longest_us", sag_diagnostics.longest_us);
+    cJSON_AddNumberToObject(root, "vin_sag_last_uptime_ms", sag_diagnostics.last_uptime_ms);
+    cJSON_AddNumberToObject(root, "vin_sag_last_min_mv", sag_diagnostics.last_min_mv);
+    cJSON_AddNumberToObject(root, "vin_sag_last_duration_us", sag_diagnostics.last_duration_us);
+    cJSON_AddNumberToObject(root, "vin_sag_conversions", sag_diagnostics.conversions);
+    cJSON_AddNumberToObject(root, "vin_sag_coverage",
+                            sag_diagnostics.elapsed_us ? (double)sag_diagnostics.watched_us / sag_diagnostics.elapsed_us
+                                                       : 0.0);
 
     wifi_sta_diagnostics_t wifi_diagnostics;
     wifi_get_sta_diagnostics(&wifi_diagnostics);
@@ -0,0 +1,251 @@
+#include "energy.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "nconfig.h"
+#include "webserver.h"
+
+#define NJ_PER_WH 3.6e12
+#define NC_PER_MAH 3.6e9
+#define NJ_PER_UWH 3600000LL
+#define NC_PER_UAH 3600000LL
+
+static const char* TAG = "energy";
+
+// Integer accumulators so long runs do not lose resolution: nanojoules and nanocoulombs.
+static int64_t energy_nj[SENSOR_CHANNEL_COUNT];
+static int64_t charge_nc[SENSOR_CHANNEL_COUNT];
+static uint64_t reset_timestamp_ms;
+static int64_t last_checkpoint_us;
+static portMUX_TYPE energy_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char* const channel_names[SENSOR_CHANNEL_COUNT] = {"usb", "main", "vin"};
+
+void energy_init(void)
+{
+    char buf[192];
+    if (nconfig_read(ENERGY_CHECKPOINT, buf, sizeof(buf)) != ESP_OK)
+        return;
+
+    int64_t e[SENSOR_CHANNEL_COUNT], c[SENSOR_CHANNEL_COUNT];
+    uint64_t ts;
+    int n = sscanf(buf, "%" SCNu64 ",%" SCNd64 ",%" SCNd64 ",%" SCNd64 ",%" SCNd64 ",%" SCNd64 ",%" SCNd64, &ts,
+                   &e[0], &e[1], &e[2], &c[0], &c[1], &c[2]);
+    if (n != 1 + SENSOR_CHANNEL_COUNT * 2)
+    {
+        ESP_LOGW(TAG, "Ignoring malformed energy checkpoint");
+        return;
+    }
+
+    portENTER_CRITICAL(&energy_lock);
+    memcpy(energy_nj, e, sizeof(energy_nj));
+    memcpy(charge_nc, c, sizeof(charge_nc));
+    reset_timestamp_ms = ts;
+    portEXIT_CRITICAL(&energy_lock);
+    last_checkpoint_us = esp_timer_get_time();
+}
+
+// Integrates one conversion over dt_us, the time since the previous one. Each INA3221
+// result is already an average over its conversion window, so a rectangle rule fits.
+void energy_add(const sensor_data_t* sample, int64_t dt_us)
+{
+    if (dt_us <= 0)
+        return;
+
+    int64_t de[SENSOR_CHANNEL_COUNT], dc[SENSOR_CHANNEL_COUNT];
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        int64_t mohm = sensor_shunt_mohm(i);
+        // shunt_raw * 5 uV / mOhm = A, bus_raw = mV
+        dc[i] = (int64_t)sample->shunt_raw[i] * 5 * dt_us / mohm;
+        de[i] = (int64_t)sample->bus_raw[i] * sample->shunt_raw[i] * 5 * dt_us / (1000 * mohm);
+    }
+
+    portENTER_CRITICAL(&energy_lock);
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        energy_nj[i] += de[i];
+        charge_nc[i] += dc[i];
+    }
+    portEXIT_CRITICAL(&energy_lock);
+}
+
+void energy_snapshot(energy_snapshot_t* snapshot)
+{
+    int64_t e[SENSOR_CHANNEL_COUNT], c[SENSOR_CHANNEL_COUNT];
+
+    portENTER_CRITICAL(&energy_lock);
+    memcpy(e, energy_nj, sizeof(e));
+    memcpy(c, charge_nc, sizeof(c));
+    snapshot->reset_timestamp_ms = reset_timestamp_ms;
+    portEXIT_CRITICAL(&energy_lock);
+
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        snapshot->energy_wh[i] = (double)e[i] / NJ_PER_WH;
+        snapshot->charge_mah[i] = (double)c[i] / NC_PER_MAH;
+    }
+}
+
+// Integer-only variant for the raw sensor stream: microwatt-hours and microamp-hours.
+void energy_snapshot_raw(int64_t energy_uwh[SENSOR_CHANNEL_COUNT], int64_t charge_uah[SENSOR_CHANNEL_COUNT])
+{
+    portENTER_CRITICAL(&energy_lock);
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        energy_uwh[i] = energy_nj[i] / NJ_PER_UWH;
+        charge_uah[i] = charge_nc[i] / NC_PER_UAH;
+    }
+    portEXIT_CRITICAL(&energy_lock);
+}
+
+esp_err_t energy_checkpoint(void)
+{
+    int64_t e[SENSOR_CHANNEL_COUNT], c[SENSOR_CHANNEL_COUNT];
+    uint64_t ts;
+
+    portENTER_CRITICAL(&energy_lock);
+    memcpy(e, energy_nj, sizeof(e));
+    memcpy(c, charge_nc, sizeof(c));
+    ts = reset_timestamp_ms;
+    portEXIT_CRITICAL(&energy_lock);
+
+    char buf[192];
+    snprintf(buf, sizeof(buf), "%" PRIu64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64, ts,
+             e[0], e[1], e[2], c[0], c[1], c[2]);
+
+    last_checkpoint_us = esp_timer_get_time();
+    esp_err_t err = nconfig_write(ENERGY_CHECKPOINT, buf);
+    if (err != ESP_OK)
+        ESP_LOGW(TAG, "Failed to save energy checkpoint: %s", esp_err_to_name(err));
+    return err;
+}
+
+void energy_checkpoint_if_due(void)
+{
+    if (esp_timer_get_time() - last_checkpoint_us >= (int64_t)ENERGY_CHECKPOINT_INTERVAL_MS * 1000)
+        energy_checkpoint();
+}
+
+esp_err_t energy_reset(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+
+    portENTER_CRITICAL(&energy_lock);
+    memset(energy_nj, 0, sizeof(energy_nj));
+    memset(charge_nc, 0, sizeof(charge_nc));
+    reset_timestamp_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
+    portEXIT_CRITICAL(&energy_lock);
+
+    ESP_LOGI(TAG, "Energy counters reset");
+    return energy_checkpoint();
+}
+
+static esp_err_t energy_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    energy_snapshot_t snapshot;
+    energy_snapshot(&snapshot);
+
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddNumberToObject(root, "reset_timestamp_ms", snapshot.reset_timestamp_ms);
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        cJSON* channel = cJSON_AddObjectToObject(root, channel_names[i]);
+        if (!channel)
+            continue;
+        cJSON_AddNumberToObject(channel, "energy_wh", snapshot.energy_wh[i]);
+        cJSON_AddNumberToObject(channel, "charge_mah", snapshot.charge_mah[i]);
+    }
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+static esp_err_t energy_post_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    char buf[64];
+    int ret, remaining = req->content_len;
+
+    if (remaining >= sizeof(buf))
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Request content too long");
+        return ESP_FAIL;
+    }
+
+    ret = httpd_req_recv(req, buf, remaining);
+    if (ret <= 0)
+    {
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(req);
+        return ESP_FAIL;
+    }
+    buf[ret] = '\0';
+
+    cJSON* root = cJSON_Parse(buf);
+    if (root == NULL)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON format");
+        return ESP_FAIL;
+    }
+
+    bool reset = cJSON_IsTrue(cJSON_GetObjectItem(root, "reset"));
+    cJSON_Delete(root);
+
+    if (!reset)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Nothing to do");
+        return ESP_FAIL;
+    }
+
+    if (energy_reset() != ESP_OK)
+    {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save energy counters");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_sendstr(req, "{\"status\":\"ok\"}");
+    return ESP_OK;
+}
+
+void register_energy_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {.uri = "/api/energy", .method = HTTP_GET, .handler = energy_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+
+    httpd_uri_t post_uri = {
+        .uri = "/api/energy", .method = HTTP_POST, .handler = energy_post_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &post_uri);
+}
@@ -0,0 +1,29 @@
+#ifndef ODROID_POWER_MATE_ENERGY_H
+#define ODROID_POWER_MATE_ENERGY_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+#include "monitor.h"
+
+#define ENERGY_CHECKPOINT_INTERVAL_MS (10 * 60 * 1000)
+
+// Accumulated totals per INA3221 channel (USB, MAIN, VIN) since the last reset.
+typedef struct
+{
+    double energy_wh[SENSOR_CHANNEL_COUNT];
+    double charge_mah[SENSOR_CHANNEL_COUNT];
+    uint64_t reset_timestamp_ms; // wall clock of the last reset, 0 if the clock was not set
+} energy_snapshot_t;
+
+void energy_init(void);
+void energy_add(const sensor_data_t* sample, int64_t dt_us);
+void energy_snapshot(energy_snapshot_t* snapshot);
+void energy_snapshot_raw(int64_t energy_uwh[SENSOR_CHANNEL_COUNT], int64_t charge_uah[SENSOR_CHANNEL_COUNT]);
+esp_err_t energy_reset(void);
+esp_err_t energy_checkpoint(void);
+void energy_checkpoint_if_due(void);
+void register_energy_endpoint(httpd_handle_t server);
+
+#endif // ODROID_POWER_MATE_ENERGY_H
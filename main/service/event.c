@@ -4,38 +4,444 @@
 
 #include "event.h"
 
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
 #include <sys/time.h>
 
 #include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "journal.h"
+
+// Producers only copy the format pointer and the raw arguments into a ring slot; the
+// event task formats, encodes and queues them for the WebSocket clients later. Formats
+// are string literals, so the pointer stays valid; string arguments are copied.
+//
+// The ring is a bounded multi-producer queue: a producer claims a position with a CAS on
+// event_head and publishes the slot by advancing its sequence. Slot n is free for lap l
+// when seq == 2l and holds an event when seq == 2l + 1, so the zeroed ring needs no init
+// and events pushed before event_init() are kept.
+typedef struct
+{
+    uint32_t seq;
+    uint8_t level;
+    const char* format; // NULL when args holds the finished text
+    int64_t uptime_us;
+    uint8_t args[EVENT_ARG_BYTES];
+} event_slot_t;
+
+enum event_arg_type
+{
+    EVENT_ARG_NONE, // "%%"
+    EVENT_ARG_INT,
+    EVENT_ARG_LONG,
+    EVENT_ARG_LLONG,
+    EVENT_ARG_SIZE,
+    EVENT_ARG_DOUBLE,
+    EVENT_ARG_STRING,
+    EVENT_ARG_POINTER,
+    EVENT_ARG_UNSUPPORTED,
+};
+
+static event_slot_t event_ring[EVENT_RING_SIZE];
+static uint32_t event_head; // next position to claim, shared by the producers
+static uint32_t event_tail; // next position to read, event task only
+static event_diagnostics_t event_diagnostics;
+static TaskHandle_t event_task_handle;
+
+// Parses the conversion starting at the '%' at p; returns the character after it.
+static const char* event_next_spec(const char* p, enum event_arg_type* type)
+{
+    p++;
+    if (*p == '%')
+    {
+        *type = EVENT_ARG_NONE;
+        return p + 1;
+    }
+
+    p += strspn(p, "-+ #0");
+    p += strspn(p, "0123456789");
+    if (*p == '.')
+    {
+        p++;
+        p += strspn(p, "0123456789");
+    }
+    int longs = 0;
+    bool size = false;
+    for (; *p == 'l' || *p == 'h' || *p == 'z' || *p == 't'; p++)
+    {
+        if (*p == 'l')
+            longs++;
+        else if (*p != 'h')
+            size = true;
+    }
+
+    switch (*p)
+    {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+    case 'c':
+        *type = longs >= 2 ? EVENT_ARG_LLONG : longs ? EVENT_ARG_LONG : size ? EVENT_ARG_SIZE : EVENT_ARG_INT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        *type = EVENT_ARG_DOUBLE;
+        break;
+    case 's':
+        *type = EVENT_ARG_STRING;
+        break;
+    case 'p':
+        *type = EVENT_ARG_POINTER;
+        break;
+    default: // '*' widths, %n, long double and a truncated format
+        *type = EVENT_ARG_UNSUPPORTED;
+        return *p ? p + 1 : p;
+    }
+    return p + 1;
+}
+
+static bool event_put(event_slot_t* slot, size_t* len, const void* value, size_t size)
+{
+    if (*len + size > EVENT_ARG_BYTES)
+        return false;
+    memcpy(slot->args + *len, value, size);
+    *len += size;
+    return true;
+}
+
+static bool event_capture_args(event_slot_t* slot, const char* format, va_list ap)
+{
+    size_t len = 0;
+    for (const char* p = strchr(format, '%'); p; p = strchr(p, '%'))
+    {
+        enum event_arg_type type;
+        p = event_next_spec(p, &type);
+
+        bool stored = true;
+        switch (type)
+        {
+        case EVENT_ARG_NONE:
+            break;
+        case EVENT_ARG_INT:
+        {
+            int value = va_arg(ap, int);
+            stored = event_put(slot, &len, &value, sizeof(value));
+            break;
+        }
+        case EVENT_ARG_LONG:
+        {
+            long value = va_arg(ap, long);
+            stored = event_put(slot, &len, &value, sizeof(value));
+            break;
+        }
+        case EVENT_ARG_LLONG:
+        {
+            long long value = va_arg(ap, long long);
+            stored = event_put(slot, &len, &value, sizeof(value));
+            break;
+        }
+        case EVENT_ARG_SIZE:
+        {
+            size_t value = va_arg(ap, size_t);
+            stored = event_put(slot, &len, &value, sizeof(value));
+            break;
+        }
+        case EVENT_ARG_DOUBLE:
+        {
+            double value = va_arg(ap, double);
+            stored = event_put(slot, &len, &value, sizeof(value));
+            break;
+        }
+        case EVENT_ARG_STRING:
+        {
+            const char* value = va_arg(ap, const char*);
+            if (!value)
+                value = "(null)";
+            stored = event_put(slot, &len, value, strlen(value) + 1);
+            break;
+        }
+        case EVENT_ARG_POINTER:
+        {
+            void* value = va_arg(ap, void*);
+            stored = event_put(slot, &len, &value, sizeof(value));
+            break;
+        }
+        default:
+            return false;
+        }
+        if (!stored)
+            return false;
+    }
+    return true;
+}
+
+// Claims the next free slot, or returns NULL and counts a drop when the ring is full.
+static event_slot_t* event_claim(uint32_t* pos_out)
+{
+    uint32_t pos = __atomic_load_n(&event_head, __ATOMIC_RELAXED);
+    while (1)
+    {
+        event_slot_t* slot = &event_ring[pos % EVENT_RING_SIZE];
+        uint32_t free_seq = pos / EVENT_RING_SIZE * 2;
+        uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq == free_seq)
+        {
+            if (__atomic_compare_exchange_n(&event_head, &pos, pos + 1, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                *pos_out = pos;
+                return slot;
+            }
+            // pos now holds the head another producer moved to
+        }
+        else if ((int32_t)(seq - free_seq) < 0)
+        {
+            __atomic_fetch_add(&event_diagnostics.dropped, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        else
+        {
+            pos = __atomic_load_n(&event_head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void event_publish(event_slot_t* slot, uint32_t pos)
+{
+    __atomic_store_n(&slot->seq, pos / EVENT_RING_SIZE * 2 + 1, __ATOMIC_RELEASE);
+
+    uint32_t depth = pos + 1 - __atomic_load_n(&event_tail, __ATOMIC_RELAXED);
+    if (depth > event_diagnostics.high_water)
+        event_diagnostics.high_water = depth;
+    __atomic_fetch_add(&event_diagnostics.queued, 1, __ATOMIC_RELAXED);
+
+    if (event_task_handle)
+        xTaskNotifyGive(event_task_handle);
+}
 
 void push_event(enum event_level level, char *msg_str)
 {
+    int64_t uptime_us = esp_timer_get_time();
+    uint32_t pos;
+    event_slot_t* slot = event_claim(&pos);
+    if (!slot)
+        return;
+
+    slot->level = level;
+    slot->uptime_us = uptime_us;
+    slot->format = NULL;
+    snprintf((char*)slot->args, sizeof(slot->args), "%s", msg_str);
+    event_publish(slot, pos);
+}
+
+// Arguments that do not fit the slot, or conversions the capture does not handle, are
+// formatted here instead, truncated to the slot.
+void push_eventf(enum event_level level, char *format, ...)
+{
+    int64_t uptime_us = esp_timer_get_time();
+    uint32_t pos;
+    event_slot_t* slot = event_claim(&pos);
+    if (!slot)
+        return;
+
+    slot->level = level;
+    slot->uptime_us = uptime_us;
+    slot->format = format;
+
+    va_list ap;
+    va_start(ap, format);
+    bool captured = event_capture_args(slot, format, ap);
+    va_end(ap);
+
+    if (!captured)
+    {
+        va_start(ap, format);
+        vsnprintf((char*)slot->args, sizeof(slot->args), format, ap);
+        va_end(ap);
+        slot->format = NULL;
+        __atomic_fetch_add(&event_diagnostics.text_fallbacks, 1, __ATOMIC_RELAXED);
+    }
+    event_publish(slot, pos);
+}
+
+// Replays the captured arguments one conversion at a time.
+static void event_format(const event_slot_t* slot, char* out, size_t size)
+{
+    if (!slot->format)
+    {
+        snprintf(out, size, "%s", (const char*)slot->args);
+        return;
+    }
+
+    size_t pos = 0;
+    size_t arg = 0;
+    const char* p = slot->format;
+    while (*p && pos < size - 1)
+    {
+        const char* spec = strchr(p, '%');
+        if (!spec)
+        {
+            pos += snprintf(out + pos, size - pos, "%s", p);
+            break;
+        }
+        size_t literal = spec - p;
+        if (literal > size - 1 - pos)
+            literal = size - 1 - pos;
+        memcpy(out + pos, p, literal);
+        pos += literal;
+
+        enum event_arg_type type;
+        p = event_next_spec(spec, &type);
+
+        char conversion[16];
+        size_t conversion_len = p - spec;
+        if (conversion_len >= sizeof(conversion))
+            break;
+        memcpy(conversion, spec, conversion_len);
+        conversion[conversion_len] = '\0';
+
+        size_t remaining = size - pos;
+        const uint8_t* value = slot->args + arg;
+        int written = 0;
+        switch (type)
+        {
+        case EVENT_ARG_NONE:
+            written = snprintf(out + pos, remaining, "%%");
+            break;
+        case EVENT_ARG_INT:
+        {
+            int v;
+            memcpy(&v, value, sizeof(v));
+            arg += sizeof(v);
+            written = snprintf(out + pos, remaining, conversion, v);
+            break;
+        }
+        case EVENT_ARG_LONG:
+        {
+            long v;
+            memcpy(&v, value, sizeof(v));
+            arg += sizeof(v);
+            written = snprintf(out + pos, remaining, conversion, v);
+            break;
+        }
+        case EVENT_ARG_LLONG:
+        {
+            long long v;
+            memcpy(&v, value, sizeof(v));
+            arg += sizeof(v);
+            written = snprintf(out + pos, remaining, conversion, v);
+            break;
+        }
+        case EVENT_ARG_SIZE:
+        {
+            size_t v;
+            memcpy(&v, value, sizeof(v));
+            arg += sizeof(v);
+            written = snprintf(out + pos, remaining, conversion, v);
+            break;
+        }
+        case EVENT_ARG_DOUBLE:
+        {
+            double v;
+            memcpy(&v, value, sizeof(v));
+            arg += sizeof(v);
+            written = snprintf(out + pos, remaining, conversion, v);
+            break;
+        }
+        case EVENT_ARG_STRING:
+            arg += strlen((const char*)value) + 1;
+            written = snprintf(out + pos, remaining, conversion, (const char*)value);
+            break;
+        case EVENT_ARG_POINTER:
+        {
+            void* v;
+            memcpy(&v, value, sizeof(v));
+            arg += sizeof(v);
+            written = snprintf(out + pos, remaining, conversion, v);
+            break;
+        }
+        default:
+            break;
+        }
+        if (written < 0)
+            break;
+        pos += (size_t)written < remaining ? (size_t)written : remaining - 1;
+    }
+    out[pos < size ? pos : size - 1] = '\0';
+}
+
+static void event_send(const event_slot_t* slot, int64_t wall_offset_us)
+{
+    char text[EVENT_MESSAGE_MAX];
+    event_format(slot, text, sizeof(text));
+
     StatusMessage message = StatusMessage_init_zero;
     message.which_payload = StatusMessage_event_data_tag;
     EventData* event_data = &message.payload.event_data;
 
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    uint64_t timestamp_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-    uint64_t uptime_ms = (uint64_t)esp_timer_get_time() / 1000;
-
-    event_data->level = level;
-    event_data->timestamp_ms = timestamp_ms;
-    event_data->uptime_ms = uptime_ms;
+    event_data->level = slot->level;
+    event_data->timestamp_ms = (uint64_t)(slot->uptime_us + wall_offset_us) / 1000;
+    event_data->uptime_ms = (uint64_t)slot->uptime_us / 1000;
+    event_data->seq = journal_append(slot->level, event_data->timestamp_ms, event_data->uptime_ms, text);
     event_data->message.funcs.encode = &encode_string;
-    event_data->message.arg = msg_str;
+    event_data->message.arg = text;
 
     send_pb_message(StatusMessage_fields, &message);
 }
 
-void push_eventf(enum event_level level, char *format, ...)
+static void event_task(void* pvParameters)
 {
-    char buf[255];
+    // Mounting scans the whole partition, so it happens here rather than during startup.
+    journal_init();
 
-    va_list ap;
-    va_start(ap, format);
-    vsnprintf(buf, sizeof(buf), format, ap);
-    va_end(ap);
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (1)
+        {
+            event_slot_t* slot = &event_ring[event_tail % EVENT_RING_SIZE];
+            uint32_t lap = event_tail / EVENT_RING_SIZE;
+            // Empty, or claimed by a producer that has not published yet and will notify.
+            if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != lap * 2 + 1)
+                break;
 
-    push_event(level, buf);
-}
\ No newline at end of file
+            // Stamped with uptime by the producer; mapped to the wall clock as of now.
+            struct timeval tv;
+            gettimeofday(&tv, NULL);
+            int64_t wall_offset_us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec - esp_timer_get_time();
+            event_send(slot, wall_offset_us);
+
+            __atomic_store_n(&slot->seq, (lap + 1) * 2, __ATOMIC_RELEASE);
+            __atomic_store_n(&event_tail, event_tail + 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void event_init(void)
+{
+    // Below every producer with a deadline: alert tasks, acquisition, httpd and the senders.
+    xTaskCreate(event_task, "event_task", 1024 * 4, NULL, 5, &event_task_handle);
+    // Catch up on events pushed before the task existed.
+    xTaskNotifyGive(event_task_handle);
+}
+
+void event_get_diagnostics(event_diagnostics_t* diagnostics)
+{
+    if (!diagnostics)
+        return;
+
+    diagnostics->queued = __atomic_load_n(&event_diagnostics.queued, __ATOMIC_RELAXED);
+    diagnostics->dropped = __atomic_load_n(&event_diagnostics.dropped, __ATOMIC_RELAXED);
+    diagnostics->text_fallbacks = __atomic_load_n(&event_diagnostics.text_fallbacks, __ATOMIC_RELAXED);
+    diagnostics->high_water = event_diagnostics.high_water;
+}
@@ -5,8 +5,14 @@
 #ifndef ODROID_POWER_MATE_EVENT_H
 #define ODROID_POWER_MATE_EVENT_H
 
+#include <stdint.h>
+
 #include "pbmsg.h"
 
+#define EVENT_RING_SIZE 32 // power of two
+#define EVENT_ARG_BYTES 96 // captured arguments, or the text of a plain or fallback event
+#define EVENT_MESSAGE_MAX 255
+
 enum event_level
 {
     EV_INFO = 0,
@@ -15,9 +21,18 @@ enum event_level
     EV_FATAL = 3,
 };
 
+typedef struct
+{
+    uint32_t queued;
+    uint32_t dropped; // ring full
+    uint32_t text_fallbacks; // formatted by the producer, see push_eventf()
+    uint32_t high_water;
+} event_diagnostics_t;
 
+void event_init(void);
 void push_event(enum event_level level, char *msg_str);
 void push_eventf(enum event_level level, char *format, ...) __attribute__((format(printf, 2, 3)));
+void event_get_diagnostics(event_diagnostics_t* diagnostics);
 
 
 #endif // ODROID_POWER_MATE_EVENT_H
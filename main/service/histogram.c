@@ -0,0 +1,286 @@
+#include "histogram.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "webserver.h"
+
+static const char* TAG = "histogram";
+
+static const char* const channel_names[SENSOR_CHANNEL_COUNT] = {"usb", "main", "vin"};
+
+typedef struct
+{
+    uint64_t time_us[SENSOR_CHANNEL_COUNT][HISTOGRAM_BUCKETS]; // time spent in each bucket
+    int16_t max_raw[SENSOR_CHANNEL_COUNT];
+    uint64_t total_us;
+    int64_t since_us;
+} histogram_t;
+
+static histogram_t histogram;
+static portMUX_TYPE histogram_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static int bucket_index(uint32_t value)
+{
+    if (value < HISTOGRAM_SUB_BUCKETS)
+        return value;
+
+    int shift = 31 - __builtin_clz(value) - HISTOGRAM_SUB_BUCKET_BITS;
+    return HISTOGRAM_SUB_BUCKETS * (shift + 1) + (value >> shift) - HISTOGRAM_SUB_BUCKETS;
+}
+
+static uint32_t bucket_lower(int index)
+{
+    if (index < HISTOGRAM_SUB_BUCKETS)
+        return index;
+
+    int shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+    return (uint32_t)(index % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS) << shift;
+}
+
+static uint32_t bucket_width(int index)
+{
+    return index < HISTOGRAM_SUB_BUCKETS ? 1 : 1u << (index / HISTOGRAM_SUB_BUCKETS - 1);
+}
+
+// Called by the acquisition task for every conversion with the time since the previous
+// one. Buckets are weighted by that time, not by conversions, because the conversion rate
+// changes with the timing, channel and sag settings and during bursts. Reverse current
+// counts as 0.
+void histogram_add(const sensor_data_t* sample, uint32_t dt_us)
+{
+    uint8_t enabled = sensor_get_channel_mask();
+
+    portENTER_CRITICAL(&histogram_lock);
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        if (!(enabled & BIT(i)))
+            continue;
+        int16_t raw = sample->shunt_raw[i] > 0 ? sample->shunt_raw[i] : 0;
+        histogram.time_us[i][bucket_index(raw)] += dt_us;
+        if (raw > histogram.max_raw[i])
+            histogram.max_raw[i] = raw;
+    }
+    histogram.total_us += dt_us;
+    portEXIT_CRITICAL(&histogram_lock);
+}
+
+void histogram_reset(void)
+{
+    int64_t now_us = esp_timer_get_time();
+
+    portENTER_CRITICAL(&histogram_lock);
+    memset(&histogram, 0, sizeof(histogram));
+    histogram.since_us = now_us;
+    portEXIT_CRITICAL(&histogram_lock);
+}
+
+static void snapshot(histogram_t* out)
+{
+    portENTER_CRITICAL(&histogram_lock);
+    *out = histogram;
+    portEXIT_CRITICAL(&histogram_lock);
+}
+
+static float raw_to_a(int channel, float raw)
+{
+    return raw * 0.005f / (float)sensor_shunt_mohm(channel);
+}
+
+// Middle of the bucket holding the q-quantile of time, in raw units.
+static float percentile(const uint64_t* time_us, uint64_t total_us, double q)
+{
+    uint64_t target = (uint64_t)(q * total_us);
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += time_us[i];
+        if (seen > target)
+            return bucket_lower(i) + (bucket_width(i) - 1) / 2.0f;
+    }
+    return 0;
+}
+
+static esp_err_t send_json(httpd_req_t* req, const histogram_t* h)
+{
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddNumberToObject(root, "since_uptime_ms", (double)(h->since_us / 1000));
+    cJSON_AddNumberToObject(root, "total_ms", (double)(h->total_us / 1000));
+    cJSON_AddNumberToObject(root, "sub_bucket_bits", HISTOGRAM_SUB_BUCKET_BITS);
+
+    cJSON* channels = cJSON_AddObjectToObject(root, "channels");
+    for (int c = 0; channels && c < SENSOR_CHANNEL_COUNT; c++)
+    {
+        uint64_t total_us = 0;
+        for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+            total_us += h->time_us[c][i];
+
+        cJSON* channel = cJSON_AddObjectToObject(channels, channel_names[c]);
+        if (!channel)
+            break;
+        cJSON_AddNumberToObject(channel, "time_ms", total_us / 1000.0);
+        cJSON_AddNumberToObject(channel, "max_a", raw_to_a(c, h->max_raw[c]));
+        cJSON_AddNumberToObject(channel, "p50_a", raw_to_a(c, percentile(h->time_us[c], total_us, 0.5)));
+        cJSON_AddNumberToObject(channel, "p90_a", raw_to_a(c, percentile(h->time_us[c], total_us, 0.9)));
+        cJSON_AddNumberToObject(channel, "p99_a", raw_to_a(c, percentile(h->time_us[c], total_us, 0.99)));
+        cJSON_AddNumberToObject(channel, "p999_a", raw_to_a(c, percentile(h->time_us[c], total_us, 0.999)));
+
+        // Non-empty buckets only, as [lower bound in A, time in ms]
+        cJSON* buckets = cJSON_AddArrayToObject(channel, "buckets");
+        for (int i = 0; buckets && i < HISTOGRAM_BUCKETS; i++)
+        {
+            if (!h->time_us[c][i])
+                continue;
+            cJSON* bucket = cJSON_CreateArray();
+            if (!bucket)
+                break;
+            cJSON_AddItemToArray(bucket, cJSON_CreateNumber(raw_to_a(c, bucket_lower(i))));
+            cJSON_AddItemToArray(bucket, cJSON_CreateNumber(h->time_us[c][i] / 1000.0));
+            cJSON_AddItemToArray(buckets, bucket);
+        }
+    }
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    esp_err_t err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+static esp_err_t send_binary(httpd_req_t* req, const histogram_t* h)
+{
+    histogram_header_t header = {
+        .magic = HISTOGRAM_MAGIC,
+        .version = HISTOGRAM_VERSION,
+        .channel_count = SENSOR_CHANNEL_COUNT,
+        .bucket_count = HISTOGRAM_BUCKETS,
+        .sub_bucket_bits = HISTOGRAM_SUB_BUCKET_BITS,
+        .total_us = h->total_us,
+        .since_uptime_ms = h->since_us / 1000,
+    };
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        header.shunt_mohm[i] = sensor_shunt_mohm(i);
+
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    esp_err_t err = httpd_resp_send_chunk(req, (const char*)&header, sizeof(header));
+    if (err != ESP_OK)
+        return err;
+
+    err = httpd_resp_send_chunk(req, (const char*)h->time_us, sizeof(h->time_us));
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Histogram transfer aborted: %s", esp_err_to_name(err));
+        return err;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+static esp_err_t histogram_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    bool binary = false;
+    char query[32];
+    char format[8];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "format", format, sizeof(format)) == ESP_OK)
+    {
+        binary = strcmp(format, "binary") == 0;
+        if (!binary && strcmp(format, "json") != 0)
+        {
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "format must be json or binary");
+            return ESP_FAIL;
+        }
+    }
+
+    // Too large for the httpd stack
+    histogram_t* h = malloc(sizeof(histogram_t));
+    if (!h)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+    snapshot(h);
+
+    err = binary ? send_binary(req, h) : send_json(req, h);
+    free(h);
+    return err;
+}
+
+static esp_err_t histogram_post_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    char buf[64];
+    int ret, remaining = req->content_len;
+
+    if (remaining >= sizeof(buf))
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Request content too long");
+        return ESP_FAIL;
+    }
+
+    ret = httpd_req_recv(req, buf, remaining);
+    if (ret <= 0)
+    {
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(req);
+        return ESP_FAIL;
+    }
+    buf[ret] = '\0';
+
+    cJSON* root = cJSON_Parse(buf);
+    if (root == NULL)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON format");
+        return ESP_FAIL;
+    }
+
+    bool reset = cJSON_IsTrue(cJSON_GetObjectItem(root, "reset"));
+    cJSON_Delete(root);
+
+    if (!reset)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Nothing to do");
+        return ESP_FAIL;
+    }
+
+    histogram_reset();
+    ESP_LOGI(TAG, "Histograms reset");
+    httpd_resp_sendstr(req, "{\"status\":\"ok\"}");
+    return ESP_OK;
+}
+
+void register_histogram_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {
+        .uri = "/api/histogram", .method = HTTP_GET, .handler = histogram_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+
+    httpd_uri_t post_uri = {
+        .uri = "/api/histogram", .method = HTTP_POST, .handler = histogram_post_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &post_uri);
+}
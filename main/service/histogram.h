@@ -0,0 +1,36 @@
+#ifndef ODROID_POWER_MATE_HISTOGRAM_H
+#define ODROID_POWER_MATE_HISTOGRAM_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "monitor.h"
+
+// Log-linear buckets over |shunt_raw|: values below 2^HISTOGRAM_SUB_BUCKET_BITS get one
+// bucket each, every power of two above is split into 2^HISTOGRAM_SUB_BUCKET_BITS
+// buckets, so a bucket is never wider than 1/16 of its lower bound.
+#define HISTOGRAM_SUB_BUCKET_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_BUCKETS (HISTOGRAM_SUB_BUCKETS + (15 - HISTOGRAM_SUB_BUCKET_BITS) * HISTOGRAM_SUB_BUCKETS)
+#define HISTOGRAM_MAGIC 0x31474d50 // "PMG1"
+#define HISTOGRAM_VERSION 2
+
+// Little-endian header sent ahead of uint64_t time_us[channel_count][bucket_count] by
+// /api/histogram?format=binary.
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t channel_count;
+    uint16_t bucket_count;
+    uint8_t sub_bucket_bits;
+    uint8_t reserved;
+    uint16_t shunt_mohm[SENSOR_CHANNEL_COUNT];
+    uint64_t total_us; // time covered by the buckets
+    uint64_t since_uptime_ms; // last reset
+} histogram_header_t;
+
+void histogram_add(const sensor_data_t* sample, uint32_t dt_us);
+void histogram_reset(void);
+
+#endif // ODROID_POWER_MATE_HISTOGRAM_H
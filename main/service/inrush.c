@@ -0,0 +1,363 @@
+#include "inrush.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "event.h"
+#include "freertos/FreeRTOS.h"
+#include "webserver.h"
+
+#define INRUSH_CHUNK_RECORDS 32
+
+static const char* TAG = "inrush";
+
+static const char* const channel_names[SENSOR_CHANNEL_COUNT] = {"usb", "main", "vin"};
+static const char* const channel_labels[SENSOR_CHANNEL_COUNT] = {"USB", "MAIN", "VIN"};
+static const char* const state_names[] = {"none", "recording", "ready"};
+static const char* const source_names[] = {"none", "switch_on", "power_button", "reset_button"};
+
+enum inrush_state
+{
+    INRUSH_NONE = 0,
+    INRUSH_RECORDING = 1,
+    INRUSH_READY = 2,
+};
+
+typedef struct
+{
+    float baseline_a;
+    float peak_a;
+    float peak_at_ms;
+    float settle_ms; // negative when the current had not settled by the end of the burst
+    float final_a;
+    float energy_mj;
+} inrush_summary_t;
+
+static inrush_record_t records[INRUSH_MAX_SAMPLES];
+static uint16_t record_count;
+static enum inrush_state state = INRUSH_NONE;
+static enum inrush_source pending_source = INRUSH_SOURCE_NONE;
+static enum inrush_source source = INRUSH_SOURCE_NONE;
+static uint8_t channels;
+static int64_t begin_us;
+static int64_t edge_us;
+static uint32_t edge_uptime_ms;
+static uint64_t edge_timestamp_ms;
+static uint32_t generation; // bumped on every burst so a download can detect it
+static inrush_summary_t summary[SENSOR_CHANNEL_COUNT];
+static portMUX_TYPE inrush_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Runs edge_fn in the middle of a maximum-rate burst that records channel_mask and returns
+// its result.
+esp_err_t inrush_run(enum inrush_source burst_source, uint8_t channel_mask, sensor_burst_edge_fn edge_fn, void* arg)
+{
+    portENTER_CRITICAL(&inrush_lock);
+    pending_source = burst_source;
+    portEXIT_CRITICAL(&inrush_lock);
+
+    return sensor_burst(channel_mask, edge_fn, arg);
+}
+
+void inrush_begin(uint8_t channel_mask)
+{
+    portENTER_CRITICAL(&inrush_lock);
+    state = INRUSH_RECORDING;
+    source = pending_source;
+    channels = channel_mask;
+    record_count = 0;
+    begin_us = 0;
+    edge_us = 0;
+    generation++;
+    portEXIT_CRITICAL(&inrush_lock);
+}
+
+// Offsets are kept relative to the first sample until the edge is known. Returns false
+// once the buffer is full.
+bool inrush_add(const sensor_data_t* sample, int64_t conversion_us)
+{
+    if (record_count >= INRUSH_MAX_SAMPLES)
+        return false;
+
+    if (record_count == 0)
+        begin_us = conversion_us;
+
+    inrush_record_t* record = &records[record_count++];
+    record->offset_us = (int32_t)(conversion_us - begin_us);
+    // The burst also converts channels that were not requested; those read 0.
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        record->bus_raw[i] = (channels & BIT(i)) ? sample->bus_raw[i] : 0;
+        record->shunt_raw[i] = (channels & BIT(i)) ? sample->shunt_raw[i] : 0;
+    }
+    return record_count < INRUSH_MAX_SAMPLES;
+}
+
+void inrush_edge(int64_t time_us)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+
+    edge_us = time_us;
+    edge_uptime_ms = (uint32_t)(time_us / 1000);
+    edge_timestamp_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
+}
+
+static float raw_to_a(int channel, float raw)
+{
+    return raw * 0.005f / (float)sensor_shunt_mohm(channel);
+}
+
+// Peak, settling time and energy of one channel over the records after the edge. The
+// current counts as settled once it stays within 10% of its final value (or 2% of the
+// peak for small final currents); the final value is the mean of the last tenth.
+static void summarize_channel(int channel, uint16_t first_post, inrush_summary_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    out->settle_ms = -1;
+
+    int64_t baseline_sum = 0;
+    for (uint16_t i = 0; i < first_post; i++)
+        baseline_sum += records[i].shunt_raw[channel];
+    if (first_post)
+        out->baseline_a = raw_to_a(channel, (float)baseline_sum / first_post);
+
+    uint16_t post = record_count - first_post;
+    if (post == 0)
+        return;
+
+    int16_t peak = INT16_MIN;
+    int32_t peak_at_us = 0;
+    int64_t energy_raw = 0; // bus_raw * shunt_raw * us
+    for (uint16_t i = first_post; i < record_count; i++)
+    {
+        const inrush_record_t* r = &records[i];
+        if (r->shunt_raw[channel] > peak)
+        {
+            peak = r->shunt_raw[channel];
+            peak_at_us = r->offset_us;
+        }
+        if (i + 1 < record_count)
+            energy_raw += (int64_t)r->bus_raw[channel] * r->shunt_raw[channel] * (records[i + 1].offset_us - r->offset_us);
+    }
+
+    uint16_t tail = post / 10 ? post / 10 : 1;
+    int64_t final_sum = 0;
+    for (uint16_t i = record_count - tail; i < record_count; i++)
+        final_sum += records[i].shunt_raw[channel];
+    int32_t final_raw = (int32_t)(final_sum / tail);
+
+    int32_t band = abs(final_raw) / 10;
+    if (band < abs(peak) / 50)
+        band = abs(peak) / 50;
+    if (band < 1)
+        band = 1;
+
+    int32_t last_out = -1;
+    for (uint16_t i = first_post; i < record_count; i++)
+    {
+        if (abs(records[i].shunt_raw[channel] - final_raw) > band)
+            last_out = i;
+    }
+    if (last_out < 0)
+        out->settle_ms = 0;
+    else if (last_out + 1 < record_count)
+        out->settle_ms = records[last_out + 1].offset_us / 1000.0f;
+
+    out->peak_a = raw_to_a(channel, peak);
+    out->peak_at_ms = peak_at_us / 1000.0f;
+    out->final_a = raw_to_a(channel, final_raw);
+    // mV * 5 uV / mOhm = uW, so raw * us * 5 / mOhm is pJ
+    out->energy_mj = (float)((double)energy_raw * 5 / sensor_shunt_mohm(channel) / 1e9);
+}
+
+void inrush_finish(void)
+{
+    // Rebase the offsets on the edge; without an edge the first sample stays at 0.
+    int32_t shift = edge_us ? (int32_t)(edge_us - begin_us) : 0;
+    uint16_t first_post = record_count;
+    for (uint16_t i = 0; i < record_count; i++)
+    {
+        records[i].offset_us -= shift;
+        if (records[i].offset_us >= 0 && first_post == record_count)
+            first_post = i;
+    }
+
+    inrush_summary_t computed[SENSOR_CHANNEL_COUNT] = {0};
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        if (channels & BIT(i))
+            summarize_channel(i, first_post, &computed[i]);
+    }
+
+    portENTER_CRITICAL(&inrush_lock);
+    memcpy(summary, computed, sizeof(summary));
+    state = INRUSH_READY;
+    portEXIT_CRITICAL(&inrush_lock);
+
+    uint32_t span_us = record_count > 1 ? records[record_count - 1].offset_us - records[0].offset_us : 0;
+    ESP_LOGI(TAG, "Inrush burst: source=%s samples=%u span=%" PRIu32 "us", source_names[source], record_count,
+             span_us);
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        if (!(channels & BIT(i)))
+            continue;
+        const inrush_summary_t* s = &computed[i];
+        if (s->settle_ms >= 0)
+            push_eventf(EV_INFO, "inrush %s (%s): peak %.3fA at %.2fms, settled in %.1fms, %.3fmJ, %u samples",
+                        channel_labels[i], source_names[source], s->peak_a, s->peak_at_ms, s->settle_ms,
+                        s->energy_mj, record_count);
+        else
+            push_eventf(EV_INFO, "inrush %s (%s): peak %.3fA at %.2fms, not settled within %dms, %.3fmJ, %u samples",
+                        channel_labels[i], source_names[source], s->peak_a, s->peak_at_ms, INRUSH_WINDOW_MS,
+                        s->energy_mj, record_count);
+    }
+}
+
+static esp_err_t inrush_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    portENTER_CRITICAL(&inrush_lock);
+    enum inrush_state s = state;
+    enum inrush_source src = source;
+    uint8_t mask = channels;
+    uint16_t count = s == INRUSH_READY ? record_count : 0;
+    uint32_t uptime_ms = edge_uptime_ms;
+    uint64_t timestamp_ms = edge_timestamp_ms;
+    inrush_summary_t copy[SENSOR_CHANNEL_COUNT];
+    memcpy(copy, summary, sizeof(copy));
+    int32_t span_us = count > 1 ? records[count - 1].offset_us - records[0].offset_us : 0;
+    portEXIT_CRITICAL(&inrush_lock);
+
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddStringToObject(root, "state", state_names[s]);
+    cJSON_AddStringToObject(root, "source", source_names[src]);
+    cJSON_AddNumberToObject(root, "samples", count);
+    cJSON_AddNumberToObject(root, "capacity", INRUSH_MAX_SAMPLES);
+    cJSON_AddNumberToObject(root, "window_ms", INRUSH_WINDOW_MS);
+    cJSON_AddNumberToObject(root, "sample_rate_hz", span_us > 0 ? (count - 1) * 1e6 / span_us : 0);
+    cJSON_AddNumberToObject(root, "edge_uptime_ms", uptime_ms);
+    cJSON_AddNumberToObject(root, "edge_timestamp_ms", timestamp_ms);
+
+    cJSON* channel_root = cJSON_AddObjectToObject(root, "channels");
+    for (int i = 0; channel_root && s == INRUSH_READY && i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        if (!(mask & BIT(i)))
+            continue;
+        cJSON* item = cJSON_AddObjectToObject(channel_root, channel_names[i]);
+        if (!item)
+            break;
+        cJSON_AddNumberToObject(item, "baseline_a", copy[i].baseline_a);
+        cJSON_AddNumberToObject(item, "peak_a", copy[i].peak_a);
+        cJSON_AddNumberToObject(item, "peak_at_ms", copy[i].peak_at_ms);
+        if (copy[i].settle_ms >= 0)
+            cJSON_AddNumberToObject(item, "settle_ms", copy[i].settle_ms);
+        else
+            cJSON_AddNullToObject(item, "settle_ms");
+        cJSON_AddNumberToObject(item, "final_a", copy[i].final_a);
+        cJSON_AddNumberToObject(item, "energy_mj", copy[i].energy_mj);
+    }
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+// Streams the last burst: an inrush_header_t followed by the records in time order.
+static esp_err_t inrush_data_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    inrush_header_t header = {
+        .magic = INRUSH_MAGIC,
+        .version = INRUSH_VERSION,
+        .record_size = sizeof(inrush_record_t),
+        .channel_count = SENSOR_CHANNEL_COUNT,
+    };
+    for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        header.shunt_mohm[i] = sensor_shunt_mohm(i);
+
+    portENTER_CRITICAL(&inrush_lock);
+    bool ready = state == INRUSH_READY;
+    uint32_t gen = generation;
+    header.source = source;
+    header.channels = channels;
+    header.count = record_count;
+    header.edge_uptime_ms = edge_uptime_ms;
+    header.edge_timestamp_ms = edge_timestamp_ms;
+    portEXIT_CRITICAL(&inrush_lock);
+
+    if (!ready)
+    {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "No inrush recorded");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"inrush.bin\"");
+    err = httpd_resp_send_chunk(req, (const char*)&header, sizeof(header));
+    if (err != ESP_OK)
+        return err;
+
+    inrush_record_t chunk[INRUSH_CHUNK_RECORDS];
+    uint16_t index = 0;
+    while (index < header.count)
+    {
+        size_t count = 0;
+        portENTER_CRITICAL(&inrush_lock);
+        bool replaced = generation != gen;
+        while (!replaced && count < INRUSH_CHUNK_RECORDS && index < header.count)
+            chunk[count++] = records[index++];
+        portEXIT_CRITICAL(&inrush_lock);
+
+        if (replaced)
+        {
+            ESP_LOGW(TAG, "New inrush burst during download");
+            return ESP_FAIL;
+        }
+
+        err = httpd_resp_send_chunk(req, (const char*)chunk, count * sizeof(inrush_record_t));
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Inrush transfer aborted: %s", esp_err_to_name(err));
+            return err;
+        }
+    }
+
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+void register_inrush_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {.uri = "/api/inrush", .method = HTTP_GET, .handler = inrush_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+
+    httpd_uri_t data_uri = {
+        .uri = "/api/inrush/data", .method = HTTP_GET, .handler = inrush_data_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &data_uri);
+}
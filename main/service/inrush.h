@@ -0,0 +1,54 @@
+#ifndef ODROID_POWER_MATE_INRUSH_H
+#define ODROID_POWER_MATE_INRUSH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "monitor.h"
+
+#define INRUSH_MAX_SAMPLES 512
+#define INRUSH_WINDOW_MS 150 // recorded after the edge, unless the buffer fills first
+#define INRUSH_MAGIC 0x31494d50 // "PMI1"
+#define INRUSH_VERSION 1
+
+enum inrush_source
+{
+    INRUSH_SOURCE_NONE = 0,
+    INRUSH_SOURCE_SWITCH_ON = 1,    // MAIN and/or USB load switch turned on
+    INRUSH_SOURCE_POWER_BUTTON = 2, // trig_power
+    INRUSH_SOURCE_RESET_BUTTON = 3, // trig_reset
+};
+
+// One burst conversion; offset_us is relative to the edge, negative for the baseline.
+typedef struct
+{
+    int32_t offset_us;
+    int16_t bus_raw[SENSOR_CHANNEL_COUNT];
+    int16_t shunt_raw[SENSOR_CHANNEL_COUNT];
+} inrush_record_t;
+
+// Little-endian header sent ahead of the inrush_record_t records by /api/inrush/data.
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint16_t channel_count;
+    uint16_t shunt_mohm[SENSOR_CHANNEL_COUNT];
+    uint8_t source;
+    uint8_t channels; // bit n = channel n was sampled; the others read 0
+    uint16_t count;
+    uint32_t edge_uptime_ms;
+    uint64_t edge_timestamp_ms; // wall clock at the edge
+} inrush_header_t;
+
+esp_err_t inrush_run(enum inrush_source source, uint8_t channel_mask, sensor_burst_edge_fn edge_fn, void* arg);
+
+// Called by the acquisition task while it runs a burst.
+void inrush_begin(uint8_t channel_mask);
+bool inrush_add(const sensor_data_t* sample, int64_t conversion_us);
+void inrush_edge(int64_t edge_us);
+void inrush_finish(void);
+
+#endif // ODROID_POWER_MATE_INRUSH_H
@@ -0,0 +1,393 @@
+#include "journal.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "webserver.h"
+
+static const char* TAG = "journal";
+
+// The partition is a ring of sectors filled one after the other; opening a sector erases
+// the oldest one, so every sector is erased once per lap. Records are only appended.
+// The RAM index keeps the first sequence number and timestamp of every sector, so a
+// query reads only the sectors that hold what it asks for.
+typedef struct
+{
+    uint32_t sector_seq; // 0 if the sector holds no journal data
+    uint32_t first_seq;
+    uint32_t count;
+    uint64_t first_timestamp_ms;
+} journal_index_t;
+
+static const esp_partition_t* journal_partition;
+static volatile bool journal_ready; // set once the index is built
+static SemaphoreHandle_t journal_mutex;
+static journal_index_t* journal_index;
+static uint32_t sector_count;
+static uint32_t head_sector;
+static uint32_t head_offset;
+static uint32_t next_seq = 1;
+
+static uint32_t record_size(uint16_t length)
+{
+    return sizeof(journal_record_header_t) + ((length + 3) & ~3u);
+}
+
+static uint32_t record_crc(const journal_record_header_t* header, const char* message)
+{
+    journal_record_header_t copy = *header;
+    copy.crc = 0;
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)&copy, sizeof(copy));
+    return esp_rom_crc32_le(crc, (const uint8_t*)message, header->length);
+}
+
+// ESP_ERR_NOT_FOUND marks the erased end of a sector, ESP_ERR_INVALID_CRC a torn record.
+static esp_err_t read_record(uint32_t sector, uint32_t offset, journal_record_header_t* header, char* message)
+{
+    if (offset + sizeof(*header) > JOURNAL_SECTOR_SIZE)
+        return ESP_ERR_NOT_FOUND;
+
+    size_t base = sector * JOURNAL_SECTOR_SIZE + offset;
+    esp_err_t err = esp_partition_read(journal_partition, base, header, sizeof(*header));
+    if (err != ESP_OK)
+        return err;
+    if (header->magic == 0xFFFF)
+        return ESP_ERR_NOT_FOUND;
+    if (header->magic != JOURNAL_RECORD_MAGIC || header->length > JOURNAL_MESSAGE_MAX ||
+        offset + record_size(header->length) > JOURNAL_SECTOR_SIZE)
+        return ESP_ERR_INVALID_CRC;
+
+    err = esp_partition_read(journal_partition, base + sizeof(*header), message, header->length);
+    if (err != ESP_OK)
+        return err;
+    message[header->length] = '\0';
+    return record_crc(header, message) == header->crc ? ESP_OK : ESP_ERR_INVALID_CRC;
+}
+
+// Counts the records of a sector and returns where the next one would go.
+static esp_err_t scan_sector(uint32_t sector, uint32_t* end_offset)
+{
+    journal_index_t* index = &journal_index[sector];
+    journal_record_header_t header;
+    char message[JOURNAL_MESSAGE_MAX + 1];
+    uint32_t offset = sizeof(journal_sector_header_t);
+
+    index->count = 0;
+    while (1)
+    {
+        esp_err_t err = read_record(sector, offset, &header, message);
+        if (err != ESP_OK)
+        {
+            *end_offset = offset;
+            return err == ESP_ERR_NOT_FOUND ? ESP_OK : err;
+        }
+        if (index->count == 0)
+            index->first_timestamp_ms = header.timestamp_ms;
+        index->count++;
+        offset += record_size(header.length);
+    }
+}
+
+static esp_err_t open_sector(uint32_t sector, uint32_t sector_seq)
+{
+    esp_err_t err = esp_partition_erase_range(journal_partition, sector * JOURNAL_SECTOR_SIZE, JOURNAL_SECTOR_SIZE);
+    journal_sector_header_t header = {
+        .magic = JOURNAL_SECTOR_MAGIC,
+        .sector_seq = sector_seq,
+        .first_seq = next_seq,
+        .reserved = 0xFFFFFFFF,
+    };
+    if (err == ESP_OK)
+        err = esp_partition_write(journal_partition, sector * JOURNAL_SECTOR_SIZE, &header, sizeof(header));
+    if (err != ESP_OK)
+    {
+        journal_index[sector].sector_seq = 0;
+        return err;
+    }
+
+    journal_index[sector] = (journal_index_t){.sector_seq = sector_seq, .first_seq = next_seq};
+    head_sector = sector;
+    head_offset = sizeof(header);
+    return ESP_OK;
+}
+
+static esp_err_t open_next_sector(void)
+{
+    uint32_t sector_seq = journal_index[head_sector].sector_seq + 1;
+    return open_sector((head_sector + 1) % sector_count, sector_seq);
+}
+
+esp_err_t journal_init(void)
+{
+    journal_partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, JOURNAL_PARTITION_LABEL);
+    if (!journal_partition)
+    {
+        ESP_LOGW(TAG, "No \"%s\" partition, events are not journaled", JOURNAL_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    sector_count = journal_partition->size / JOURNAL_SECTOR_SIZE;
+    journal_index = calloc(sector_count, sizeof(journal_index_t));
+    journal_mutex = xSemaphoreCreateMutex();
+    if (sector_count < 2 || !journal_index || !journal_mutex)
+        return ESP_ERR_NO_MEM;
+
+    bool found = false;
+    for (uint32_t i = 0; i < sector_count; i++)
+    {
+        journal_sector_header_t header;
+        if (esp_partition_read(journal_partition, i * JOURNAL_SECTOR_SIZE, &header, sizeof(header)) != ESP_OK ||
+            header.magic != JOURNAL_SECTOR_MAGIC)
+            continue;
+
+        journal_index[i].sector_seq = header.sector_seq;
+        journal_index[i].first_seq = header.first_seq;
+        if (!found || header.sector_seq > journal_index[head_sector].sector_seq)
+            head_sector = i;
+        found = true;
+    }
+
+    esp_err_t err;
+    if (!found)
+    {
+        err = open_sector(0, 1);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < sector_count; i++)
+        {
+            uint32_t end_offset;
+            if (journal_index[i].sector_seq && i != head_sector)
+                scan_sector(i, &end_offset);
+        }
+
+        // A torn record cannot be written over, so appending resumes in a fresh sector.
+        err = scan_sector(head_sector, &head_offset);
+        next_seq = journal_index[head_sector].first_seq + journal_index[head_sector].count;
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Sector %" PRIu32 " ends with a damaged record", head_sector);
+            err = open_next_sector();
+        }
+    }
+
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to open the journal: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    journal_ready = true;
+
+    ESP_LOGI(TAG, "Journal: %" PRIu32 " sectors, next seq %" PRIu32, sector_count, next_seq);
+    return ESP_OK;
+}
+
+uint32_t journal_append(uint8_t level, uint64_t timestamp_ms, uint64_t uptime_ms, const char* message)
+{
+    if (!journal_ready)
+        return 0;
+
+    struct __attribute__((packed))
+    {
+        journal_record_header_t header;
+        char message[JOURNAL_MESSAGE_MAX + 4];
+    } record;
+
+    size_t length = strnlen(message, JOURNAL_MESSAGE_MAX);
+    memset(record.message, 0xFF, record_size(length) - sizeof(record.header));
+    memcpy(record.message, message, length);
+    record.header = (journal_record_header_t){
+        .magic = JOURNAL_RECORD_MAGIC,
+        .length = length,
+        .timestamp_ms = timestamp_ms,
+        .uptime_ms = uptime_ms,
+        .level = level,
+        .reserved = {0xFF, 0xFF, 0xFF},
+    };
+
+    xSemaphoreTake(journal_mutex, portMAX_DELAY);
+    esp_err_t err = ESP_OK;
+    if (head_offset + record_size(length) > JOURNAL_SECTOR_SIZE)
+        err = open_next_sector();
+
+    uint32_t seq = 0;
+    if (err == ESP_OK)
+    {
+        record.header.seq = next_seq;
+        record.header.crc = record_crc(&record.header, record.message);
+        err = esp_partition_write(journal_partition, head_sector * JOURNAL_SECTOR_SIZE + head_offset, &record,
+                                  record_size(length));
+    }
+    if (err == ESP_OK)
+    {
+        journal_index_t* index = &journal_index[head_sector];
+        if (index->count == 0)
+            index->first_timestamp_ms = timestamp_ms;
+        index->count++;
+        head_offset += record_size(length);
+        seq = next_seq++;
+    }
+    else
+    {
+        // Skip past whatever was partly written; the next append starts a new sector.
+        head_offset = JOURNAL_SECTOR_SIZE;
+    }
+    xSemaphoreGive(journal_mutex);
+
+    if (err != ESP_OK)
+        ESP_LOGW(TAG, "Failed to journal event: %s", esp_err_to_name(err));
+    return seq;
+}
+
+// Sectors from the oldest to the head, in the order they were written.
+static uint32_t sector_at(uint32_t age)
+{
+    return (head_sector + 1 + age) % sector_count;
+}
+
+static uint32_t oldest_seq(void)
+{
+    for (uint32_t age = 0; age < sector_count; age++)
+    {
+        const journal_index_t* index = &journal_index[sector_at(age)];
+        if (index->sector_seq && index->count)
+            return index->first_seq;
+    }
+    return next_seq;
+}
+
+// Appends events newer than since_seq (or not older than since_ms when by_time) to the
+// array; returns true if more are left after limit.
+static bool collect_events(cJSON* events, uint32_t since_seq, uint64_t since_ms, bool by_time, int limit,
+                           uint32_t* last_seq)
+{
+    uint32_t start_age = 0;
+    for (uint32_t age = 0; age < sector_count; age++)
+    {
+        const journal_index_t* index = &journal_index[sector_at(age)];
+        if (!index->sector_seq || !index->count)
+            continue;
+        if (by_time ? index->first_timestamp_ms <= since_ms : index->first_seq <= since_seq + 1)
+            start_age = age;
+    }
+
+    journal_record_header_t header;
+    char message[JOURNAL_MESSAGE_MAX + 1];
+    int added = 0;
+    for (uint32_t age = start_age; age < sector_count; age++)
+    {
+        uint32_t sector = sector_at(age);
+        if (!journal_index[sector].sector_seq)
+            continue;
+
+        uint32_t offset = sizeof(journal_sector_header_t);
+        while (read_record(sector, offset, &header, message) == ESP_OK)
+        {
+            offset += record_size(header.length);
+            if (by_time ? header.timestamp_ms < since_ms : header.seq <= since_seq)
+                continue;
+            if (added == limit)
+                return true;
+
+            cJSON* event = cJSON_CreateObject();
+            if (!event)
+                return true;
+            cJSON_AddNumberToObject(event, "seq", header.seq);
+            cJSON_AddNumberToObject(event, "level", header.level);
+            cJSON_AddNumberToObject(event, "timestamp_ms", (double)header.timestamp_ms);
+            cJSON_AddNumberToObject(event, "uptime_ms", (double)header.uptime_ms);
+            cJSON_AddStringToObject(event, "message", message);
+            cJSON_AddItemToArray(events, event);
+            *last_seq = header.seq;
+            added++;
+        }
+    }
+    return false;
+}
+
+static esp_err_t events_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    if (!journal_ready)
+    {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Event journal unavailable");
+        return ESP_FAIL;
+    }
+
+    uint32_t since_seq = 0;
+    uint64_t since_ms = 0;
+    bool by_time = false;
+    int limit = JOURNAL_PAGE_DEFAULT;
+    char query[96];
+    char value[24];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK)
+    {
+        if (httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK)
+            since_seq = strtoul(value, NULL, 10);
+        if (httpd_query_key_value(query, "since_ms", value, sizeof(value)) == ESP_OK)
+        {
+            since_ms = strtoull(value, NULL, 10);
+            by_time = true;
+        }
+        if (httpd_query_key_value(query, "limit", value, sizeof(value)) == ESP_OK)
+            limit = atoi(value);
+    }
+    if (limit < 1 || limit > JOURNAL_PAGE_MAX)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "limit must be 1..64");
+        return ESP_FAIL;
+    }
+
+    cJSON* root = cJSON_CreateObject();
+    cJSON* events = root ? cJSON_AddArrayToObject(root, "events") : NULL;
+    if (!events)
+    {
+        cJSON_Delete(root);
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint32_t last_seq = since_seq;
+    xSemaphoreTake(journal_mutex, portMAX_DELAY);
+    bool more = collect_events(events, since_seq, since_ms, by_time, limit, &last_seq);
+    cJSON_AddNumberToObject(root, "oldest_seq", oldest_seq());
+    cJSON_AddNumberToObject(root, "latest_seq", next_seq - 1);
+    xSemaphoreGive(journal_mutex);
+
+    // Pass next_since back as since= for the following page.
+    cJSON_AddNumberToObject(root, "next_since", last_seq);
+    cJSON_AddBoolToObject(root, "more", more);
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+void register_journal_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {
+        .uri = "/api/events", .method = HTTP_GET, .handler = events_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+}
@@ -0,0 +1,46 @@
+#ifndef ODROID_POWER_MATE_JOURNAL_H
+#define ODROID_POWER_MATE_JOURNAL_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+#define JOURNAL_PARTITION_LABEL "events"
+#define JOURNAL_SECTOR_SIZE 4096
+#define JOURNAL_SECTOR_MAGIC 0x314a4d50 // "PMJ1"
+#define JOURNAL_RECORD_MAGIC 0x4a45 // "EJ"
+#define JOURNAL_MESSAGE_MAX 255
+#define JOURNAL_PAGE_DEFAULT 32
+#define JOURNAL_PAGE_MAX 64
+
+// Written right after a sector is erased. sector_seq grows by one per sector opened, so
+// the highest one is the sector being appended to and the lowest the oldest.
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint32_t sector_seq;
+    uint32_t first_seq; // event sequence number of the first record in the sector
+    uint32_t reserved;
+} journal_sector_header_t;
+
+// Followed by length message bytes, padded to 4. The CRC covers the header with crc = 0
+// and the message, so a record torn by a power loss is recognized.
+typedef struct __attribute__((packed))
+{
+    uint16_t magic;
+    uint16_t length;
+    uint32_t seq;
+    uint64_t timestamp_ms;
+    uint64_t uptime_ms;
+    uint8_t level;
+    uint8_t reserved[3];
+    uint32_t crc;
+} journal_record_header_t;
+
+esp_err_t journal_init(void);
+// Returns the sequence number given to the event, 0 if it was not stored.
+uint32_t journal_append(uint8_t level, uint64_t timestamp_ms, uint64_t uptime_ms, const char* message);
+void register_journal_endpoint(httpd_handle_t server);
+
+#endif // ODROID_POWER_MATE_JOURNAL_H
@@ -0,0 +1,311 @@
+#include "latency.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_cpu.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "webserver.h"
+
+static const char* TAG = "latency";
+
+static const char* const stage_names[LATENCY_STAGE_COUNT] = {
+    "isr", "cutoff", "task_wake", "status", "switch_config", "persist", "notify",
+};
+
+// Alert in progress. The ISR only runs while the shutdown task is not, so it writes
+// without a lock; the task masks interrupts for its few accesses.
+static volatile uint32_t open_cycles[LATENCY_STAGE_COUNT];
+static volatile bool latency_open;
+static volatile bool isr_coalesced; // ISR entered while an alert was already open
+static volatile uint32_t coalesced_count;
+static portMUX_TYPE open_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Log and histograms are written by the shutdown task only. Readers copy them under a
+// sequence count and retry if it moved, so the writer never waits.
+typedef struct
+{
+    uint32_t alerts;
+    uint32_t sla_violations;
+    latency_record_t log[LATENCY_LOG_SIZE];
+    latency_histogram_t stages[LATENCY_STAGE_COUNT];
+} latency_state_t;
+
+static latency_state_t latency;
+static volatile uint32_t latency_seq; // odd while the writer is updating
+
+static inline uint32_t IRAM_ATTR stamp_now(void)
+{
+    uint32_t cycles = esp_cpu_get_cycle_count();
+    return cycles ? cycles : 1; // 0 means "not reached"
+}
+
+void IRAM_ATTR latency_stamp_isr(enum latency_stage stage)
+{
+    if (stage == LATENCY_ISR)
+    {
+        isr_coalesced = latency_open;
+        if (isr_coalesced)
+        {
+            coalesced_count++;
+            return;
+        }
+        for (int i = 0; i < LATENCY_STAGE_COUNT; i++)
+            open_cycles[i] = 0;
+        latency_open = true;
+    }
+    else if (!latency_open || isr_coalesced)
+    {
+        return;
+    }
+    open_cycles[stage] = stamp_now();
+}
+
+void latency_stamp(enum latency_stage stage)
+{
+    uint32_t now = stamp_now();
+
+    portENTER_CRITICAL(&open_lock);
+    if (!latency_open)
+    {
+        for (int i = 0; i < LATENCY_STAGE_COUNT; i++)
+            open_cycles[i] = 0;
+        latency_open = true;
+        isr_coalesced = false;
+    }
+    if (!open_cycles[stage])
+        open_cycles[stage] = now;
+    portEXIT_CRITICAL(&open_lock);
+}
+
+static int bucket_index(uint32_t us)
+{
+    int bucket = us ? 32 - __builtin_clz(us) : 0;
+    return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+void latency_commit(void)
+{
+    uint32_t cycles[LATENCY_STAGE_COUNT];
+    portENTER_CRITICAL(&open_lock);
+    if (!latency_open)
+    {
+        portEXIT_CRITICAL(&open_lock);
+        return;
+    }
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++)
+        cycles[i] = open_cycles[i];
+    latency_open = false;
+    portEXIT_CRITICAL(&open_lock);
+
+    // Alerts forwarded by another task have no ISR stamps and count from the task wake.
+    uint32_t start = cycles[LATENCY_ISR] ? cycles[LATENCY_ISR] : cycles[LATENCY_TASK_WAKE];
+    uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+
+    latency_seq++;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    latency_record_t* record = &latency.log[latency.alerts % LATENCY_LOG_SIZE];
+    record->seq = latency.alerts++;
+    record->uptime_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    memcpy(record->cycles, cycles, sizeof(cycles));
+
+    for (int i = 0; i < LATENCY_STAGE_COUNT; i++)
+    {
+        if (!cycles[i] || !start)
+            continue;
+        // Unsigned difference survives one counter wrap, which is far longer than an alert.
+        uint32_t us = (cycles[i] - start) / ticks_per_us;
+        latency_histogram_t* h = &latency.stages[i];
+        if (!h->count || us < h->min_us)
+            h->min_us = us;
+        if (us > h->max_us)
+            h->max_us = us;
+        h->count++;
+        h->sum_us += us;
+        h->buckets[bucket_index(us)]++;
+        if (i == LATENCY_CUTOFF && us > LATENCY_CUTOFF_SLA_US)
+            latency.sla_violations++;
+    }
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    latency_seq++;
+}
+
+static void snapshot(latency_state_t* out)
+{
+    uint32_t seq;
+    do
+    {
+        seq = latency_seq;
+        if (seq & 1)
+        {
+            vTaskDelay(1);
+            continue;
+        }
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        memcpy(out, &latency, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    }
+    while ((seq & 1) || seq != latency_seq);
+}
+
+// Upper bound of the bucket holding the q-quantile.
+static uint32_t percentile_us(const latency_histogram_t* h, double q)
+{
+    uint32_t target = (uint32_t)(q * h->count);
+    uint32_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++)
+    {
+        seen += h->buckets[i];
+        if (seen > target)
+            return 1u << i;
+    }
+    return h->max_us;
+}
+
+static esp_err_t latency_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    latency_state_t state;
+    snapshot(&state);
+    uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddNumberToObject(root, "alerts", state.alerts);
+    cJSON_AddNumberToObject(root, "coalesced", coalesced_count);
+    cJSON_AddNumberToObject(root, "cpu_mhz", ticks_per_us);
+    cJSON_AddNumberToObject(root, "cutoff_sla_us", LATENCY_CUTOFF_SLA_US);
+    cJSON_AddNumberToObject(root, "cutoff_sla_violations", state.sla_violations);
+
+    // Each stage is timed from the ISR entry of its alert.
+    cJSON* stages = cJSON_AddObjectToObject(root, "stages");
+    for (int i = 0; stages && i < LATENCY_STAGE_COUNT; i++)
+    {
+        const latency_histogram_t* h = &state.stages[i];
+        cJSON* stage = cJSON_AddObjectToObject(stages, stage_names[i]);
+        if (!stage)
+            break;
+        cJSON_AddNumberToObject(stage, "count", h->count);
+        cJSON_AddNumberToObject(stage, "min_us", h->min_us);
+        cJSON_AddNumberToObject(stage, "mean_us", h->count ? (double)h->sum_us / h->count : 0.0);
+        cJSON_AddNumberToObject(stage, "p99_us", percentile_us(h, 0.99));
+        cJSON_AddNumberToObject(stage, "max_us", h->max_us);
+        cJSON* buckets = cJSON_AddArrayToObject(stage, "buckets");
+        for (int b = 0; buckets && b < LATENCY_BUCKETS; b++)
+            cJSON_AddItemToArray(buckets, cJSON_CreateNumber(h->buckets[b]));
+    }
+
+    cJSON* recent = cJSON_AddArrayToObject(root, "recent");
+    uint32_t first = state.alerts > LATENCY_LOG_SIZE ? state.alerts - LATENCY_LOG_SIZE : 0;
+    for (uint32_t n = first; recent && n < state.alerts; n++)
+    {
+        const latency_record_t* record = &state.log[n % LATENCY_LOG_SIZE];
+        cJSON* item = cJSON_CreateObject();
+        if (!item)
+            break;
+        cJSON_AddNumberToObject(item, "seq", record->seq);
+        cJSON_AddNumberToObject(item, "uptime_ms", record->uptime_ms);
+        uint32_t start = record->cycles[LATENCY_ISR] ? record->cycles[LATENCY_ISR]
+                                                     : record->cycles[LATENCY_TASK_WAKE];
+        cJSON* us = cJSON_AddArrayToObject(item, "stage_us");
+        for (int i = 0; us && i < LATENCY_STAGE_COUNT; i++)
+        {
+            if (record->cycles[i] && start)
+                cJSON_AddItemToArray(us, cJSON_CreateNumber((record->cycles[i] - start) / ticks_per_us));
+            else
+                cJSON_AddItemToArray(us, cJSON_CreateNull());
+        }
+        cJSON_AddItemToArray(recent, item);
+    }
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+static esp_err_t latency_post_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    char buf[64];
+    int ret, remaining = req->content_len;
+
+    if (remaining >= sizeof(buf))
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Request content too long");
+        return ESP_FAIL;
+    }
+
+    ret = httpd_req_recv(req, buf, remaining);
+    if (ret <= 0)
+    {
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(req);
+        return ESP_FAIL;
+    }
+    buf[ret] = '\0';
+
+    cJSON* root = cJSON_Parse(buf);
+    if (root == NULL)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON format");
+        return ESP_FAIL;
+    }
+
+    bool reset = cJSON_IsTrue(cJSON_GetObjectItem(root, "reset"));
+    cJSON_Delete(root);
+
+    if (!reset)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Nothing to do");
+        return ESP_FAIL;
+    }
+
+    // The shutdown task is the only writer and runs above httpd; keep it out meanwhile.
+    vTaskSuspendAll();
+    memset(&latency, 0, sizeof(latency));
+    coalesced_count = 0;
+    xTaskResumeAll();
+
+    ESP_LOGI(TAG, "Alert latency statistics reset");
+    httpd_resp_sendstr(req, "{\"status\":\"ok\"}");
+    return ESP_OK;
+}
+
+void register_latency_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {
+        .uri = "/api/latency", .method = HTTP_GET, .handler = latency_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+
+    httpd_uri_t post_uri = {
+        .uri = "/api/latency", .method = HTTP_POST, .handler = latency_post_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &post_uri);
+}
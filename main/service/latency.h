@@ -0,0 +1,50 @@
+#ifndef ODROID_POWER_MATE_LATENCY_H
+#define ODROID_POWER_MATE_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_attr.h"
+
+#define LATENCY_LOG_SIZE 16 // most recent critical alerts kept with every stage
+#define LATENCY_BUCKETS 24 // bucket n counts stages reached in [2^(n-1), 2^n) us, bucket 0 below 1 us
+#define LATENCY_CUTOFF_SLA_US 100 // ISR entry to PM_EXPANDER_RST low
+
+// Stages of the critical alert path, in the order they are reached.
+enum latency_stage
+{
+    LATENCY_ISR = 0, // critical_isr_handler entered
+    LATENCY_CUTOFF = 1, // PM_EXPANDER_RST driven low
+    LATENCY_TASK_WAKE = 2, // shutdown_load_sw_task woke up
+    LATENCY_STATUS = 3, // INA3221 status read
+    LATENCY_SWITCH_CONFIG = 4, // load switches reconfigured off, after the reset hold
+    LATENCY_PERSIST = 5, // disabled state saved to NVS
+    LATENCY_NOTIFY = 6, // "load switch disabled" event queued
+    LATENCY_STAGE_COUNT
+};
+
+// One alert: CPU cycle counts at each stage, 0 for stages that were not reached.
+typedef struct
+{
+    uint32_t seq;
+    uint32_t uptime_ms;
+    uint32_t cycles[LATENCY_STAGE_COUNT];
+} latency_record_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[LATENCY_BUCKETS];
+} latency_histogram_t;
+
+// Called from the ISR for the first two stages; the first stamp opens an alert.
+void IRAM_ATTR latency_stamp_isr(enum latency_stage stage);
+// Called by the shutdown task for the later stages; opens an alert not raised by the ISR.
+void latency_stamp(enum latency_stage stage);
+// Closes the open alert and adds it to the log and the histograms.
+void latency_commit(void);
+
+#endif // ODROID_POWER_MATE_LATENCY_H
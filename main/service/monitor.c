@@ -3,21 +3,34 @@
 //
 
 #include "monitor.h"
+#include <inttypes.h>
+#include <math.h>
 #include <nconfig.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
 #include <time.h>
+#include "batch.h"
+#include "capture.h"
 #include "climit.h"
+#include "datalog.h"
+#include "energy.h"
 #include "esp_log.h"
 #include "esp_netif.h"
 #include "esp_timer.h"
 #include "esp_wifi_types_generic.h"
 #include "event.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h" // Added for FreeRTOS tasks
+#include "histogram.h"
 #include "ina3221.h"
+#include "inrush.h"
+#include "latency.h"
 #include "pbmsg.h"
+#include "rules.h"
+#include "sag.h"
+#include "stats.h"
 #include "sw.h"
 #include "webserver.h"
 #include "wifi.h"
@@ -33,21 +46,46 @@
 #define PM_INT_WARNING CONFIG_GPIO_INA3221_INT_WARNING
 #define PM_EXPANDER_RST CONFIG_GPIO_EXPANDER_RESET
 
+#define INA3221_REG_CONFIG 0x00
+#define INA3221_REG_SHUNT_VOLTAGE_1 0x01
+#define INA3221_REG_BUS_VOLTAGE_1 0x02
 #define INA3221_REG_CRITICAL_ALERT_1 0x07
 #define INA3221_REG_WARNING_ALERT_1 0x08
 #define INA3221_REG_MASK 0x0F
+#define INA3221_MASK_CVRF BIT0
+#define INA3221_MASK_WF(mask) (((mask) >> 3) & 0x7) // BIT2=IN1/USB, BIT1=IN2/MAIN, BIT0=IN3/VIN
+#define INA3221_MASK_CF(mask) (((mask) >> 7) & 0x7)
 #define CLIMIT_DISABLED_LIMIT_A 15.0f
 #define CLIMIT_VERIFY_TOLERANCE_A 0.01f
+#define CLIMIT_REG_COUNT (INA3221_BUS_NUMBER * 2) // critical/warning pairs at 0x07..0x0C
+#define INA3221_CONFIG_RST BIT15
+#define REGISTER_SCRUB_PERIOD_US (30 * 1000 * 1000)
+#define CLOCK_SYNC_PERIOD_US (10 * 1000 * 1000)
+#define SENSOR_BURST_BASELINE_SAMPLES 8
+#define SENSOR_BURST_CLAIM_TIMEOUT_MS 200
 
 static const char* TAG = "monitor";
 
-static esp_timer_handle_t sensor_timer;
 static esp_timer_handle_t wifi_status_timer;
 static esp_timer_handle_t long_press_timer;
 // static esp_timer_handle_t shutdown_load_sw; // No longer needed
 
 static TaskHandle_t shutdown_task_handle = NULL; // Global task handle
 static TaskHandle_t warning_task_handle = NULL;
+static TaskHandle_t acquire_task_handle = NULL;
+static TaskHandle_t publish_task_handle = NULL;
+static volatile uint32_t sensor_period_ms = 1000;
+static volatile bool sensor_timing_changed = false;
+static volatile bool sensor_raw_format = false;
+static volatile bool sensor_batch_format = false; // raw windows plus every conversion in SensorBatch
+static volatile uint8_t sensor_channel_mask = SENSOR_CHANNEL_MASK_ALL;
+static volatile uint16_t sensor_sag_threshold_mv = 0;
+// Configuration the chip runs outside a burst. A burst writes its own settings to the
+// chip and restores this one when it ends.
+static ina3221_config_t sensor_config;
+// Configured timing and channels, set aside while the sag detector overrides them.
+static ina3221_config_t sensor_sag_saved_config;
+static uint8_t sensor_sag_saved_mask;
 static volatile bool critical_cutoff_pending = false;
 static volatile uint16_t pending_critical_flags = 0;
 static volatile uint16_t pending_warning_flags = 0;
@@ -78,12 +116,63 @@ typedef struct
     uint16_t cf_bit;
 } monitor_channel_t;
 
+static const char* const channel_config_names[] = {"usb", "main", "vin"};
+
 static const monitor_channel_t monitor_channels[] = {
     {.name = "USB", .channel = CHANNEL_USB, .cf_bit = BIT2},   // IN1
     {.name = "MAIN", .channel = CHANNEL_MAIN, .cf_bit = BIT1}, // IN2
     {.name = "VIN", .channel = CHANNEL_VIN, .cf_bit = BIT0},   // IN3
 };
 
+// Conversions accumulated by the acquisition task between two SensorData messages.
+typedef struct
+{
+    uint32_t count;
+    int64_t bus_sum[SENSOR_CHANNEL_COUNT];
+    int64_t shunt_sum[SENSOR_CHANNEL_COUNT];
+    int64_t power_sum[SENSOR_CHANNEL_COUNT]; // bus_raw * shunt_raw
+    int16_t bus_min[SENSOR_CHANNEL_COUNT];
+    int16_t bus_max[SENSOR_CHANNEL_COUNT];
+    int16_t shunt_min[SENSOR_CHANNEL_COUNT];
+    int16_t shunt_max[SENSOR_CHANNEL_COUNT];
+    int64_t first_conversion_us;
+    int64_t last_conversion_us;
+} sensor_window_t;
+
+static sensor_window_t sensor_window;
+static sensor_data_t last_sample;
+static int64_t last_conversion_us;
+static int64_t last_clock_sync_us;
+
+enum sensor_burst_state
+{
+    SENSOR_BURST_IDLE = 0,
+    SENSOR_BURST_REQUESTED = 1,
+    SENSOR_BURST_RUNNING = 2,
+};
+
+// One burst request at a time, serialized by burst_mutex; burst_done is given once the
+// edge function has run.
+static struct
+{
+    uint8_t channel_mask;
+    sensor_burst_edge_fn edge_fn;
+    void* arg;
+    esp_err_t result;
+} sensor_burst_request;
+static volatile enum sensor_burst_state sensor_burst_state = SENSOR_BURST_IDLE;
+static portMUX_TYPE sensor_burst_lock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t sensor_burst_mutex;
+static SemaphoreHandle_t sensor_burst_done;
+// Held by every path that changes the INA3221 configuration and by the acquisition task
+// for the whole of a burst, so settings never land between a burst and its restore.
+static SemaphoreHandle_t sensor_config_mutex;
+static sensor_diagnostics_t sensor_diagnostics;
+static portMUX_TYPE sensor_window_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const uint16_t ina3221_ct_us[] = {140, 204, 332, 588, 1100, 2116, 4156, 8244};
+static const uint16_t ina3221_avg_count[] = {1, 4, 16, 64, 128, 256, 512, 1024};
+
 static esp_err_t ina3221_read_reg16(uint8_t reg, uint16_t* val)
 {
     if (!val)
@@ -106,6 +195,55 @@ static esp_err_t ina3221_read_reg16(uint8_t reg, uint16_t* val)
     return ESP_OK;
 }
 
+static float bus_raw_to_v(float raw)
+{
+    return raw / 1000.0f;
+}
+
+static float shunt_raw_to_a(ina3221_channel_t channel, float raw)
+{
+    return raw * 0.005f / (float)ina3221.shunt[channel];
+}
+
+static float power_raw_to_w(ina3221_channel_t channel, float raw)
+{
+    return raw * 0.000005f / (float)ina3221.shunt[channel];
+}
+
+// Reads shunt/bus registers 0x01..0x06 of all channels in one auto-increment transaction.
+static esp_err_t sensor_read_channels(sensor_data_t* sample, uint8_t enabled)
+{
+    uint16_t raw[INA3221_BUS_NUMBER * 2];
+    esp_err_t err = i2c_dev_take_mutex(&ina3221.i2c_dev);
+    if (err != ESP_OK)
+        return err;
+
+    sample->uptime_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    err = i2c_dev_read_reg(&ina3221.i2c_dev, INA3221_REG_SHUNT_VOLTAGE_1, raw, sizeof(raw));
+    esp_err_t unlock_err = i2c_dev_give_mutex(&ina3221.i2c_dev);
+
+    if (err != ESP_OK)
+        return err;
+    if (unlock_err != ESP_OK)
+        return unlock_err;
+
+    // Disabled channels keep their last conversion in the registers; report them as 0.
+    for (uint8_t i = 0; i < INA3221_BUS_NUMBER; i++)
+    {
+        uint16_t shunt_raw = (enabled & BIT(i)) ? raw[i * 2] : 0;
+        uint16_t bus_raw = (enabled & BIT(i)) ? raw[i * 2 + 1] : 0;
+        sample->shunt_raw[i] = (int16_t)((shunt_raw >> 8) | (shunt_raw << 8));
+        sample->bus_raw[i] = (int16_t)((bus_raw >> 8) | (bus_raw << 8));
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t sensor_read_sample(sensor_data_t* sample)
+{
+    return sensor_read_channels(sample, sensor_channel_mask);
+}
+
 static void notify_alert_tasks(uint16_t cf, uint16_t wf)
 {
     if (cf)
@@ -130,12 +268,42 @@ static float climit_raw_to_a(ina3221_channel_t channel, uint16_t raw)
     return current_ma / 1000.0f;
 }
 
+// Alert-limit registers as last read back after a write, indexed from 0x07. Only written
+// with the bus lock held, so a scrub holding the lock compares against a settled copy.
+static uint16_t climit_shadow[CLIMIT_REG_COUNT];
+static bool climit_shadow_valid;
+static portMUX_TYPE climit_shadow_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t last_register_scrub_us;
+static uint16_t scrub_config_suspect; // chip config that differed on the previous pass
+static bool scrub_config_pending;
+
+// regs are as read from the bus, big-endian.
+static void climit_shadow_store(const uint16_t* regs)
+{
+    taskENTER_CRITICAL(&climit_shadow_lock);
+    for (int i = 0; i < CLIMIT_REG_COUNT; i++)
+        climit_shadow[i] = (regs[i] >> 8) | (regs[i] << 8);
+    climit_shadow_valid = true;
+    taskEXIT_CRITICAL(&climit_shadow_lock);
+}
+
 static esp_err_t climit_get_channel_reg(ina3221_channel_t channel, uint8_t base_reg, float* limit_a, uint16_t* raw)
 {
-    uint16_t raw_value;
-    esp_err_t err = ina3221_read_reg16(base_reg + channel * 2, &raw_value);
-    if (err != ESP_OK)
-        return err;
+    uint8_t reg = base_reg + channel * 2;
+    uint16_t raw_value = 0;
+    bool cached;
+    taskENTER_CRITICAL(&climit_shadow_lock);
+    cached = climit_shadow_valid;
+    if (cached)
+        raw_value = climit_shadow[reg - INA3221_REG_CRITICAL_ALERT_1];
+    taskEXIT_CRITICAL(&climit_shadow_lock);
+
+    if (!cached)
+    {
+        esp_err_t err = ina3221_read_reg16(reg, &raw_value);
+        if (err != ESP_OK)
+            return err;
+    }
 
     if (raw)
         *raw = raw_value;
@@ -155,86 +323,283 @@ static esp_err_t climit_get_critical_channel(ina3221_channel_t channel, float* l
     return climit_get_channel_reg(channel, INA3221_REG_CRITICAL_ALERT_1, limit_a, raw);
 }
 
-static esp_err_t climit_set_channel(const char* name, const char* label, ina3221_channel_t channel, double value,
-                                    bool allow_disable)
+// Indexed by enum climit_slot. The critical and warning limits of a channel are adjacent
+// registers, so all six live in 0x07..0x0C.
+static const struct
 {
-    float requested_limit_a = (float)value;
-    if (!allow_disable && requested_limit_a < CRITICAL_CURRENT_LIMIT_MIN)
-    {
-        ESP_LOGW(TAG, "%s %s request rejected: requested=%.3fA", name, label, requested_limit_a);
-        push_eventf(EV_WARNING, "%s %s request rejected: requested=%.3fA", name, label, requested_limit_a);
-        return ESP_ERR_INVALID_ARG;
-    }
+    const char* name;
+    const char* label;
+    ina3221_channel_t channel;
+    bool critical;
+} climit_slots[CLIMIT_SLOT_COUNT] = {
+    [CLIMIT_VIN] = {"VIN", "current limit", CHANNEL_VIN, false},
+    [CLIMIT_MAIN] = {"MAIN", "current limit", CHANNEL_MAIN, false},
+    [CLIMIT_USB] = {"USB", "current limit", CHANNEL_USB, false},
+    [CLIMIT_CRITICAL_VIN] = {"VIN", "critical current limit", CHANNEL_VIN, true},
+    [CLIMIT_CRITICAL_MAIN] = {"MAIN", "critical current limit", CHANNEL_MAIN, true},
+    [CLIMIT_CRITICAL_USB] = {"USB", "critical current limit", CHANNEL_USB, true},
+};
 
-    float applied_limit_a = requested_limit_a > 0.0f ? requested_limit_a : CLIMIT_DISABLED_LIMIT_A;
-    float applied_limit_ma = applied_limit_a * 1000.0f;
-    bool is_critical = !strcmp(label, "critical current limit");
+static uint8_t climit_slot_reg(enum climit_slot slot)
+{
+    uint8_t base = climit_slots[slot].critical ? INA3221_REG_CRITICAL_ALERT_1 : INA3221_REG_WARNING_ALERT_1;
+    return base + climit_slots[slot].channel * 2;
+}
 
-    ESP_LOGI(TAG, "Setting %s %s to: %fmA", name, label, requested_limit_a * 1000.0f);
-    push_eventf(EV_INFO, "Setting %s %s to: %fmA", name, label, requested_limit_a * 1000.0f);
+// Same scaling as ina3221_set_*_alert: mA * mOhm / 40 uV per LSB, left-aligned by 3 bits.
+static uint16_t climit_a_to_raw(ina3221_channel_t channel, float limit_a)
+{
+    int16_t raw = (int16_t)(limit_a * 1000.0f * (float)ina3221.shunt[channel] * 0.2f);
+    return (uint16_t)raw;
+}
 
-    esp_err_t err = is_critical ? ina3221_set_critical_alert(&ina3221, channel, applied_limit_ma)
-                                : ina3221_set_warning_alert(&ina3221, channel, applied_limit_ma);
-    if (err != ESP_OK)
+void climit_batch_stage(climit_batch_t* batch, enum climit_slot slot, double value)
+{
+    if (!batch || slot >= CLIMIT_SLOT_COUNT)
+        return;
+    batch->value[slot] = value;
+    batch->staged |= BIT(slot);
+}
+
+// Writes every staged limit back to back under one bus lock, then verifies all six with a
+// single auto-increment read of 0x07..0x0C. One summary event is pushed for the batch.
+esp_err_t climit_apply_batch(const climit_batch_t* batch, climit_batch_result_t* result)
+{
+    climit_batch_result_t local;
+    if (!result)
+        result = &local;
+    memset(result, 0, sizeof(*result));
+    if (!batch || !batch->staged)
+        return ESP_ERR_INVALID_ARG;
+
+    uint16_t wire[CLIMIT_SLOT_COUNT];
+    float expected_a[CLIMIT_SLOT_COUNT];
+    uint8_t pending = 0;
+    for (int slot = 0; slot < CLIMIT_SLOT_COUNT; slot++)
     {
-        ESP_LOGE(TAG, "Failed to write %s %s: %s", name, label, esp_err_to_name(err));
-        push_eventf(EV_WARNING, "%s %s set failed: requested=%.3fA, applied=%.3fA, error=%s", name, label,
-                    requested_limit_a, applied_limit_a, esp_err_to_name(err));
-        return err;
+        if (!(batch->staged & BIT(slot)))
+            continue;
+        float requested_a = (float)batch->value[slot];
+        if (requested_a < 0.0f || (climit_slots[slot].critical && requested_a < CRITICAL_CURRENT_LIMIT_MIN))
+        {
+            ESP_LOGW(TAG, "%s %s request rejected: requested=%.3fA", climit_slots[slot].name,
+                     climit_slots[slot].label, requested_a);
+            result->err[slot] = ESP_ERR_INVALID_ARG;
+            continue;
+        }
+        expected_a[slot] = requested_a > 0.0f ? requested_a : CLIMIT_DISABLED_LIMIT_A;
+        uint16_t raw = climit_a_to_raw(climit_slots[slot].channel, expected_a[slot]);
+        wire[slot] = (raw >> 8) | (raw << 8);
+        pending |= BIT(slot);
     }
 
-    float readback_limit_a;
-    err = is_critical ? climit_get_critical_channel(channel, &readback_limit_a, NULL)
-                      : climit_get_channel(channel, &readback_limit_a, NULL);
-    if (err != ESP_OK)
+    esp_err_t read_err = ESP_ERR_INVALID_STATE;
+    uint16_t regs[CLIMIT_REG_COUNT];
+    if (pending)
     {
-        ESP_LOGE(TAG, "Failed to read back %s %s: %s", name, label, esp_err_to_name(err));
-        push_eventf(EV_WARNING, "%s %s readback failed: requested=%.3fA, applied=%.3fA, error=%s", name, label,
-                    requested_limit_a, applied_limit_a, esp_err_to_name(err));
-        return err;
+        read_err = i2c_dev_take_mutex(&ina3221.i2c_dev);
+        if (read_err == ESP_OK)
+        {
+            for (int slot = 0; slot < CLIMIT_SLOT_COUNT; slot++)
+            {
+                if (!(pending & BIT(slot)))
+                    continue;
+                esp_err_t err =
+                    i2c_dev_write_reg(&ina3221.i2c_dev, climit_slot_reg(slot), &wire[slot], sizeof(wire[slot]));
+                if (err == ESP_OK)
+                    result->written |= BIT(slot);
+                else
+                    result->err[slot] = err;
+            }
+            read_err = i2c_dev_read_reg(&ina3221.i2c_dev, INA3221_REG_CRITICAL_ALERT_1, regs, sizeof(regs));
+            if (read_err == ESP_OK)
+                climit_shadow_store(regs);
+            i2c_dev_give_mutex(&ina3221.i2c_dev);
+        }
     }
 
-    float diff = readback_limit_a - applied_limit_a;
-    if (diff < 0.0f)
-        diff = -diff;
+    if (read_err == ESP_OK)
+    {
+        for (int slot = 0; slot < CLIMIT_SLOT_COUNT; slot++)
+        {
+            uint16_t raw = regs[climit_slot_reg(slot) - INA3221_REG_CRITICAL_ALERT_1];
+            result->raw[slot] = (raw >> 8) | (raw << 8);
+            result->applied_a[slot] = climit_raw_to_a(climit_slots[slot].channel, result->raw[slot]);
+        }
+        result->readback = true;
+    }
+
+    char summary[160];
+    size_t len = 0;
+    summary[0] = '\0';
+    for (int slot = 0; slot < CLIMIT_SLOT_COUNT; slot++)
+    {
+        if (!(result->written & BIT(slot)))
+        {
+            if ((pending & BIT(slot)) && read_err != ESP_OK && !result->err[slot])
+                result->err[slot] = read_err; // lock was not taken
+            continue;
+        }
+        if (read_err != ESP_OK)
+        {
+            result->err[slot] = read_err;
+            continue;
+        }
 
-    ESP_LOGI(TAG, "%s %s set: applied=%.3fA, requested=%.3fA", name, label, readback_limit_a, requested_limit_a);
-    push_eventf(EV_INFO, "%s %s set: applied=%.3fA, requested=%.3fA", name, label, readback_limit_a,
-                requested_limit_a);
+        float diff = result->applied_a[slot] - expected_a[slot];
+        if (diff < 0.0f)
+            diff = -diff;
+        if (diff > CLIMIT_VERIFY_TOLERANCE_A)
+        {
+            ESP_LOGE(TAG, "%s %s readback mismatch: expected=%.3fA, actual=%.3fA", climit_slots[slot].name,
+                     climit_slots[slot].label, expected_a[slot], result->applied_a[slot]);
+            result->err[slot] = ESP_ERR_INVALID_RESPONSE;
+            continue;
+        }
 
-    if (diff > CLIMIT_VERIFY_TOLERANCE_A)
+        result->verified |= BIT(slot);
+        if (len < sizeof(summary))
+            len += snprintf(summary + len, sizeof(summary) - len, "%s%s%s=%.2fA", len ? " " : "",
+                            climit_slots[slot].name, climit_slots[slot].critical ? "!" : "",
+                            result->applied_a[slot]);
+    }
+
+    esp_err_t first_err = ESP_OK;
+    uint8_t failed = 0;
+    for (int slot = 0; slot < CLIMIT_SLOT_COUNT; slot++)
+    {
+        if ((batch->staged & BIT(slot)) && result->err[slot] != ESP_OK)
+        {
+            failed |= BIT(slot);
+            if (first_err == ESP_OK)
+                first_err = result->err[slot];
+        }
+    }
+
+    if (result->verified)
+    {
+        ESP_LOGI(TAG, "Current limits set: %s", summary);
+        push_eventf(EV_INFO, "Current limits set: %s", summary);
+    }
+    if (failed)
     {
-        ESP_LOGE(TAG, "%s %s readback mismatch: expected=%.3fA, actual=%.3fA", name, label, applied_limit_a,
-                 readback_limit_a);
-        push_eventf(EV_WARNING, "%s %s readback mismatch: expected=%.3fA, actual=%.3fA", name, label,
-                    applied_limit_a, readback_limit_a);
-        return ESP_ERR_INVALID_RESPONSE;
+        ESP_LOGE(TAG, "Current limit batch failed: staged=0x%02x failed=0x%02x error=%s", batch->staged, failed,
+                 esp_err_to_name(first_err));
+        push_eventf(EV_WARNING, "Current limit batch failed: staged=0x%02x failed=0x%02x error=%s", batch->staged,
+                    failed, esp_err_to_name(first_err));
     }
 
     uint16_t mask_raw = 0;
-    esp_err_t mask_err = ina3221_read_reg16(INA3221_REG_MASK, &mask_raw);
-    if (mask_err == ESP_OK)
+    if (result->written && ina3221_read_reg16(INA3221_REG_MASK, &mask_raw) == ESP_OK)
     {
-        ESP_LOGI(TAG, "%s %s status: critical_gpio=%d warning_gpio=%d mask=0x%04x", name, label,
+        ESP_LOGI(TAG, "Current limit status: critical_gpio=%d warning_gpio=%d mask=0x%04x",
                  gpio_get_level(PM_INT_CRITICAL), gpio_get_level(PM_INT_WARNING), mask_raw);
     }
 
-    return ESP_OK;
+    return first_err;
 }
 
-static esp_err_t read_channel_snapshot(const monitor_channel_t* channel, float* voltage, float* current_a)
+// Compares the chip against the limit shadow and the driver's copy of the configuration,
+// and writes back whatever differs. A limit mismatch is repaired at once since the shadow
+// cannot change while the lock is held. The driver updates its configuration copy before
+// taking the lock, so a config mismatch is only acted on when the next pass sees the same
+// value again.
+static void register_scrub_if_due(void)
 {
-    float current_ma;
-    esp_err_t err = ina3221_get_bus_voltage(&ina3221, channel->channel, voltage);
+    int64_t now_us = esp_timer_get_time();
+    if (last_register_scrub_us && now_us - last_register_scrub_us < REGISTER_SCRUB_PERIOD_US)
+        return;
+    last_register_scrub_us = now_us;
+    if (!climit_shadow_valid)
+        return;
+
+    uint16_t regs[CLIMIT_REG_COUNT];
+    uint16_t config_raw = 0;
+    uint16_t config_expected = 0;
+    uint8_t limit_drift = 0;
+    bool config_drift = false;
+
+    // A burst or a settings change is rewriting the configuration; try on the next pass.
+    if (xSemaphoreTake(sensor_config_mutex, 0) != pdTRUE)
+    {
+        last_register_scrub_us = 0;
+        return;
+    }
+
+    esp_err_t err = i2c_dev_take_mutex(&ina3221.i2c_dev);
     if (err != ESP_OK)
-        return err;
+    {
+        xSemaphoreGive(sensor_config_mutex);
+        sensor_diagnostics.scrub_errors++;
+        return;
+    }
+
+    err = i2c_dev_read_reg(&ina3221.i2c_dev, INA3221_REG_CRITICAL_ALERT_1, regs, sizeof(regs));
+    for (int i = 0; err == ESP_OK && i < CLIMIT_REG_COUNT; i++)
+    {
+        uint16_t actual = (regs[i] >> 8) | (regs[i] << 8);
+        if (actual == climit_shadow[i])
+            continue;
+        ESP_LOGW(TAG, "Register 0x%02x drifted: expected=0x%04x, actual=0x%04x", INA3221_REG_CRITICAL_ALERT_1 + i,
+                 climit_shadow[i], actual);
+        uint16_t wire = (climit_shadow[i] >> 8) | (climit_shadow[i] << 8);
+        err = i2c_dev_write_reg(&ina3221.i2c_dev, INA3221_REG_CRITICAL_ALERT_1 + i, &wire, sizeof(wire));
+        limit_drift |= BIT(i);
+    }
 
-    err = ina3221_get_shunt_value(&ina3221, channel->channel, NULL, &current_ma);
+    if (err == ESP_OK)
+        err = i2c_dev_read_reg(&ina3221.i2c_dev, INA3221_REG_CONFIG, &config_raw, sizeof(config_raw));
+    if (err == ESP_OK)
+    {
+        config_raw = ((config_raw >> 8) | (config_raw << 8)) & ~INA3221_CONFIG_RST;
+        config_expected = ina3221.config.config_register & ~INA3221_CONFIG_RST;
+        if (config_raw == config_expected)
+        {
+            scrub_config_pending = false;
+        }
+        else if (!scrub_config_pending || scrub_config_suspect != config_raw)
+        {
+            scrub_config_pending = true;
+            scrub_config_suspect = config_raw;
+        }
+        else
+        {
+            uint16_t wire = (config_expected >> 8) | (config_expected << 8);
+            err = i2c_dev_write_reg(&ina3221.i2c_dev, INA3221_REG_CONFIG, &wire, sizeof(wire));
+            scrub_config_pending = false;
+            config_drift = true;
+        }
+    }
+    i2c_dev_give_mutex(&ina3221.i2c_dev);
+    xSemaphoreGive(sensor_config_mutex);
+
+    sensor_diagnostics.scrubs++;
     if (err != ESP_OK)
-        return err;
+    {
+        sensor_diagnostics.scrub_errors++;
+        ESP_LOGW(TAG, "Register scrub failed: %s", esp_err_to_name(err));
+    }
+    if (limit_drift)
+    {
+        sensor_diagnostics.limit_drift++;
+        ESP_LOGW(TAG, "Current limit registers drifted and were rewritten: 0x%02x", limit_drift);
+        push_eventf(EV_WARNING, "Current limit registers drifted and were rewritten: 0x%02x", limit_drift);
+    }
+    if (config_drift)
+    {
+        sensor_diagnostics.config_drift++;
+        ESP_LOGW(TAG, "INA3221 configuration drifted and was rewritten: expected=0x%04x, actual=0x%04x",
+                 config_expected, config_raw);
+        push_eventf(EV_WARNING, "INA3221 configuration drifted and was rewritten: expected=0x%04x, actual=0x%04x",
+                    config_expected, config_raw);
+    }
+}
 
-    *current_a = current_ma / 1000.0f;
-    return ESP_OK;
+static esp_err_t climit_set_slot(enum climit_slot slot, double value)
+{
+    climit_batch_t batch = {0};
+    climit_batch_stage(&batch, slot, value);
+    return climit_apply_batch(&batch, NULL);
 }
 
 static void push_critical_fault_sources(uint16_t cf)
@@ -257,17 +622,19 @@ static void push_warning_fault_details(uint16_t wf)
     ESP_LOGW(TAG, "warning fault summary: wf=0x%x int_gpio=%d", wf, gpio_get_level(PM_INT_WARNING));
 
     bool any_channel_fault = false;
+    sensor_data_t sample = {0};
+    esp_err_t sample_err = sensor_read_sample(&sample);
+
     for (size_t i = 0; i < sizeof(monitor_channels) / sizeof(monitor_channels[0]); ++i)
     {
         const monitor_channel_t* channel = &monitor_channels[i];
         bool flagged = (wf & channel->cf_bit) != 0;
         any_channel_fault = any_channel_fault || flagged;
 
-        float voltage = 0.0f;
-        float current_a = 0.0f;
+        float voltage = bus_raw_to_v(sample.bus_raw[channel->channel]);
+        float current_a = shunt_raw_to_a(channel->channel, sample.shunt_raw[channel->channel]);
         float limit_a = 0.0f;
         uint16_t raw_limit = 0;
-        esp_err_t sample_err = read_channel_snapshot(channel, &voltage, &current_a);
         esp_err_t limit_err = climit_get_channel(channel->channel, &limit_a, &raw_limit);
 
         if (sample_err == ESP_OK && limit_err == ESP_OK)
@@ -349,44 +716,678 @@ static double clamp_critical_current_limit(double value, double max_value)
     return value;
 }
 
-static void sensor_timer_callback(void* arg)
+uint16_t sensor_shunt_mohm(uint8_t channel)
+{
+    return channel < INA3221_BUS_NUMBER ? ina3221.shunt[channel] : 0;
+}
+
+// Time for one full conversion cycle over all enabled channels with the current averaging.
+static uint32_t sensor_conversion_time_us(void)
+{
+    uint32_t per_channel_us = 0;
+    if (ina3221.config.ebus)
+        per_channel_us += ina3221_ct_us[ina3221.config.vbus];
+    if (ina3221.config.esht)
+        per_channel_us += ina3221_ct_us[ina3221.config.vsht];
+
+    uint32_t channels = ina3221.config.ch1 + ina3221.config.ch2 + ina3221.config.ch3;
+    return per_channel_us * channels * ina3221_avg_count[ina3221.config.avg];
+}
+
+static int table_index(const uint16_t* table, size_t len, int value)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (table[i] == value)
+            return i;
+    }
+    return -1;
+}
+
+// Writing the configuration register restarts the conversion cycle, so the acquisition
+// task is told to drop its deadline and lock onto the new period.
+static esp_err_t sensor_write_timing(ina3221_avg_t avg, ina3221_ct_t bus_ct, ina3221_ct_t shunt_ct)
+{
+    esp_err_t err = ina3221_set_average(&ina3221, avg);
+    if (err == ESP_OK)
+        err = ina3221_set_bus_conversion_time(&ina3221, bus_ct);
+    if (err == ESP_OK)
+        err = ina3221_set_shunt_conversion_time(&ina3221, shunt_ct);
+    sensor_timing_changed = true;
+    return err;
+}
+
+// Settings paths below run with sensor_config_mutex held (or before any task starts) and
+// also make the change the one a burst restores.
+static esp_err_t sensor_apply_timing(ina3221_avg_t avg, ina3221_ct_t bus_ct, ina3221_ct_t shunt_ct)
+{
+    esp_err_t err = sensor_write_timing(avg, bus_ct, shunt_ct);
+    sensor_config = ina3221.config;
+    return err;
+}
+
+// Parses a comma separated subset of "usb,main,vin" into a channel mask, -1 if invalid.
+static int sensor_parse_channels(const char* channels)
+{
+    int mask = 0;
+    const char* p = channels;
+    while (*p)
+    {
+        size_t len = strcspn(p, ",");
+        int found = -1;
+        for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        {
+            if (strlen(channel_config_names[i]) == len && strncmp(p, channel_config_names[i], len) == 0)
+                found = i;
+        }
+        if (found < 0)
+            return -1;
+        mask |= BIT(found);
+        p += len;
+        if (*p == ',')
+            p++;
+    }
+    return mask;
+}
+
+// Also a configuration register write, so the acquisition task re-locks like for timing.
+static esp_err_t sensor_apply_channels(uint8_t mask)
+{
+    esp_err_t err = ina3221_enable_channel(&ina3221, mask & BIT(0), mask & BIT(1), mask & BIT(2));
+    sensor_config = ina3221.config;
+    if (err != ESP_OK)
+        return err;
+
+    sensor_channel_mask = mask;
+    sensor_timing_changed = true;
+    return ESP_OK;
+}
+
+// Turning the detector on switches to no averaging and the shortest conversion times, a
+// cycle of at most 840 us, and adds VIN to the configured channels. The other channels stay
+// enabled so their alert limits and rules keep working. Turning it off restores the
+// configured timing and channels.
+static esp_err_t sensor_apply_sag_threshold(uint16_t threshold_mv)
+{
+    bool was_on = sensor_sag_threshold_mv != 0;
+    esp_err_t err = ESP_OK;
+
+    if (threshold_mv && !was_on)
+    {
+        sensor_sag_saved_config = sensor_config;
+        sensor_sag_saved_mask = sensor_channel_mask;
+        err = sensor_apply_timing(INA3221_AVG_1, INA3221_CT_140, INA3221_CT_140);
+        if (err == ESP_OK)
+            err = sensor_apply_channels(sensor_channel_mask | BIT(CHANNEL_VIN));
+    }
+    else if (!threshold_mv && was_on)
+    {
+        err = sensor_apply_timing(sensor_sag_saved_config.avg, sensor_sag_saved_config.vbus,
+                                  sensor_sag_saved_config.vsht);
+        if (err == ESP_OK)
+            err = sensor_apply_channels(sensor_sag_saved_mask);
+    }
+
+    sag_configure(threshold_mv);
+    sensor_sag_threshold_mv = threshold_mv;
+    if (threshold_mv && !was_on)
+    {
+        ESP_LOGI(TAG, "VIN sag detector on: threshold=%umV", threshold_mv);
+        push_eventf(EV_INFO, "VIN sag detector on: threshold=%umV", threshold_mv);
+    }
+    else if (!threshold_mv && was_on)
+    {
+        push_eventf(EV_INFO, "VIN sag detector off");
+    }
+    return err;
+}
+
+static void sensor_window_reset(sensor_window_t* window)
+{
+    memset(window, 0, sizeof(*window));
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        window->bus_min[i] = INT16_MAX;
+        window->bus_max[i] = INT16_MIN;
+        window->shunt_min[i] = INT16_MAX;
+        window->shunt_max[i] = INT16_MIN;
+    }
+}
+
+static void sensor_window_add(sensor_window_t* window, const sensor_data_t* sample, int64_t conversion_us)
+{
+    if (window->count == 0)
+        window->first_conversion_us = conversion_us;
+    window->last_conversion_us = conversion_us;
+
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        int16_t bus = sample->bus_raw[i];
+        int16_t shunt = sample->shunt_raw[i];
+
+        window->bus_sum[i] += bus;
+        window->shunt_sum[i] += shunt;
+        window->power_sum[i] += (int32_t)bus * shunt;
+        if (bus < window->bus_min[i])
+            window->bus_min[i] = bus;
+        if (bus > window->bus_max[i])
+            window->bus_max[i] = bus;
+        if (shunt < window->shunt_min[i])
+            window->shunt_min[i] = shunt;
+        if (shunt > window->shunt_max[i])
+            window->shunt_max[i] = shunt;
+    }
+    window->count++;
+}
+
+static void sensor_record_jitter(uint32_t jitter_us)
+{
+    // Buckets double from 250 us: <250, <500, <1000, ... , >=16000 us
+    int bucket = 0;
+    for (uint32_t limit = 250; bucket < SENSOR_JITTER_BUCKETS - 1 && jitter_us >= limit; limit <<= 1)
+        bucket++;
+
+    sensor_diagnostics.jitter_histogram[bucket]++;
+    if (jitter_us > sensor_diagnostics.max_jitter_us)
+        sensor_diagnostics.max_jitter_us = jitter_us;
+}
+
+static bool sensor_burst_claim(void)
+{
+    bool claimed = false;
+    portENTER_CRITICAL(&sensor_burst_lock);
+    if (sensor_burst_state == SENSOR_BURST_REQUESTED)
+    {
+        sensor_burst_state = SENSOR_BURST_RUNNING;
+        claimed = true;
+    }
+    portEXIT_CRITICAL(&sensor_burst_lock);
+    return claimed;
+}
+
+static void sensor_burst_run_edge(void)
+{
+    sensor_burst_request.result = sensor_burst_request.edge_fn(sensor_burst_request.arg);
+    inrush_edge(esp_timer_get_time());
+    xSemaphoreGive(sensor_burst_done);
+}
+
+// Hands one conversion to every consumer and to the window of the next SensorData.
+static void sensor_process_sample(sensor_data_t* sample, int64_t sample_us, int64_t* prev_sample_us)
+{
+    sample->uptime_ms = (uint32_t)(sample_us / 1000);
+
+    if (*prev_sample_us)
+    {
+        energy_add(sample, sample_us - *prev_sample_us);
+        histogram_add(sample, sample_us - *prev_sample_us);
+    }
+    *prev_sample_us = sample_us;
+    capture_add(sample);
+    sensor_batch_add(sample, sample_us);
+    stats_add(sample, sample_us);
+    rules_evaluate(sample);
+
+    taskENTER_CRITICAL(&sensor_window_lock);
+    sensor_window_add(&sensor_window, sample, sample_us);
+    last_sample = *sample;
+    last_conversion_us = sample_us;
+    sensor_diagnostics.samples++;
+    taskEXIT_CRITICAL(&sensor_window_lock);
+}
+
+// Samples with no averaging and the shortest conversion times, as fast as the bus allows,
+// and runs the edge function after a short baseline. Every configured channel and VIN stay
+// enabled so the INA3221 keeps checking their alert limits through the inrush; only the
+// requested channels are recorded in the inrush buffer, and every conversion also goes to
+// the regular consumers. The task busy-polls through the burst, so it lasts at most
+// INRUSH_WINDOW_MS after the edge.
+static void sensor_run_burst(uint16_t* prev_wf, int64_t* prev_sample_us)
+{
+    uint8_t channel_mask = sensor_burst_request.channel_mask;
+    uint8_t enabled = sensor_channel_mask | channel_mask | BIT(CHANNEL_VIN);
+
+    xSemaphoreTake(sensor_config_mutex, portMAX_DELAY);
+    esp_err_t err = sensor_write_timing(INA3221_AVG_1, INA3221_CT_140, INA3221_CT_140);
+    if (err == ESP_OK)
+        err = ina3221_enable_channel(&ina3221, enabled & BIT(0), enabled & BIT(1), enabled & BIT(2));
+
+    inrush_begin(channel_mask);
+    int64_t start_us = esp_timer_get_time();
+    int64_t edge_us = 0;
+    uint32_t baseline = 0;
+    while (err == ESP_OK)
+    {
+        int64_t now_us = esp_timer_get_time();
+        if (edge_us ? now_us - edge_us >= INRUSH_WINDOW_MS * 1000
+                    : now_us - start_us >= SENSOR_BURST_CLAIM_TIMEOUT_MS * 1000)
+            break;
+
+        uint16_t mask = 0;
+        if (ina3221_read_reg16(INA3221_REG_MASK, &mask) != ESP_OK)
+            continue;
+        uint16_t wf = INA3221_MASK_WF(mask);
+        notify_alert_tasks(INA3221_MASK_CF(mask), wf & ~*prev_wf);
+        *prev_wf = wf;
+        if (!(mask & INA3221_MASK_CVRF))
+            continue;
+
+        int64_t conversion_us = esp_timer_get_time();
+        sensor_data_t sample;
+        if (sensor_read_channels(&sample, enabled) != ESP_OK)
+        {
+            sensor_diagnostics.read_errors++;
+            continue;
+        }
+        bool room = inrush_add(&sample, conversion_us);
+        sag_add(&sample, conversion_us);
+
+        // Channels enabled only for the burst read 0 like they do outside it.
+        for (uint8_t i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+        {
+            if (!(sensor_channel_mask & BIT(i)))
+            {
+                sample.bus_raw[i] = 0;
+                sample.shunt_raw[i] = 0;
+            }
+        }
+        sensor_process_sample(&sample, conversion_us, prev_sample_us);
+
+        if (!edge_us && ++baseline >= SENSOR_BURST_BASELINE_SAMPLES)
+        {
+            sensor_burst_run_edge();
+            edge_us = esp_timer_get_time();
+        }
+        if (!room)
+            break;
+    }
+    if (sensor_sag_threshold_mv)
+        sag_watch(start_us, esp_timer_get_time());
+
+    // The caller is waiting for its switch to happen, with or without a recording.
+    if (!edge_us)
+    {
+        ESP_LOGW(TAG, "Burst ended before its edge: %s", esp_err_to_name(err));
+        sensor_burst_run_edge();
+    }
+
+    err = sensor_write_timing(sensor_config.avg, sensor_config.vbus, sensor_config.vsht);
+    if (err == ESP_OK)
+        err = ina3221_enable_channel(&ina3221, sensor_config.ch1, sensor_config.ch2, sensor_config.ch3);
+    xSemaphoreGive(sensor_config_mutex);
+    if (err != ESP_OK)
+        ESP_LOGW(TAG, "Failed to restore sensor configuration after burst: %s", esp_err_to_name(err));
+
+    portENTER_CRITICAL(&sensor_burst_lock);
+    sensor_burst_state = SENSOR_BURST_IDLE;
+    portEXIT_CRITICAL(&sensor_burst_lock);
+
+    inrush_finish();
+}
+
+// Sag detection: a cycle takes at most 840 us, faster than a tick, so the task busy-polls
+// for SAG_POLL_WINDOW_US of each tick and sleeps the rest to leave time to httpd. Sags
+// shorter than the sleep can fall between two windows; the diagnostics report the coverage.
+static void sensor_sag_poll(uint16_t* prev_wf, int64_t* prev_sample_us)
+{
+    int64_t start_us = esp_timer_get_time();
+    int64_t now_us = start_us;
+    while (now_us - start_us < SAG_POLL_WINDOW_US && sensor_burst_state != SENSOR_BURST_REQUESTED)
+    {
+        uint16_t mask = 0;
+        if (ina3221_read_reg16(INA3221_REG_MASK, &mask) == ESP_OK)
+        {
+            uint16_t wf = INA3221_MASK_WF(mask);
+            notify_alert_tasks(INA3221_MASK_CF(mask), wf & ~*prev_wf);
+            *prev_wf = wf;
+            if (mask & INA3221_MASK_CVRF)
+            {
+                int64_t ready_us = esp_timer_get_time();
+                sensor_data_t sample;
+                if (sensor_read_sample(&sample) == ESP_OK)
+                {
+                    sag_add(&sample, ready_us);
+                    sensor_process_sample(&sample, ready_us, prev_sample_us);
+                }
+                else
+                {
+                    sensor_diagnostics.read_errors++;
+                }
+            }
+        }
+        now_us = esp_timer_get_time();
+    }
+    sag_watch(start_us, now_us);
+}
+
+// Samples the INA3221 once per conversion cycle on an absolute schedule. Each deadline is
+// the previous one plus the conversion time, nudged toward the observed conversion-ready
+// time so the schedule follows the INA3221 clock instead of accumulating wake-up latency.
+// The mask register is polled for the conversion-ready flag; reading it also clears the
+// latched critical flags, so those are forwarded. Warning flags are not latched and only
+// forwarded when they newly assert.
+static void sensor_acquire_task(void* pvParameters)
+{
+    uint16_t prev_wf = 0;
+    int64_t deadline_us = esp_timer_get_time();
+    int64_t prev_sample_us = 0;
+
+    while (1)
+    {
+        if (sensor_timing_changed)
+        {
+            sensor_timing_changed = false;
+            deadline_us = esp_timer_get_time();
+        }
+
+        int64_t period_us = sensor_conversion_time_us();
+        sensor_diagnostics.conversion_time_us = period_us;
+
+        if (sensor_sag_threshold_mv)
+        {
+            // A burst request wakes the task early.
+            ulTaskNotifyTake(pdTRUE, 1);
+            sensor_sag_poll(&prev_wf, &prev_sample_us);
+            if (sensor_burst_claim())
+                sensor_run_burst(&prev_wf, &prev_sample_us);
+            deadline_us = esp_timer_get_time();
+            continue;
+        }
+
+        deadline_us += period_us;
+
+        bool slept = false;
+        int64_t now_us = esp_timer_get_time();
+        if (now_us > deadline_us + period_us)
+        {
+            // Woke more than a whole conversion late: those conversions were overwritten.
+            int64_t missed = (now_us - deadline_us) / period_us;
+            sensor_diagnostics.missed_deadlines += missed;
+            deadline_us += missed * period_us;
+        }
+        else
+        {
+            // Wake one tick early and poll the rest, the flag decides the exact moment.
+            int64_t ticks = (deadline_us - now_us) / (portTICK_PERIOD_MS * 1000) - 1;
+            if (ticks > 0)
+            {
+                // A burst request wakes the task early.
+                ulTaskNotifyTake(pdTRUE, ticks);
+                slept = true;
+            }
+        }
+        // Conversions faster than a tick would otherwise keep this task busy above httpd.
+        if (!slept)
+            vTaskDelay(1);
+
+        TickType_t timeout = pdMS_TO_TICKS(period_us / 1000) + 2;
+        TickType_t waited = 0;
+        int64_t ready_us = 0;
+        while (sensor_burst_state != SENSOR_BURST_REQUESTED)
+        {
+            uint16_t mask = 0;
+            if (ina3221_read_reg16(INA3221_REG_MASK, &mask) == ESP_OK)
+            {
+                uint16_t wf = INA3221_MASK_WF(mask);
+                notify_alert_tasks(INA3221_MASK_CF(mask), wf & ~prev_wf);
+                prev_wf = wf;
+                if (mask & INA3221_MASK_CVRF)
+                {
+                    ready_us = esp_timer_get_time();
+                    break;
+                }
+            }
+            // The alert tasks read the mask register too and may consume the flag first.
+            if (++waited > timeout)
+                break;
+            vTaskDelay(1);
+        }
+
+        if (sensor_burst_claim())
+        {
+            sensor_run_burst(&prev_wf, &prev_sample_us);
+            continue;
+        }
+
+        // Stamp the conversion, not the read: I2C contention only delays the latter. The
+        // ready flag is polled, so ready_us is at most one poll after the conversion ended.
+        int64_t sample_us = ready_us ? ready_us : esp_timer_get_time();
+        sensor_data_t sample;
+        if (sensor_read_sample(&sample) != ESP_OK)
+        {
+            sensor_diagnostics.read_errors++;
+            continue;
+        }
+        sensor_process_sample(&sample, sample_us, &prev_sample_us);
+
+        if (ready_us)
+        {
+            int64_t error_us = ready_us - deadline_us;
+            sensor_record_jitter(error_us < 0 ? -error_us : error_us);
+            deadline_us += error_us / 8;
+        }
+        else
+        {
+            sensor_diagnostics.ready_timeouts++;
+        }
+    }
+}
+
+// Rounds num / den to the nearest integer without going through float.
+static int32_t div_round(int64_t num, int64_t den)
+{
+    return (num >= 0 ? num + den / 2 : num - den / 2) / den;
+}
+
+// shunt_raw is 5 uV/LSB, so raw * 5000 / mOhm gives uA.
+static int32_t shunt_raw_to_ua(uint8_t channel, int64_t raw_sum, uint32_t count)
+{
+    return div_round(raw_sum * 5000, (int64_t)count * ina3221.shunt[channel]);
+}
+
+static void sensor_fill_data(StatusMessage* message, const sensor_window_t* window)
+{
+    message->which_payload = StatusMessage_sensor_data_tag;
+    SensorData* sensor_data = &message->payload.sensor_data;
+
+    uint8_t enabled = sensor_channel_mask;
+    sensor_data->has_usb = enabled & BIT(0);
+    sensor_data->has_main = enabled & BIT(1);
+    sensor_data->has_vin = enabled & BIT(2);
+
+    SensorChannelData* channels[] = {&sensor_data->usb, &sensor_data->main, &sensor_data->vin};
+    float count = (float)window->count;
+    energy_snapshot_t energy;
+    energy_snapshot(&energy);
+
+    for (uint8_t i = 0; i < INA3221_BUS_NUMBER; i++)
+    {
+        channels[i]->voltage = bus_raw_to_v((float)window->bus_sum[i] / count);
+        channels[i]->current = shunt_raw_to_a(i, (float)window->shunt_sum[i] / count);
+        channels[i]->power = power_raw_to_w(i, (float)window->power_sum[i] / count);
+        channels[i]->voltage_min = bus_raw_to_v(window->bus_min[i]);
+        channels[i]->voltage_max = bus_raw_to_v(window->bus_max[i]);
+        channels[i]->current_min = shunt_raw_to_a(i, window->shunt_min[i]);
+        channels[i]->current_max = shunt_raw_to_a(i, window->shunt_max[i]);
+        channels[i]->energy_wh = (float)energy.energy_wh[i];
+        channels[i]->charge_mah = (float)energy.charge_mah[i];
+    }
+    sensor_data->sample_count = window->count;
+}
+
+// Integer-only path: bus_raw is already mV and the shunt conversion is one division.
+static void sensor_fill_data_raw(StatusMessage* message, const sensor_window_t* window)
+{
+    message->which_payload = StatusMessage_sensor_data_raw_tag;
+    SensorDataRaw* raw = &message->payload.sensor_data_raw;
+
+    for (uint8_t i = 0; i < INA3221_BUS_NUMBER; i++)
+    {
+        raw->voltage_mv[i] = div_round(window->bus_sum[i], window->count);
+        raw->current_ua[i] = shunt_raw_to_ua(i, window->shunt_sum[i], window->count);
+        raw->voltage_min_mv[i] = window->bus_min[i];
+        raw->voltage_max_mv[i] = window->bus_max[i];
+        raw->current_min_ua[i] = shunt_raw_to_ua(i, window->shunt_min[i], 1);
+        raw->current_max_ua[i] = shunt_raw_to_ua(i, window->shunt_max[i], 1);
+    }
+    energy_snapshot_raw(raw->energy_uwh, raw->charge_uah);
+
+    raw->voltage_mv_count = INA3221_BUS_NUMBER;
+    raw->current_ua_count = INA3221_BUS_NUMBER;
+    raw->voltage_min_mv_count = INA3221_BUS_NUMBER;
+    raw->voltage_max_mv_count = INA3221_BUS_NUMBER;
+    raw->current_min_ua_count = INA3221_BUS_NUMBER;
+    raw->current_max_ua_count = INA3221_BUS_NUMBER;
+    raw->energy_uwh_count = INA3221_BUS_NUMBER;
+    raw->charge_uah_count = INA3221_BUS_NUMBER;
+    raw->sample_count = window->count;
+    raw->disabled_channels = ~sensor_channel_mask & SENSOR_CHANNEL_MASK_ALL;
+}
+
+// Reads the wall clock between two esp_timer reads so the pair is off by at most
+// half the gap, which is returned as the uncertainty.
+static uint32_t sensor_clock_pair(int64_t* wall_us, int64_t* uptime_us)
 {
     struct timeval tv;
+    int64_t before_us = esp_timer_get_time();
     gettimeofday(&tv, NULL);
-    uint64_t timestamp_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
-    uint64_t uptime_ms = (uint64_t)esp_timer_get_time() / 1000;
+    int64_t after_us = esp_timer_get_time();
+
+    *wall_us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    *uptime_us = before_us + (after_us - before_us) / 2;
+    return (after_us - before_us + 1) / 2;
+}
+
+static void sensor_publish_clock_sync_if_due(void)
+{
+    int64_t now_us = esp_timer_get_time();
+    if (last_clock_sync_us && now_us - last_clock_sync_us < CLOCK_SYNC_PERIOD_US)
+        return;
+    last_clock_sync_us = now_us;
 
     StatusMessage message = StatusMessage_init_zero;
-    message.which_payload = StatusMessage_sensor_data_tag;
-    SensorData* sensor_data = &message.payload.sensor_data;
+    message.which_payload = StatusMessage_clock_sync_tag;
+    ClockSync* sync = &message.payload.clock_sync;
+    int64_t wall_us, uptime_us;
+    sync->uncertainty_us = sensor_clock_pair(&wall_us, &uptime_us);
+    sync->wall_us = wall_us;
+    sync->uptime_us = uptime_us;
 
-    sensor_data->has_usb = true;
-    sensor_data->has_main = true;
-    sensor_data->has_vin = true;
+    send_pb_message(StatusMessage_fields, &message);
+}
 
-    SensorChannelData* channels[] = {&sensor_data->usb, &sensor_data->main, &sensor_data->vin};
+static void sensor_publish(void)
+{
+    sensor_window_t window;
+    taskENTER_CRITICAL(&sensor_window_lock);
+    window = sensor_window;
+    sensor_window_reset(&sensor_window);
+    if (window.count == 0)
+    {
+        // No conversion finished, repeat the last one
+        sensor_window_add(&window, &last_sample, last_conversion_us);
+    }
+    taskEXIT_CRITICAL(&sensor_window_lock);
+
+    // Message times refer to the newest conversion, mapped to the wall clock once per message.
+    int64_t wall_us, now_us;
+    sensor_clock_pair(&wall_us, &now_us);
+    uint64_t timestamp_ms = (uint64_t)(window.last_conversion_us + wall_us - now_us) / 1000;
+    uint64_t uptime_ms = (uint64_t)window.last_conversion_us / 1000;
 
+    sensor_data_t sample = {.uptime_ms = (uint32_t)uptime_ms};
     for (uint8_t i = 0; i < INA3221_BUS_NUMBER; i++)
     {
-        float voltage, current, power;
-        ina3221_get_bus_voltage(&ina3221, i, &voltage);
-        ina3221_get_shunt_value(&ina3221, i, NULL, &current);
+        sample.bus_raw[i] = (int16_t)div_round(window.bus_sum[i], window.count);
+        sample.shunt_raw[i] = (int16_t)div_round(window.shunt_sum[i], window.count);
+    }
+    datalog_add(&sample);
 
-        current /= 1000.0f; // mA to A
-        power = voltage * current;
+    if (!ws_payload_subscribed(sensor_raw_format ? StatusMessage_sensor_data_raw_tag : StatusMessage_sensor_data_tag))
+        return;
 
-        // For protobuf
-        channels[i]->voltage = voltage;
-        channels[i]->current = current;
-        channels[i]->power = power;
+    StatusMessage message = StatusMessage_init_zero;
+    if (sensor_raw_format)
+    {
+        sensor_fill_data_raw(&message, &window);
+        message.payload.sensor_data_raw.timestamp_ms = timestamp_ms;
+        message.payload.sensor_data_raw.uptime_ms = uptime_ms;
+        message.payload.sensor_data_raw.first_conversion_us = window.first_conversion_us;
+        message.payload.sensor_data_raw.last_conversion_us = window.last_conversion_us;
+    }
+    else
+    {
+        sensor_fill_data(&message, &window);
+        message.payload.sensor_data.timestamp_ms = timestamp_ms;
+        message.payload.sensor_data.uptime_ms = uptime_ms;
+        message.payload.sensor_data.first_conversion_us = window.first_conversion_us;
+        message.payload.sensor_data.last_conversion_us = window.last_conversion_us;
     }
 
-    // datalog_add(timestamp, channel_data_log);
+    send_pb_message(StatusMessage_fields, &message);
+}
 
-    sensor_data->timestamp_ms = timestamp_ms;
-    sensor_data->uptime_ms = uptime_ms;
+// Publishes one SensorData per configured period. Runs as a task so the encode and the
+// WebSocket queueing do not hold up the shared esp_timer task.
+static void sensor_publish_task(void* pvParameters)
+{
+    TickType_t last_wake = xTaskGetTickCount();
 
-    send_pb_message(StatusMessage_fields, &message);
+    while (1)
+    {
+        if (xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(sensor_period_ms)) == pdFALSE)
+            sensor_diagnostics.publish_overruns++;
+
+        sensor_publish();
+        sensor_diagnostics.publish_count++;
+        energy_checkpoint_if_due();
+        stats_publish_if_due();
+        sensor_publish_clock_sync_if_due();
+        sag_report_if_pending();
+        register_scrub_if_due();
+    }
+}
+
+// The noise model is a rough estimate: about one 40 uV shunt LSB RMS per conversion at
+// 140 us, falling with the square root of both the conversion time and the averaging.
+// While the sag detector runs, averaging and conversion times are the configured ones and
+// the cycle and rate are those of the detector.
+void sensor_get_timing(sensor_timing_t* timing)
+{
+    if (!timing)
+        return;
+
+    bool sag = sensor_sag_threshold_mv != 0;
+    ina3221_config_t config = sag ? sensor_sag_saved_config : sensor_config;
+    timing->averaging = ina3221_avg_count[config.avg];
+    timing->bus_ct_us = ina3221_ct_us[config.vbus];
+    timing->shunt_ct_us = ina3221_ct_us[config.vsht];
+    timing->conversion_time_us = sensor_conversion_time_us();
+
+    float rate_hz = timing->conversion_time_us ? 1000000.0f / timing->conversion_time_us : 0.0f;
+    if (sag)
+        timing->sample_rate_hz = rate_hz * SAG_POLL_WINDOW_US / (portTICK_PERIOD_MS * 1000);
+    else
+        timing->sample_rate_hz = rate_hz > configTICK_RATE_HZ ? configTICK_RATE_HZ : rate_hz;
+
+    uint16_t mohm = ina3221.shunt[0];
+    for (uint8_t i = 1; i < INA3221_BUS_NUMBER; i++)
+    {
+        if (ina3221.shunt[i] < mohm)
+            mohm = ina3221.shunt[i];
+    }
+    float noise_uv = 40.0f * sqrtf(140.0f / timing->shunt_ct_us) / sqrtf(timing->averaging);
+    timing->noise_floor_ma = noise_uv / mohm;
+}
+
+void sensor_get_diagnostics(sensor_diagnostics_t* diagnostics)
+{
+    if (!diagnostics)
+        return;
+
+    taskENTER_CRITICAL(&sensor_window_lock);
+    *diagnostics = sensor_diagnostics;
+    taskEXIT_CRITICAL(&sensor_window_lock);
 }
 
 static void status_wifi_callback(void* arg)
@@ -449,19 +1450,29 @@ static void shutdown_load_sw_task(void* pvParameters)
     {
         // Wait indefinitely for a notification from the ISR
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        latency_stamp(LATENCY_TASK_WAKE);
 
         // The critical ISR normally cuts the outputs first. Keep this as a
         // fallback for alerts forwarded by another task or detected at startup.
         gpio_set_level(PM_EXPANDER_RST, 0);
+        latency_stamp(LATENCY_CUTOFF);
 
         ESP_LOGW(TAG, "critical interrupt triggered (via task)");
-        uint16_t cf = take_pending_flags(&pending_critical_flags);
+        // The status read waits for the I2C bus, and the acquisition task may meanwhile
+        // consume the latched flags and forward them. Collect those only after the read,
+        // and drop the notification that came with them so they do not run a second pass.
         esp_err_t status_err = ina3221_get_status(&ina3221);
+        latency_stamp(LATENCY_STATUS);
+        ulTaskNotifyTake(pdTRUE, 0);
+        uint16_t cf = take_pending_flags(&pending_critical_flags);
         bool button_pressed = false;
 
         if (status_err == ESP_OK)
-        {
             cf |= ina3221.mask.cf; // BIT2=IN1/USB, BIT1=IN2/MAIN, BIT0=IN3/VIN
+        capture_trigger(CAPTURE_SOURCE_CRITICAL, cf);
+
+        if (status_err == ESP_OK)
+        {
             notify_alert_tasks(0, ina3221.mask.wf);
             if (cf)
                 push_critical_fault_sources(cf);
@@ -484,11 +1495,15 @@ static void shutdown_load_sw_task(void* pvParameters)
         vTaskDelay(100 / portTICK_PERIOD_MS);
         gpio_set_level(PM_EXPANDER_RST, 1);
         config_sw();
+        latency_stamp(LATENCY_SWITCH_CONFIG);
         esp_err_t persist_err = persist_load_switch_state();
+        latency_stamp(LATENCY_PERSIST);
         if (persist_err != ESP_OK)
             ESP_LOGW(TAG, "failed to save disabled load switch state: %s", esp_err_to_name(persist_err));
 
         push_eventf(EV_CRITICAL, "load switch disabled");
+        latency_stamp(LATENCY_NOTIFY);
+        latency_commit();
 
         // Only a held button press can trigger the configuration reset.
         if (button_pressed && gpio_get_level(PM_INT_CRITICAL) == 0)
@@ -518,6 +1533,7 @@ static void warning_alert_task(void* pvParameters)
             notify_alert_tasks(ina3221.mask.cf, 0);
             if (wf)
             {
+                capture_trigger(CAPTURE_SOURCE_WARNING, wf);
                 push_warning_fault_details(wf);
                 disable_warning_fault_load_switches(wf);
                 last_warning_flags = wf;
@@ -543,8 +1559,10 @@ static void IRAM_ATTR critical_isr_handler(void* arg)
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     if (gpio_get_level(PM_INT_CRITICAL) == 0) // Falling edge
     {
+        latency_stamp_isr(LATENCY_ISR);
         // Critical current and button presses both require immediate cutoff.
         gpio_set_level(PM_EXPANDER_RST, 0);
+        latency_stamp_isr(LATENCY_CUTOFF);
 
         if (shutdown_task_handle != NULL)
         {
@@ -595,32 +1613,32 @@ static void gpio_init()
 
 esp_err_t climit_set_vin(double value)
 {
-    return climit_set_channel("VIN", "current limit", CHANNEL_VIN, value, true);
+    return climit_set_slot(CLIMIT_VIN, value);
 }
 
 esp_err_t climit_set_main(double value)
 {
-    return climit_set_channel("MAIN", "current limit", CHANNEL_MAIN, value, true);
+    return climit_set_slot(CLIMIT_MAIN, value);
 }
 
 esp_err_t climit_set_usb(double value)
 {
-    return climit_set_channel("USB", "current limit", CHANNEL_USB, value, true);
+    return climit_set_slot(CLIMIT_USB, value);
 }
 
 esp_err_t climit_set_critical_vin(double value)
 {
-    return climit_set_channel("VIN", "critical current limit", CHANNEL_VIN, value, false);
+    return climit_set_slot(CLIMIT_CRITICAL_VIN, value);
 }
 
 esp_err_t climit_set_critical_main(double value)
 {
-    return climit_set_channel("MAIN", "critical current limit", CHANNEL_MAIN, value, false);
+    return climit_set_slot(CLIMIT_CRITICAL_MAIN, value);
 }
 
 esp_err_t climit_set_critical_usb(double value)
 {
-    return climit_set_channel("USB", "critical current limit", CHANNEL_USB, value, false);
+    return climit_set_slot(CLIMIT_CRITICAL_USB, value);
 }
 
 esp_err_t climit_get_vin(float* limit_a, uint16_t* raw)
@@ -659,38 +1677,71 @@ void init_status_monitor()
     ESP_ERROR_CHECK(ina3221_init_desc(&ina3221, 0x40, 0, PM_SDA, PM_SCL));
     ESP_ERROR_CHECK(ina3221_sync(&ina3221));
     ESP_ERROR_CHECK(ina3221_enable_latch_pin(&ina3221, false, true));
+    sensor_config = ina3221.config;
+    sensor_config_mutex = xSemaphoreCreateMutex();
 
     double lim;
     char buf[16];
 
-    nconfig_read(VIN_CURRENT_LIMIT, buf, sizeof(buf));
-    lim = clamp_current_limit(atof(buf), VIN_CURRENT_LIMIT_MAX);
-    climit_set_vin(lim);
-    nconfig_read(VIN_CRITICAL_CURRENT_LIMIT, buf, sizeof(buf));
-    lim = clamp_critical_current_limit(atof(buf), VIN_CRITICAL_CURRENT_LIMIT_MAX);
-    climit_set_critical_vin(lim);
-
-    nconfig_read(MAIN_CURRENT_LIMIT, buf, sizeof(buf));
-    lim = clamp_current_limit(atof(buf), MAIN_CURRENT_LIMIT_MAX);
-    climit_set_main(lim);
-    nconfig_read(MAIN_CRITICAL_CURRENT_LIMIT, buf, sizeof(buf));
-    lim = clamp_critical_current_limit(atof(buf), MAIN_CRITICAL_CURRENT_LIMIT_MAX);
-    climit_set_critical_main(lim);
-
-    nconfig_read(USB_CURRENT_LIMIT, buf, sizeof(buf));
-    lim = clamp_current_limit(atof(buf), USB_CURRENT_LIMIT_MAX);
-    climit_set_usb(lim);
-    nconfig_read(USB_CRITICAL_CURRENT_LIMIT, buf, sizeof(buf));
-    lim = clamp_critical_current_limit(atof(buf), USB_CRITICAL_CURRENT_LIMIT_MAX);
-    climit_set_critical_usb(lim);
-
-    const esp_timer_create_args_t sensor_timer_args = {.callback = &sensor_timer_callback,
-                                                       .name = "sensor_reading_timer"};
+    int avg = 0, bus_ct = 0, shunt_ct = 0;
+    if (nconfig_read(SENSOR_AVERAGING, buf, sizeof(buf)) == ESP_OK)
+        avg = table_index(ina3221_avg_count, sizeof(ina3221_avg_count) / sizeof(ina3221_avg_count[0]),
+                          strtol(buf, NULL, 10));
+    if (nconfig_read(SENSOR_BUS_CT_US, buf, sizeof(buf)) == ESP_OK)
+        bus_ct = table_index(ina3221_ct_us, sizeof(ina3221_ct_us) / sizeof(ina3221_ct_us[0]), strtol(buf, NULL, 10));
+    if (nconfig_read(SENSOR_SHUNT_CT_US, buf, sizeof(buf)) == ESP_OK)
+        shunt_ct = table_index(ina3221_ct_us, sizeof(ina3221_ct_us) / sizeof(ina3221_ct_us[0]), strtol(buf, NULL, 10));
+    if (avg < 0 || bus_ct < 0 || shunt_ct < 0)
+        ESP_LOGW(TAG, "Ignoring invalid stored sensor timing, using defaults");
+    else if (sensor_apply_timing(avg, bus_ct, shunt_ct) != ESP_OK)
+        ESP_LOGW(TAG, "Failed to apply stored sensor timing");
+
+    char channels[24];
+    int mask = SENSOR_CHANNEL_MASK_ALL;
+    if (nconfig_read(SENSOR_CHANNELS, channels, sizeof(channels)) == ESP_OK)
+        mask = sensor_parse_channels(channels);
+    if (mask <= 0)
+        ESP_LOGW(TAG, "Ignoring invalid stored sensor channels, enabling all");
+    else if (mask != SENSOR_CHANNEL_MASK_ALL && sensor_apply_channels(mask) != ESP_OK)
+        ESP_LOGW(TAG, "Failed to apply stored sensor channels");
+
+    if (nconfig_read(VIN_SAG_THRESHOLD_MV, buf, sizeof(buf)) == ESP_OK)
+    {
+        int threshold_mv = strtol(buf, NULL, 10);
+        if (threshold_mv >= SAG_THRESHOLD_MIN_MV && threshold_mv <= SAG_THRESHOLD_MAX_MV)
+            sensor_apply_sag_threshold(threshold_mv);
+    }
+
+    // All six limits go out in one burst and are verified with one readback.
+    static const struct
+    {
+        enum climit_slot slot;
+        enum nconfig_type config;
+        double max_value;
+    } boot_limits[] = {
+        {CLIMIT_VIN, VIN_CURRENT_LIMIT, VIN_CURRENT_LIMIT_MAX},
+        {CLIMIT_CRITICAL_VIN, VIN_CRITICAL_CURRENT_LIMIT, VIN_CRITICAL_CURRENT_LIMIT_MAX},
+        {CLIMIT_MAIN, MAIN_CURRENT_LIMIT, MAIN_CURRENT_LIMIT_MAX},
+        {CLIMIT_CRITICAL_MAIN, MAIN_CRITICAL_CURRENT_LIMIT, MAIN_CRITICAL_CURRENT_LIMIT_MAX},
+        {CLIMIT_USB, USB_CURRENT_LIMIT, USB_CURRENT_LIMIT_MAX},
+        {CLIMIT_CRITICAL_USB, USB_CRITICAL_CURRENT_LIMIT, USB_CRITICAL_CURRENT_LIMIT_MAX},
+    };
+    climit_batch_t limits = {0};
+    for (size_t i = 0; i < sizeof(boot_limits) / sizeof(boot_limits[0]); i++)
+    {
+        nconfig_read(boot_limits[i].config, buf, sizeof(buf));
+        if (boot_limits[i].slot >= CLIMIT_CRITICAL_VIN)
+            lim = clamp_critical_current_limit(atof(buf), boot_limits[i].max_value);
+        else
+            lim = clamp_current_limit(atof(buf), boot_limits[i].max_value);
+        climit_batch_stage(&limits, boot_limits[i].slot, lim);
+    }
+    climit_apply_batch(&limits, NULL);
+
     const esp_timer_create_args_t wifi_timer_args = {.callback = &status_wifi_callback, .name = "wifi_status_timer"};
     const esp_timer_create_args_t long_press_timer_args = {.callback = &long_press_timer_callback,
                                                            .name = "long_press_timer"};
 
-    ESP_ERROR_CHECK(esp_timer_create(&sensor_timer_args, &sensor_timer));
     ESP_ERROR_CHECK(esp_timer_create(&wifi_timer_args, &wifi_status_timer));
     ESP_ERROR_CHECK(esp_timer_create(&long_press_timer_args, &long_press_timer));
 
@@ -707,8 +1758,28 @@ void init_status_monitor()
     if (gpio_get_level(PM_INT_WARNING) == 0 && warning_task_handle != NULL)
         xTaskNotifyGive(warning_task_handle);
 
+    energy_init();
+    stats_init();
+    histogram_reset();
+    rules_init();
+    sensor_window_reset(&sensor_window);
+    sensor_read_sample(&last_sample);
+    last_conversion_us = esp_timer_get_time();
+    sensor_burst_mutex = xSemaphoreCreateMutex();
+    sensor_burst_done = xSemaphoreCreateBinary();
+    // Above httpd (12) so WebSocket load cannot stretch the sample period.
+    xTaskCreate(sensor_acquire_task, "sensor_acquire", configMINIMAL_STACK_SIZE * 3, NULL, 13, &acquire_task_handle);
+
     nconfig_read(SENSOR_PERIOD_MS, buf, sizeof(buf));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(sensor_timer, strtol(buf, NULL, 10) * 1000));
+    sensor_period_ms = strtol(buf, NULL, 10);
+    if (nconfig_read(SENSOR_FORMAT, buf, sizeof(buf)) == ESP_OK)
+    {
+        sensor_batch_format = strcmp(buf, "batch") == 0;
+        sensor_raw_format = sensor_batch_format || strcmp(buf, "raw") == 0;
+    }
+    sensor_batch_init();
+    sensor_batch_enable(sensor_batch_format);
+    xTaskCreate(sensor_publish_task, "sensor_publish", 1024 * 4, NULL, 7, &publish_task_handle);
     ESP_ERROR_CHECK(esp_timer_start_periodic(wifi_status_timer, 1000000 * 5));
 }
 
@@ -726,6 +1797,228 @@ esp_err_t update_sensor_period(int period)
         return err;
     }
 
-    esp_timer_stop(sensor_timer);
-    return esp_timer_start_periodic(sensor_timer, period * 1000);
+    sensor_period_ms = period;
+    return ESP_OK;
+}
+
+static esp_err_t sensor_set_timing(int averaging, int bus_ct_us, int shunt_ct_us)
+{
+    int avg = table_index(ina3221_avg_count, sizeof(ina3221_avg_count) / sizeof(ina3221_avg_count[0]), averaging);
+    int bus_ct = table_index(ina3221_ct_us, sizeof(ina3221_ct_us) / sizeof(ina3221_ct_us[0]), bus_ct_us);
+    int shunt_ct = table_index(ina3221_ct_us, sizeof(ina3221_ct_us) / sizeof(ina3221_ct_us[0]), shunt_ct_us);
+    if (avg < 0 || bus_ct < 0 || shunt_ct < 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = ESP_OK;
+    if (sensor_sag_threshold_mv)
+    {
+        // Takes effect when the sag detector is turned off.
+        sensor_sag_saved_config.avg = avg;
+        sensor_sag_saved_config.vbus = bus_ct;
+        sensor_sag_saved_config.vsht = shunt_ct;
+    }
+    else
+    {
+        err = sensor_apply_timing(avg, bus_ct, shunt_ct);
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to apply sensor timing: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    char buf[10];
+    sprintf(buf, "%d", averaging);
+    err = nconfig_write(SENSOR_AVERAGING, buf);
+    if (err == ESP_OK)
+    {
+        sprintf(buf, "%d", bus_ct_us);
+        err = nconfig_write(SENSOR_BUS_CT_US, buf);
+    }
+    if (err == ESP_OK)
+    {
+        sprintf(buf, "%d", shunt_ct_us);
+        err = nconfig_write(SENSOR_SHUNT_CT_US, buf);
+    }
+
+    ESP_LOGI(TAG, "Sensor timing: avg=%d bus=%dus shunt=%dus cycle=%" PRIu32 "us", averaging, bus_ct_us, shunt_ct_us,
+             sensor_conversion_time_us());
+    return err;
+}
+
+esp_err_t update_sensor_timing(int averaging, int bus_ct_us, int shunt_ct_us)
+{
+    xSemaphoreTake(sensor_config_mutex, portMAX_DELAY);
+    esp_err_t err = sensor_set_timing(averaging, bus_ct_us, shunt_ct_us);
+    xSemaphoreGive(sensor_config_mutex);
+    return err;
+}
+
+esp_err_t update_sensor_format(const char* format)
+{
+    bool batch = strcmp(format, "batch") == 0;
+    bool raw = batch || strcmp(format, "raw") == 0;
+    if (!raw && strcmp(format, "float") != 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = nconfig_write(SENSOR_FORMAT, format);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    sensor_raw_format = raw;
+    sensor_batch_format = batch;
+    sensor_batch_enable(batch);
+    return ESP_OK;
+}
+
+const char* sensor_get_format(void)
+{
+    if (sensor_batch_format)
+        return "batch";
+    return sensor_raw_format ? "raw" : "float";
+}
+
+static esp_err_t sensor_set_channels(const char* channels)
+{
+    int mask = sensor_parse_channels(channels);
+    if (mask <= 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The sag detector keeps VIN on until it is turned off.
+    if (sensor_sag_threshold_mv)
+        sensor_sag_saved_mask = mask;
+
+    uint8_t previous = sensor_channel_mask;
+    uint8_t applied = sensor_sag_threshold_mv ? mask | BIT(CHANNEL_VIN) : mask;
+    esp_err_t err = sensor_apply_channels(applied);
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to apply sensor channels: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    char buf[24];
+    sensor_get_channels(buf, sizeof(buf));
+    err = nconfig_write(SENSOR_CHANNELS, buf);
+
+    ESP_LOGI(TAG, "Sensor channels: %s cycle=%" PRIu32 "us", buf, sensor_conversion_time_us());
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT; i++)
+    {
+        // The INA3221 only compares enabled channels against their alert limits.
+        if ((previous & BIT(i)) && !(applied & BIT(i)))
+            push_eventf(EV_WARNING, "%s channel disabled: its current limits are not monitored",
+                        monitor_channels[i].name);
+    }
+    return err;
+}
+
+esp_err_t update_sensor_channels(const char* channels)
+{
+    xSemaphoreTake(sensor_config_mutex, portMAX_DELAY);
+    esp_err_t err = sensor_set_channels(channels);
+    xSemaphoreGive(sensor_config_mutex);
+    return err;
+}
+
+void sensor_get_channels(char* buf, size_t len)
+{
+    size_t pos = 0;
+    uint8_t mask = sensor_sag_threshold_mv ? sensor_sag_saved_mask : sensor_channel_mask;
+    buf[0] = '\0';
+    for (int i = 0; i < SENSOR_CHANNEL_COUNT && pos < len; i++)
+    {
+        if (mask & BIT(i))
+            pos += snprintf(buf + pos, len - pos, "%s%s", pos ? "," : "", channel_config_names[i]);
+    }
+}
+
+uint8_t sensor_get_channel_mask(void)
+{
+    return sensor_channel_mask;
+}
+
+static esp_err_t sensor_set_vin_sag_threshold(int threshold_mv)
+{
+    if (threshold_mv != 0 && (threshold_mv < SAG_THRESHOLD_MIN_MV || threshold_mv > SAG_THRESHOLD_MAX_MV))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = sensor_apply_sag_threshold(threshold_mv);
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to switch the sag detector: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    char buf[10];
+    sprintf(buf, "%d", threshold_mv);
+    return nconfig_write(VIN_SAG_THRESHOLD_MV, buf);
+}
+
+esp_err_t update_vin_sag_threshold(int threshold_mv)
+{
+    xSemaphoreTake(sensor_config_mutex, portMAX_DELAY);
+    esp_err_t err = sensor_set_vin_sag_threshold(threshold_mv);
+    xSemaphoreGive(sensor_config_mutex);
+    return err;
+}
+
+uint16_t sensor_get_vin_sag_threshold(void)
+{
+    return sensor_sag_threshold_mv;
+}
+
+// Has the acquisition task run edge_fn in the middle of a maximum-rate burst on
+// channel_mask, so the recording covers the moment it takes effect. Falls back to
+// calling edge_fn directly when the task is not running or does not pick the request up.
+esp_err_t sensor_burst(uint8_t channel_mask, sensor_burst_edge_fn edge_fn, void* arg)
+{
+    if (acquire_task_handle == NULL || sensor_burst_mutex == NULL || channel_mask == 0)
+    {
+        return edge_fn(arg);
+    }
+
+    xSemaphoreTake(sensor_burst_mutex, portMAX_DELAY);
+    sensor_burst_request.channel_mask = channel_mask;
+    sensor_burst_request.edge_fn = edge_fn;
+    sensor_burst_request.arg = arg;
+    sensor_burst_request.result = ESP_OK;
+    portENTER_CRITICAL(&sensor_burst_lock);
+    sensor_burst_state = SENSOR_BURST_REQUESTED;
+    portEXIT_CRITICAL(&sensor_burst_lock);
+    xTaskNotifyGive(acquire_task_handle);
+
+    if (xSemaphoreTake(sensor_burst_done, pdMS_TO_TICKS(SENSOR_BURST_CLAIM_TIMEOUT_MS)) != pdTRUE)
+    {
+        bool cancelled = false;
+        portENTER_CRITICAL(&sensor_burst_lock);
+        if (sensor_burst_state == SENSOR_BURST_REQUESTED)
+        {
+            sensor_burst_state = SENSOR_BURST_IDLE;
+            cancelled = true;
+        }
+        portEXIT_CRITICAL(&sensor_burst_lock);
+
+        if (cancelled)
+        {
+            xSemaphoreGive(sensor_burst_mutex);
+            ESP_LOGW(TAG, "Acquisition task did not start the burst, switching without a recording");
+            return edge_fn(arg);
+        }
+        // Claimed in the meantime; the edge follows within the baseline.
+        xSemaphoreTake(sensor_burst_done, portMAX_DELAY);
+    }
+
+    esp_err_t err = sensor_burst_request.result;
+    xSemaphoreGive(sensor_burst_mutex);
+    return err;
 }
@@ -9,17 +9,64 @@
 
 #include "esp_http_server.h"
 
-#define SENSOR_BUFFER_SIZE 100
+#define SENSOR_BUFFER_SIZE 2048
+#define SENSOR_CHANNEL_COUNT 3
+#define SENSOR_JITTER_BUCKETS 8
+#define SENSOR_CHANNEL_MASK_ALL 0x7 // bit n = channel n (USB, MAIN, VIN)
 
+// One acquisition in INA3221 register counts, indexed by INA3221 channel (USB, MAIN, VIN).
+// bus_raw is 1 mV/LSB, shunt_raw is 5 uV/LSB (divide by the shunt resistance in mOhm for A).
 typedef struct
 {
-    float voltage;
-    float current;
-    float power;
-    uint32_t timestamp;
+    uint32_t uptime_ms;
+    int16_t bus_raw[SENSOR_CHANNEL_COUNT];
+    int16_t shunt_raw[SENSOR_CHANNEL_COUNT];
 } sensor_data_t;
 
+typedef struct
+{
+    uint32_t conversion_time_us;
+    uint32_t samples;
+    uint32_t missed_deadlines; // conversions overwritten before the acquisition task read them
+    uint32_t ready_timeouts;
+    uint32_t read_errors;
+    uint32_t max_jitter_us;
+    uint32_t jitter_histogram[SENSOR_JITTER_BUCKETS]; // <250us, doubling, last bucket >=16ms
+    uint32_t publish_count;
+    uint32_t publish_overruns;
+    uint32_t scrubs; // background comparisons of the chip against the register shadow
+    uint32_t scrub_errors;
+    uint32_t limit_drift; // scrubs that found and rewrote a changed alert limit
+    uint32_t config_drift;
+} sensor_diagnostics_t;
+
+// INA3221 averaging and conversion times, and what they mean for the acquired data.
+typedef struct
+{
+    uint16_t averaging; // samples averaged per conversion: 1, 4, 16, 64, 128, 256, 512 or 1024
+    uint16_t bus_ct_us; // 140, 204, 332, 588, 1100, 2116, 4156 or 8244
+    uint16_t shunt_ct_us;
+    uint32_t conversion_time_us; // one cycle over all enabled channels
+    float sample_rate_hz; // cycles per second the acquisition task can actually read
+    float noise_floor_ma; // estimated RMS current noise per sample
+} sensor_timing_t;
+
+// Called by the acquisition task at the edge of a burst; see sensor_burst().
+typedef esp_err_t (*sensor_burst_edge_fn)(void* arg);
+
 void init_status_monitor();
 esp_err_t update_sensor_period(int period);
+esp_err_t update_sensor_timing(int averaging, int bus_ct_us, int shunt_ct_us);
+void sensor_get_timing(sensor_timing_t* timing);
+esp_err_t update_sensor_format(const char* format);
+const char* sensor_get_format(void);
+esp_err_t update_sensor_channels(const char* channels);
+void sensor_get_channels(char* buf, size_t len);
+uint8_t sensor_get_channel_mask(void);
+esp_err_t update_vin_sag_threshold(int threshold_mv);
+uint16_t sensor_get_vin_sag_threshold(void);
+esp_err_t sensor_burst(uint8_t channel_mask, sensor_burst_edge_fn edge_fn, void* arg);
+uint16_t sensor_shunt_mohm(uint8_t channel);
+void sensor_get_diagnostics(sensor_diagnostics_t* diagnostics);
 
 #endif // ODROID_REMOTE_HTTP_MONITOR_H
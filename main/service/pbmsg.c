@@ -22,14 +22,23 @@ bool encode_string(pb_ostream_t* stream, const pb_field_t* field, void* const* a
 
 void send_pb_message(const pb_msgdesc_t* fields, const void* src_struct)
 {
-    uint8_t buffer[PB_BUFFER_SIZE];
-    pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
+    if (fields == StatusMessage_fields && !ws_payload_subscribed(((const StatusMessage*)src_struct)->which_payload))
+        return;
+
+    ws_frame_t* frame = ws_frame_alloc(PB_BUFFER_SIZE);
+    if (!frame)
+        return;
 
+    pb_ostream_t stream = pb_ostream_from_buffer(frame->data, frame->capacity);
     if (!pb_encode(&stream, fields, src_struct))
     {
         ESP_LOGE(TAG, "Failed to encode protobuf message: %s", PB_GET_ERROR(&stream));
+        ws_frame_release(frame);
         return;
     }
 
-    push_data_to_ws(buffer, stream.bytes_written);
+    frame->len = stream.bytes_written;
+    if (fields == StatusMessage_fields)
+        frame->payload = ((const StatusMessage*)src_struct)->which_payload;
+    push_frame_to_ws(frame);
 }
\ No newline at end of file
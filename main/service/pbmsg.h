@@ -5,7 +5,7 @@
 #ifndef ODROID_POWER_MATE_PB_H
 #define ODROID_POWER_MATE_PB_H
 
-#define PB_BUFFER_SIZE 256
+#define PB_BUFFER_SIZE 320 // fits SensorStats
 
 #include <stdbool.h>
 
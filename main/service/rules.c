@@ -0,0 +1,511 @@
+#include "rules.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "event.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "nconfig.h"
+#include "sw.h"
+#include "webserver.h"
+
+#define RULES_CONFIG_SIZE 512
+
+static const char* TAG = "rules";
+
+// Long names for the API, short codes for the compact nconfig string.
+static const char* const type_names[] = {"over_voltage", "under_voltage", "over_power", "over_current"};
+static const char* const type_codes[] = {"ov", "uv", "op", "oc"};
+static const char* const type_units[] = {"mV", "mV", "mW", "mA"};
+static const char* const action_names[] = {"event", "cut_main", "cut_usb", "power_cycle"};
+static const char* const action_codes[] = {"ev", "main", "usb", "cycle"};
+static const char* const channel_names[SENSOR_CHANNEL_COUNT] = {"usb", "main", "vin"};
+static const char* const channel_labels[SENSOR_CHANNEL_COUNT] = {"USB", "MAIN", "VIN"};
+
+#define TYPE_COUNT (sizeof(type_names) / sizeof(type_names[0]))
+#define ACTION_COUNT (sizeof(action_names) / sizeof(action_names[0]))
+
+// A rule with its limits converted to raw register units so evaluation is integer only.
+typedef struct
+{
+    rule_t rule;
+    int64_t trip_raw;
+    int64_t clear_raw;
+    bool active;
+    bool pending;
+    uint32_t pending_since_ms;
+    int64_t trip_value_raw;
+} compiled_rule_t;
+
+static compiled_rule_t rules[RULES_MAX];
+static uint8_t rule_count;
+static uint32_t pending_fired;
+static uint32_t pending_cleared;
+static uint32_t eval_us_last;
+static uint32_t eval_us_max;
+static portMUX_TYPE rules_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t rules_task_handle;
+
+// bus_raw is mV, shunt_raw is 5 uV/LSB, power raw is bus_raw * shunt_raw.
+static int64_t user_to_raw(enum rule_type type, uint8_t channel, int64_t value)
+{
+    int64_t mohm = sensor_shunt_mohm(channel);
+    switch (type)
+    {
+    case RULE_OVER_CURRENT:
+        return value * mohm / 5;
+    case RULE_OVER_POWER:
+        return value * mohm * 200;
+    default:
+        return value;
+    }
+}
+
+static int64_t raw_to_user(enum rule_type type, uint8_t channel, int64_t raw)
+{
+    int64_t mohm = sensor_shunt_mohm(channel);
+    switch (type)
+    {
+    case RULE_OVER_CURRENT:
+        return raw * 5 / mohm;
+    case RULE_OVER_POWER:
+        return raw / (mohm * 200);
+    default:
+        return raw;
+    }
+}
+
+static void compile_rule(compiled_rule_t* out, const rule_t* rule)
+{
+    memset(out, 0, sizeof(*out));
+    out->rule = *rule;
+    out->trip_raw = user_to_raw(rule->type, rule->channel, rule->threshold);
+    int64_t clear = rule->type == RULE_UNDER_VOLTAGE ? rule->threshold + rule->hysteresis
+                                                     : rule->threshold - rule->hysteresis;
+    out->clear_raw = user_to_raw(rule->type, rule->channel, clear);
+}
+
+static int find_name(const char* const* names, size_t count, const char* name)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (strcmp(names[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+static bool rule_valid(const rule_t* rule)
+{
+    // Over rules clear at threshold - hysteresis, which must not go below zero.
+    return rule->type < TYPE_COUNT && rule->channel < SENSOR_CHANNEL_COUNT && rule->action < ACTION_COUNT &&
+           rule->threshold >= 0 && rule->threshold <= 1000000 && rule->hysteresis >= 0 &&
+           rule->duration_ms <= RULES_DURATION_MAX_MS &&
+           (rule->type == RULE_UNDER_VOLTAGE ? rule->hysteresis <= 1000000 : rule->hysteresis <= rule->threshold);
+}
+
+// Parses "type,channel,threshold,hysteresis,duration_ms,action;..." e.g. "oc,main,2500,200,100,main".
+static int parse_rules(const char* config, rule_t* out, int max)
+{
+    char buf[RULES_CONFIG_SIZE];
+    strncpy(buf, config, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    int count = 0;
+    char* save = NULL;
+    for (char* item = strtok_r(buf, ";", &save); item; item = strtok_r(NULL, ";", &save))
+    {
+        char type[4], channel[6], action[8];
+        long threshold, hysteresis;
+        unsigned long duration;
+        if (sscanf(item, "%3[^,],%5[^,],%ld,%ld,%lu,%7s", type, channel, &threshold, &hysteresis, &duration,
+                   action) != 6)
+            return -1;
+        if (count >= max)
+            return -1;
+
+        int t = find_name(type_codes, TYPE_COUNT, type);
+        int c = find_name(channel_names, SENSOR_CHANNEL_COUNT, channel);
+        int a = find_name(action_codes, ACTION_COUNT, action);
+        if (t < 0 || c < 0 || a < 0)
+            return -1;
+
+        rule_t* rule = &out[count++];
+        rule->type = t;
+        rule->channel = c;
+        rule->threshold = threshold;
+        rule->hysteresis = hysteresis;
+        rule->duration_ms = duration;
+        rule->action = a;
+        if (!rule_valid(rule))
+            return -1;
+    }
+    return count;
+}
+
+static void format_rules(const rule_t* in, int count, char* buf, size_t len)
+{
+    size_t pos = 0;
+    buf[0] = '\0';
+    for (int i = 0; i < count && pos < len; i++)
+    {
+        pos += snprintf(buf + pos, len - pos, "%s%s,%s,%ld,%ld,%lu,%s", i ? ";" : "", type_codes[in[i].type],
+                        channel_names[in[i].channel], (long)in[i].threshold, (long)in[i].hysteresis,
+                        (unsigned long)in[i].duration_ms, action_codes[in[i].action]);
+    }
+}
+
+static void apply_rules(const rule_t* in, int count)
+{
+    compiled_rule_t compiled[RULES_MAX];
+    for (int i = 0; i < count; i++)
+        compile_rule(&compiled[i], &in[i]);
+
+    portENTER_CRITICAL(&rules_lock);
+    memcpy(rules, compiled, sizeof(compiled_rule_t) * count);
+    rule_count = count;
+    pending_fired = 0;
+    pending_cleared = 0;
+    portEXIT_CRITICAL(&rules_lock);
+}
+
+static esp_err_t store_rules(const rule_t* in, int count)
+{
+    char buf[RULES_CONFIG_SIZE];
+    format_rules(in, count, buf, sizeof(buf));
+    esp_err_t err = nconfig_write(RULES_CONFIG, buf);
+    if (err != ESP_OK)
+        return err;
+
+    apply_rules(in, count);
+    ESP_LOGI(TAG, "Rule table updated: %d rule(s)", count);
+    return ESP_OK;
+}
+
+// Called by the acquisition task for every conversion; integer compares only.
+void rules_evaluate(const sensor_data_t* sample)
+{
+    int64_t start_us = esp_timer_get_time();
+    uint32_t fired = 0;
+    uint32_t cleared = 0;
+    uint8_t enabled = sensor_get_channel_mask();
+
+    portENTER_CRITICAL(&rules_lock);
+    for (int i = 0; i < rule_count; i++)
+    {
+        compiled_rule_t* r = &rules[i];
+        uint8_t ch = r->rule.channel;
+        // A disabled channel reads 0, which would trip every under-voltage rule on it.
+        if (!(enabled & BIT(ch)))
+        {
+            r->pending = false;
+            continue;
+        }
+        int64_t value;
+        switch (r->rule.type)
+        {
+        case RULE_OVER_CURRENT:
+            value = sample->shunt_raw[ch];
+            break;
+        case RULE_OVER_POWER:
+            value = (int32_t)sample->bus_raw[ch] * sample->shunt_raw[ch];
+            break;
+        default:
+            value = sample->bus_raw[ch];
+            break;
+        }
+
+        bool under = r->rule.type == RULE_UNDER_VOLTAGE;
+        if (!r->active)
+        {
+            if (under ? value < r->trip_raw : value > r->trip_raw)
+            {
+                if (!r->pending)
+                {
+                    r->pending = true;
+                    r->pending_since_ms = sample->uptime_ms;
+                }
+                if (sample->uptime_ms - r->pending_since_ms >= r->rule.duration_ms)
+                {
+                    r->active = true;
+                    r->pending = false;
+                    r->trip_value_raw = value;
+                    fired |= 1 << i;
+                }
+            }
+            else
+            {
+                r->pending = false;
+            }
+        }
+        else if (under ? value > r->clear_raw : value < r->clear_raw)
+        {
+            r->active = false;
+            cleared |= 1 << i;
+        }
+    }
+    pending_fired |= fired;
+    pending_cleared |= cleared;
+    portEXIT_CRITICAL(&rules_lock);
+
+    if ((fired || cleared) && rules_task_handle)
+        xTaskNotifyGive(rules_task_handle);
+
+    uint32_t elapsed_us = esp_timer_get_time() - start_us;
+    eval_us_last = elapsed_us;
+    if (elapsed_us > eval_us_max)
+        eval_us_max = elapsed_us;
+}
+
+static void run_action(const rule_t* rule)
+{
+    esp_err_t err = ESP_OK;
+    switch (rule->action)
+    {
+    case RULE_ACTION_CUT_MAIN:
+        err = set_main_load_switch(false);
+        break;
+    case RULE_ACTION_CUT_USB:
+        err = set_usb_load_switch(false);
+        break;
+    case RULE_ACTION_POWER_CYCLE:
+    {
+        bool main_on = get_main_load_switch();
+        bool usb_on = get_usb_load_switch();
+        err = set_load_switches(false, false);
+        if (err != ESP_OK)
+            break;
+        vTaskDelay(pdMS_TO_TICKS(RULES_POWER_CYCLE_OFF_MS));
+        err = set_load_switches(main_on, usb_on);
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "rule action %s failed: %s", action_names[rule->action], esp_err_to_name(err));
+        push_eventf(EV_WARNING, "rule action %s failed: %s", action_names[rule->action], esp_err_to_name(err));
+    }
+}
+
+// Actions touch the I/O expander and may sleep, so they run here instead of in the
+// acquisition task.
+static void rules_task(void* pvParameters)
+{
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        compiled_rule_t snapshot[RULES_MAX];
+        portENTER_CRITICAL(&rules_lock);
+        uint32_t fired = pending_fired;
+        uint32_t cleared = pending_cleared;
+        pending_fired = 0;
+        pending_cleared = 0;
+        memcpy(snapshot, rules, sizeof(compiled_rule_t) * rule_count);
+        portEXIT_CRITICAL(&rules_lock);
+
+        for (int i = 0; i < RULES_MAX; i++)
+        {
+            const rule_t* rule = &snapshot[i].rule;
+            if (fired & (1 << i))
+            {
+                long value = raw_to_user(rule->type, rule->channel, snapshot[i].trip_value_raw);
+                ESP_LOGW(TAG, "rule %d fired: %s %s %ld%s (limit %ld%s), action %s", i,
+                         channel_labels[rule->channel], type_names[rule->type], value, type_units[rule->type],
+                         (long)rule->threshold, type_units[rule->type], action_names[rule->action]);
+                push_eventf(EV_WARNING, "rule %d fired: %s %s %ld%s (limit %ld%s), action %s", i,
+                            channel_labels[rule->channel], type_names[rule->type], value, type_units[rule->type],
+                            (long)rule->threshold, type_units[rule->type], action_names[rule->action]);
+                run_action(rule);
+            }
+            if (cleared & (1 << i))
+                push_eventf(EV_INFO, "rule %d cleared: %s %s", i, channel_labels[rule->channel],
+                            type_names[rule->type]);
+        }
+    }
+}
+
+void rules_init(void)
+{
+    char buf[RULES_CONFIG_SIZE];
+    rule_t loaded[RULES_MAX];
+    if (nconfig_read(RULES_CONFIG, buf, sizeof(buf)) == ESP_OK)
+    {
+        int count = parse_rules(buf, loaded, RULES_MAX);
+        if (count < 0)
+            ESP_LOGW(TAG, "Ignoring malformed rule table");
+        else
+            apply_rules(loaded, count);
+    }
+
+    xTaskCreate(rules_task, "rules_task", configMINIMAL_STACK_SIZE * 4, NULL, 10, &rules_task_handle);
+}
+
+static esp_err_t rules_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    compiled_rule_t snapshot[RULES_MAX];
+    portENTER_CRITICAL(&rules_lock);
+    int count = rule_count;
+    memcpy(snapshot, rules, sizeof(compiled_rule_t) * count);
+    portEXIT_CRITICAL(&rules_lock);
+
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddNumberToObject(root, "max_rules", RULES_MAX);
+    cJSON_AddNumberToObject(root, "eval_us_last", eval_us_last);
+    cJSON_AddNumberToObject(root, "eval_us_max", eval_us_max);
+    cJSON* list = cJSON_AddArrayToObject(root, "rules");
+    for (int i = 0; list && i < count; i++)
+    {
+        const rule_t* rule = &snapshot[i].rule;
+        cJSON* item = cJSON_CreateObject();
+        if (!item)
+            break;
+        cJSON_AddStringToObject(item, "type", type_names[rule->type]);
+        cJSON_AddStringToObject(item, "channel", channel_names[rule->channel]);
+        cJSON_AddNumberToObject(item, "threshold", rule->threshold);
+        cJSON_AddNumberToObject(item, "hysteresis", rule->hysteresis);
+        cJSON_AddStringToObject(item, "unit", type_units[rule->type]);
+        cJSON_AddNumberToObject(item, "duration_ms", rule->duration_ms);
+        cJSON_AddStringToObject(item, "action", action_names[rule->action]);
+        cJSON_AddBoolToObject(item, "active", snapshot[i].active);
+        cJSON_AddItemToArray(list, item);
+    }
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+static bool parse_json_rule(const cJSON* item, rule_t* rule)
+{
+    const cJSON* type = cJSON_GetObjectItem(item, "type");
+    const cJSON* channel = cJSON_GetObjectItem(item, "channel");
+    const cJSON* threshold = cJSON_GetObjectItem(item, "threshold");
+    const cJSON* hysteresis = cJSON_GetObjectItem(item, "hysteresis");
+    const cJSON* duration = cJSON_GetObjectItem(item, "duration_ms");
+    const cJSON* action = cJSON_GetObjectItem(item, "action");
+    if (!cJSON_IsString(type) || !cJSON_IsString(channel) || !cJSON_IsNumber(threshold) ||
+        (hysteresis && !cJSON_IsNumber(hysteresis)) || (duration && !cJSON_IsNumber(duration)) ||
+        (action && !cJSON_IsString(action)))
+        return false;
+
+    int t = find_name(type_names, TYPE_COUNT, type->valuestring);
+    int c = find_name(channel_names, SENSOR_CHANNEL_COUNT, channel->valuestring);
+    int a = action ? find_name(action_names, ACTION_COUNT, action->valuestring) : RULE_ACTION_EVENT;
+    if (t < 0 || c < 0 || a < 0)
+        return false;
+    // Range first: converting a double outside uint32_t is undefined.
+    if (duration && (duration->valuedouble < 0 || duration->valuedouble > RULES_DURATION_MAX_MS ||
+                     duration->valuedouble != (uint32_t)duration->valuedouble))
+        return false;
+
+    rule->type = t;
+    rule->channel = c;
+    rule->threshold = threshold->valueint;
+    rule->hysteresis = hysteresis ? hysteresis->valueint : 0;
+    rule->duration_ms = duration ? (uint32_t)duration->valuedouble : 0;
+    rule->action = a;
+    return rule_valid(rule);
+}
+
+static esp_err_t rules_post_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    char buf[1536];
+    int ret, remaining = req->content_len;
+
+    if (remaining >= sizeof(buf))
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Request content too long");
+        return ESP_FAIL;
+    }
+
+    ret = httpd_req_recv(req, buf, remaining);
+    if (ret <= 0)
+    {
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(req);
+        return ESP_FAIL;
+    }
+    buf[ret] = '\0';
+
+    cJSON* root = cJSON_Parse(buf);
+    if (root == NULL)
+    {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid JSON format");
+        return ESP_FAIL;
+    }
+
+    const cJSON* list = cJSON_GetObjectItem(root, "rules");
+    if (!cJSON_IsArray(list) || cJSON_GetArraySize(list) > RULES_MAX)
+    {
+        cJSON_Delete(root);
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "rules must be an array of at most 8 rules");
+        return ESP_FAIL;
+    }
+
+    rule_t parsed[RULES_MAX];
+    int count = 0;
+    const cJSON* item;
+    cJSON_ArrayForEach(item, list)
+    {
+        if (!parse_json_rule(item, &parsed[count]))
+        {
+            cJSON_Delete(root);
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Invalid rule");
+            return ESP_FAIL;
+        }
+        count++;
+    }
+    cJSON_Delete(root);
+
+    err = store_rules(parsed, count);
+    if (err != ESP_OK)
+    {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save rules");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_sendstr(req, "{\"status\":\"ok\"}");
+    return ESP_OK;
+}
+
+void register_rules_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {.uri = "/api/rules", .method = HTTP_GET, .handler = rules_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+
+    httpd_uri_t post_uri = {.uri = "/api/rules", .method = HTTP_POST, .handler = rules_post_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &post_uri);
+}
@@ -0,0 +1,43 @@
+#ifndef ODROID_POWER_MATE_RULES_H
+#define ODROID_POWER_MATE_RULES_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "monitor.h"
+
+#define RULES_MAX 8
+#define RULES_POWER_CYCLE_OFF_MS 2000
+#define RULES_DURATION_MAX_MS 3600000
+
+enum rule_type
+{
+    RULE_OVER_VOLTAGE = 0,
+    RULE_UNDER_VOLTAGE = 1,
+    RULE_OVER_POWER = 2,
+    RULE_OVER_CURRENT = 3, // with duration_ms this is "sustained current for N ms"
+};
+
+enum rule_action
+{
+    RULE_ACTION_EVENT = 0,
+    RULE_ACTION_CUT_MAIN = 1,
+    RULE_ACTION_CUT_USB = 2,
+    RULE_ACTION_POWER_CYCLE = 3,
+};
+
+// One rule in user units: mV for voltage, mA for current, mW for power.
+typedef struct
+{
+    enum rule_type type;
+    uint8_t channel; // 0 = USB, 1 = MAIN, 2 = VIN
+    int32_t threshold;
+    int32_t hysteresis;
+    uint32_t duration_ms; // condition must hold this long before the rule fires
+    enum rule_action action;
+} rule_t;
+
+void rules_init(void);
+void rules_evaluate(const sensor_data_t* sample);
+
+#endif // ODROID_POWER_MATE_RULES_H
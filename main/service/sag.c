@@ -0,0 +1,160 @@
+#include "sag.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "event.h"
+#include "freertos/FreeRTOS.h"
+
+#define SAG_CHANNEL_VIN 2
+#define SAG_BASELINE_SHIFT 4 // baseline is an EMA over 16 conversions outside sags
+
+static const char* TAG = "sag";
+
+typedef struct
+{
+    uint32_t uptime_ms;
+    uint32_t duration_us;
+    uint16_t min_mv;
+    uint16_t baseline_mv;
+    uint16_t gaps;
+} sag_record_t;
+
+static struct
+{
+    bool active;
+    int64_t start_us;
+    int64_t last_us;
+    int64_t last_watch_end_us;
+    int32_t baseline_acc; // baseline mV << SAG_BASELINE_SHIFT, 0 until the first conversion
+    sag_record_t current;
+} sag_state;
+
+static sag_diagnostics_t sag_diagnostics;
+static sag_record_t pending_sag;
+static uint32_t pending_count; // sags finished since the last report
+static portMUX_TYPE sag_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void sag_configure(uint16_t threshold_mv)
+{
+    portENTER_CRITICAL(&sag_lock);
+    memset(&sag_state, 0, sizeof(sag_state));
+    sag_diagnostics.threshold_mv = threshold_mv;
+    sag_diagnostics.watched_us = 0;
+    sag_diagnostics.elapsed_us = 0;
+    portEXIT_CRITICAL(&sag_lock);
+}
+
+static void sag_finish(int64_t end_us)
+{
+    sag_record_t* sag = &sag_state.current;
+    sag->duration_us = (uint32_t)(end_us - sag_state.start_us);
+
+    sag_diagnostics.count++;
+    if (!sag_diagnostics.deepest_mv || sag->min_mv < sag_diagnostics.deepest_mv)
+        sag_diagnostics.deepest_mv = sag->min_mv;
+    if (sag->duration_us > sag_diagnostics.longest_us)
+        sag_diagnostics.longest_us = sag->duration_us;
+    sag_diagnostics.last_uptime_ms = sag->uptime_ms;
+    sag_diagnostics.last_min_mv = sag->min_mv;
+    sag_diagnostics.last_duration_us = sag->duration_us;
+
+    // Only the newest sag per report gets its own event.
+    if (pending_count)
+        sag_diagnostics.events_folded++;
+    pending_sag = *sag;
+    pending_count++;
+    sag_state.active = false;
+}
+
+// A sag starts at the first conversion below the threshold and ends at the first one back
+// above threshold + SAG_HYSTERESIS_MV, so its duration is accurate to about one conversion
+// when no poll gap falls inside it.
+void sag_add(const sensor_data_t* sample, int64_t conversion_us)
+{
+    int32_t mv = sample->bus_raw[SAG_CHANNEL_VIN] > 0 ? sample->bus_raw[SAG_CHANNEL_VIN] : 0;
+
+    portENTER_CRITICAL(&sag_lock);
+    uint16_t threshold_mv = sag_diagnostics.threshold_mv;
+    if (!threshold_mv)
+    {
+        portEXIT_CRITICAL(&sag_lock);
+        return;
+    }
+
+    bool gap = sag_state.last_us && conversion_us - sag_state.last_us > SAG_GAP_US;
+    sag_state.last_us = conversion_us;
+    sag_diagnostics.conversions++;
+
+    if (sag_state.active)
+    {
+        sag_record_t* sag = &sag_state.current;
+        if (gap)
+            sag->gaps++;
+        if (mv < sag->min_mv)
+            sag->min_mv = mv;
+        if (mv > threshold_mv + SAG_HYSTERESIS_MV)
+            sag_finish(conversion_us);
+    }
+    else if (mv < threshold_mv)
+    {
+        sag_state.active = true;
+        sag_state.start_us = conversion_us;
+        sag_state.current = (sag_record_t){
+            .uptime_ms = (uint32_t)(conversion_us / 1000),
+            .min_mv = mv,
+            .baseline_mv = sag_state.baseline_acc >> SAG_BASELINE_SHIFT,
+            .gaps = gap,
+        };
+    }
+    else if (!sag_state.baseline_acc)
+    {
+        sag_state.baseline_acc = mv << SAG_BASELINE_SHIFT;
+    }
+    else
+    {
+        sag_state.baseline_acc += mv - (sag_state.baseline_acc >> SAG_BASELINE_SHIFT);
+    }
+    portEXIT_CRITICAL(&sag_lock);
+}
+
+void sag_watch(int64_t start_us, int64_t end_us)
+{
+    portENTER_CRITICAL(&sag_lock);
+    sag_diagnostics.watched_us += end_us - start_us;
+    sag_diagnostics.elapsed_us += end_us - (sag_state.last_watch_end_us ? sag_state.last_watch_end_us : start_us);
+    sag_state.last_watch_end_us = end_us;
+    portEXIT_CRITICAL(&sag_lock);
+}
+
+void sag_report_if_pending(void)
+{
+    portENTER_CRITICAL(&sag_lock);
+    sag_record_t sag = pending_sag;
+    uint32_t count = pending_count;
+    uint16_t threshold_mv = sag_diagnostics.threshold_mv;
+    pending_count = 0;
+    portEXIT_CRITICAL(&sag_lock);
+
+    if (!count)
+        return;
+
+    int depth_mv = sag.baseline_mv > sag.min_mv ? sag.baseline_mv - sag.min_mv : 0;
+    ESP_LOGW(TAG, "vin sag: min=%umV depth=%dmV duration=%" PRIu32 "us baseline=%umV threshold=%umV gaps=%u "
+             "uptime=%" PRIu32 "ms folded=%" PRIu32, sag.min_mv, depth_mv, sag.duration_us, sag.baseline_mv,
+             threshold_mv, sag.gaps, sag.uptime_ms, count - 1);
+    push_eventf(EV_WARNING, "vin sag: min=%umV depth=%dmV duration=%" PRIu32 "us baseline=%umV threshold=%umV "
+                "gaps=%u uptime=%" PRIu32 "ms folded=%" PRIu32, sag.min_mv, depth_mv, sag.duration_us,
+                sag.baseline_mv, threshold_mv, sag.gaps, sag.uptime_ms, count - 1);
+}
+
+void sag_get_diagnostics(sag_diagnostics_t* diagnostics)
+{
+    if (!diagnostics)
+        return;
+
+    portENTER_CRITICAL(&sag_lock);
+    *diagnostics = sag_diagnostics;
+    portEXIT_CRITICAL(&sag_lock);
+}
@@ -0,0 +1,39 @@
+#ifndef ODROID_POWER_MATE_SAG_H
+#define ODROID_POWER_MATE_SAG_H
+
+#include <stdint.h>
+
+#include "monitor.h"
+
+#define SAG_THRESHOLD_MIN_MV 1000
+#define SAG_THRESHOLD_MAX_MV 26000 // INA3221 bus input range
+#define SAG_HYSTERESIS_MV 100 // a sag ends once VIN is back above threshold + hysteresis
+#define SAG_POLL_WINDOW_US 1000 // busy-polled per tick; the rest of the tick is not watched
+#define SAG_GAP_US 1200 // VIN conversions further apart than this (840 us cycle) left part of the sag unobserved
+
+typedef struct
+{
+    uint16_t threshold_mv; // 0 while the detector is off
+    uint32_t count;
+    uint32_t events_folded; // sags reported only as part of a later event
+    uint16_t deepest_mv; // lowest VIN seen during any sag, 0 if none yet
+    uint32_t longest_us;
+    uint32_t last_uptime_ms;
+    uint16_t last_min_mv;
+    uint32_t last_duration_us;
+    uint32_t conversions;
+    uint64_t watched_us; // time spent polling conversions
+    uint64_t elapsed_us; // time since the detector was turned on
+} sag_diagnostics_t;
+
+void sag_configure(uint16_t threshold_mv);
+
+// Called by the acquisition task for every VIN conversion and every poll window.
+void sag_add(const sensor_data_t* sample, int64_t conversion_us);
+void sag_watch(int64_t start_us, int64_t end_us);
+
+// Called by the publish task; emits finished sags as events.
+void sag_report_if_pending(void);
+void sag_get_diagnostics(sag_diagnostics_t* diagnostics);
+
+#endif // ODROID_POWER_MATE_SAG_H
@@ -12,15 +12,13 @@
 #include "esp_timer.h"
 #include "monitor.h"
 #include "nconfig.h"
+#include "stats.h"
 #include "sw.h"
 #include "webserver.h"
 #include "wifi.h"
 
 static const char* TAG = "webserver";
 
-typedef esp_err_t (*climit_set_fn_t)(double value);
-typedef esp_err_t (*climit_get_fn_t)(float* limit_a, uint16_t* raw);
-
 static const char* climit_display_name(const char* name)
 {
     if (strcmp(name, "vin") == 0)
@@ -80,9 +78,10 @@ static bool validate_climit_pair(cJSON* limit_item, cJSON* critical_item, const
     return false;
 }
 
-static bool handle_climit_item(cJSON* item, const char* key, const char* name, const char* label, double min_value,
-                               double max_value, bool allow_zero, enum nconfig_type config_type, climit_set_fn_t set_fn,
-                               climit_get_fn_t get_fn, cJSON* results, bool* any_success, bool* any_failure)
+// Validates one requested limit and stages it; the batch is written once all items are staged.
+static bool stage_climit_item(cJSON* item, const char* key, const char* name, const char* label, double min_value,
+                              double max_value, bool allow_zero, enum climit_slot slot, climit_batch_t* batch,
+                              cJSON* results, bool* any_failure)
 {
     if (!item)
         return false;
@@ -118,33 +117,37 @@ static bool handle_climit_item(cJSON* item, const char* key, const char* name, c
         return true;
     }
 
-    esp_err_t err = set_fn(val);
-    if (err != ESP_OK)
-    {
-        cJSON_AddStringToObject(result, "status", "error");
-        cJSON_AddStringToObject(result, "error", esp_err_to_name(err));
-        ESP_LOGW(TAG, "%s %s set failed: requested=%.3fA, error=%s", display_name, label, val,
-                 esp_err_to_name(err));
-        push_eventf(EV_WARNING, "%s %s set failed: requested=%.3fA, error=%s", display_name, label, val,
-                    esp_err_to_name(err));
-        *any_failure = true;
-        return true;
-    }
+    climit_batch_stage(batch, slot, val);
+    return true;
+}
+
+static void finish_climit_item(const char* key, const char* name, const char* label, enum climit_slot slot,
+                               enum nconfig_type config_type, const climit_batch_t* batch,
+                               const climit_batch_result_t* applied, cJSON* results, bool* any_success,
+                               bool* any_failure)
+{
+    if (!(batch->staged & (1u << slot)))
+        return;
+
+    const char* display_name = climit_display_name(name);
+    cJSON* result = cJSON_GetObjectItem(results, key);
+    double val = batch->value[slot];
 
-    float applied_a = 0.0f;
-    err = get_fn(&applied_a, NULL);
+    // The batch already pushed one event covering every failed slot.
+    esp_err_t err = applied->err[slot];
     if (err != ESP_OK)
     {
         cJSON_AddStringToObject(result, "status", "error");
         cJSON_AddStringToObject(result, "error", esp_err_to_name(err));
-        ESP_LOGW(TAG, "%s %s readback failed: requested=%.3fA, error=%s", display_name, label, val,
+        if (applied->readback)
+            cJSON_AddNumberToObject(result, "applied_a", applied->applied_a[slot]);
+        ESP_LOGW(TAG, "%s %s set failed: requested=%.3fA, error=%s", display_name, label, val,
                  esp_err_to_name(err));
-        push_eventf(EV_WARNING, "%s %s readback failed: requested=%.3fA, error=%s", display_name, label, val,
-                    esp_err_to_name(err));
         *any_failure = true;
-        return true;
+        return;
     }
 
+    float applied_a = applied->applied_a[slot];
     char num_buf[10];
     snprintf(num_buf, sizeof(num_buf), "%.2f", val);
     err = nconfig_write(config_type, num_buf);
@@ -158,13 +161,24 @@ static bool handle_climit_item(cJSON* item, const char* key, const char* name, c
         push_eventf(EV_WARNING, "%s %s save failed: requested=%.3fA, applied=%.3fA, error=%s", display_name, label,
                     val, applied_a, esp_err_to_name(err));
         *any_failure = true;
-        return true;
+        return;
     }
 
     cJSON_AddStringToObject(result, "status", "ok");
     cJSON_AddNumberToObject(result, "applied_a", applied_a);
     *any_success = true;
-    return true;
+}
+
+static void add_sensor_timing(cJSON* root)
+{
+    sensor_timing_t timing;
+    sensor_get_timing(&timing);
+    cJSON_AddNumberToObject(root, "sensor_averaging", timing.averaging);
+    cJSON_AddNumberToObject(root, "sensor_bus_ct_us", timing.bus_ct_us);
+    cJSON_AddNumberToObject(root, "sensor_shunt_ct_us", timing.shunt_ct_us);
+    cJSON_AddNumberToObject(root, "sensor_conversion_time_us", timing.conversion_time_us);
+    cJSON_AddNumberToObject(root, "sensor_sample_rate_hz", timing.sample_rate_hz);
+    cJSON_AddNumberToObject(root, "sensor_noise_floor_ma", timing.noise_floor_ma);
 }
 
 static esp_err_t setting_get_handler(httpd_req_t* req)
@@ -220,6 +234,12 @@ static esp_err_t setting_get_handler(httpd_req_t* req)
         cJSON_AddStringToObject(root, "period", buf);
     }
 
+    add_sensor_timing(root);
+    cJSON_AddStringToObject(root, "sensor_format", sensor_get_format());
+    sensor_get_channels(buf, sizeof(buf));
+    cJSON_AddStringToObject(root, "sensor_channels", buf);
+    cJSON_AddNumberToObject(root, "vin_sag_threshold_mv", sensor_get_vin_sag_threshold());
+    cJSON_AddStringToObject(root, "stats_stream", stats_get_stream());
     cJSON_AddBoolToObject(root, "restore_output_state", get_restore_output_state());
 
     // Add current limits to the response
@@ -368,6 +388,13 @@ static esp_err_t setting_post_handler(httpd_req_t* req)
     cJSON* ssid_item = cJSON_GetObjectItem(root, "ssid");
     cJSON* baud_item = cJSON_GetObjectItem(root, "baudrate");
     cJSON* period_item = cJSON_GetObjectItem(root, "period");
+    cJSON* sensor_avg_item = cJSON_GetObjectItem(root, "sensor_averaging");
+    cJSON* sensor_bus_ct_item = cJSON_GetObjectItem(root, "sensor_bus_ct_us");
+    cJSON* sensor_shunt_ct_item = cJSON_GetObjectItem(root, "sensor_shunt_ct_us");
+    cJSON* sensor_format_item = cJSON_GetObjectItem(root, "sensor_format");
+    cJSON* sensor_channels_item = cJSON_GetObjectItem(root, "sensor_channels");
+    cJSON* vin_sag_item = cJSON_GetObjectItem(root, "vin_sag_threshold_mv");
+    cJSON* stats_stream_item = cJSON_GetObjectItem(root, "stats_stream");
     cJSON* restore_output_state_item = cJSON_GetObjectItem(root, "restore_output_state");
     cJSON* vin_climit_item = cJSON_GetObjectItem(root, "vin_current_limit");
     cJSON* main_climit_item = cJSON_GetObjectItem(root, "main_current_limit");
@@ -510,6 +537,109 @@ static esp_err_t setting_post_handler(httpd_req_t* req)
         action_taken = true;
     }
 
+    if (sensor_avg_item || sensor_bus_ct_item || sensor_shunt_ct_item)
+    {
+        action_taken = true;
+        // Fields left out keep their current value.
+        sensor_timing_t timing;
+        sensor_get_timing(&timing);
+        if ((sensor_avg_item && !cJSON_IsNumber(sensor_avg_item)) ||
+            (sensor_bus_ct_item && !cJSON_IsNumber(sensor_bus_ct_item)) ||
+            (sensor_shunt_ct_item && !cJSON_IsNumber(sensor_shunt_ct_item)))
+        {
+            err = ESP_ERR_INVALID_ARG;
+        }
+        else
+        {
+            int avg = sensor_avg_item ? sensor_avg_item->valueint : timing.averaging;
+            int bus_ct = sensor_bus_ct_item ? sensor_bus_ct_item->valueint : timing.bus_ct_us;
+            int shunt_ct = sensor_shunt_ct_item ? sensor_shunt_ct_item->valueint : timing.shunt_ct_us;
+            ESP_LOGI(TAG, "Received sensor timing set request: avg=%d bus=%dus shunt=%dus", avg, bus_ct, shunt_ct);
+            err = update_sensor_timing(avg, bus_ct, shunt_ct);
+        }
+
+        if (err == ESP_OK)
+        {
+            cJSON_AddStringToObject(resp_root, "sensor_timing_status", "updated");
+        }
+        else
+        {
+            cJSON_AddStringToObject(resp_root, "sensor_timing_status",
+                                    err == ESP_ERR_INVALID_ARG ? "invalid" : esp_err_to_name(err));
+            cJSON_AddStringToObject(resp_root, "status", "error");
+        }
+    }
+
+    if (sensor_format_item)
+    {
+        action_taken = true;
+        err = cJSON_IsString(sensor_format_item) ? update_sensor_format(sensor_format_item->valuestring)
+                                                 : ESP_ERR_INVALID_ARG;
+        if (err == ESP_OK)
+        {
+            cJSON_AddStringToObject(resp_root, "sensor_format_status", "updated");
+        }
+        else
+        {
+            cJSON_AddStringToObject(resp_root, "sensor_format_status",
+                                    err == ESP_ERR_INVALID_ARG ? "invalid" : esp_err_to_name(err));
+            cJSON_AddStringToObject(resp_root, "status", "error");
+        }
+    }
+
+    if (sensor_channels_item)
+    {
+        action_taken = true;
+        err = cJSON_IsString(sensor_channels_item) ? update_sensor_channels(sensor_channels_item->valuestring)
+                                                   : ESP_ERR_INVALID_ARG;
+        if (err == ESP_OK)
+        {
+            cJSON_AddStringToObject(resp_root, "sensor_channels_status", "updated");
+        }
+        else
+        {
+            cJSON_AddStringToObject(resp_root, "sensor_channels_status",
+                                    err == ESP_ERR_INVALID_ARG ? "invalid" : esp_err_to_name(err));
+            cJSON_AddStringToObject(resp_root, "status", "error");
+        }
+    }
+
+    if (vin_sag_item)
+    {
+        action_taken = true;
+        err = cJSON_IsNumber(vin_sag_item) ? update_vin_sag_threshold(vin_sag_item->valueint) : ESP_ERR_INVALID_ARG;
+        if (err == ESP_OK)
+        {
+            cJSON_AddStringToObject(resp_root, "vin_sag_status", "updated");
+        }
+        else
+        {
+            cJSON_AddStringToObject(resp_root, "vin_sag_status",
+                                    err == ESP_ERR_INVALID_ARG ? "invalid" : esp_err_to_name(err));
+            cJSON_AddStringToObject(resp_root, "status", "error");
+        }
+    }
+
+    if (sensor_avg_item || sensor_bus_ct_item || sensor_shunt_ct_item || sensor_channels_item || vin_sag_item)
+        add_sensor_timing(resp_root);
+
+    if (stats_stream_item)
+    {
+        action_taken = true;
+        err = cJSON_IsString(stats_stream_item) ? update_stats_stream(stats_stream_item->valuestring)
+                                                : ESP_ERR_INVALID_ARG;
+        if (err == ESP_OK)
+        {
+            cJSON_AddStringToObject(resp_root, "stats_stream_status", "updated");
+        }
+        else
+        {
+            cJSON_AddStringToObject(resp_root, "stats_stream_status",
+                                    err == ESP_ERR_INVALID_ARG ? "invalid" : esp_err_to_name(err));
+            cJSON_AddStringToObject(resp_root, "status", "error");
+        }
+    }
+
     if (restore_output_state_item)
     {
         action_taken = true;
@@ -556,35 +686,54 @@ static esp_err_t setting_post_handler(httpd_req_t* req)
                                                     USB_CRITICAL_CURRENT_LIMIT_MAX, climit_results,
                                                     &climit_failure);
 
-        if (vin_relation_ok)
+        const struct
         {
-            handle_climit_item(vin_climit_item, "vin", "vin", "current limit", 0.0, VIN_CURRENT_LIMIT_MAX, true,
-                               VIN_CURRENT_LIMIT, climit_set_vin, climit_get_vin, climit_results, &climit_success,
-                               &climit_failure);
-            handle_climit_item(vin_critical_climit_item, "vin_critical", "vin", "critical current limit",
-                               CRITICAL_CURRENT_LIMIT_MIN, VIN_CRITICAL_CURRENT_LIMIT_MAX, false, VIN_CRITICAL_CURRENT_LIMIT,
-                               climit_set_critical_vin, climit_get_critical_vin, climit_results, &climit_success,
-                               &climit_failure);
-        }
-        if (main_relation_ok)
+            cJSON* item;
+            const char* key;
+            const char* name;
+            const char* label;
+            double min_value;
+            double max_value;
+            bool allow_zero;
+            enum nconfig_type config_type;
+            enum climit_slot slot;
+            bool relation_ok;
+        } climit_items[] = {
+            {vin_climit_item, "vin", "vin", "current limit", 0.0, VIN_CURRENT_LIMIT_MAX, true, VIN_CURRENT_LIMIT,
+             CLIMIT_VIN, vin_relation_ok},
+            {vin_critical_climit_item, "vin_critical", "vin", "critical current limit", CRITICAL_CURRENT_LIMIT_MIN,
+             VIN_CRITICAL_CURRENT_LIMIT_MAX, false, VIN_CRITICAL_CURRENT_LIMIT, CLIMIT_CRITICAL_VIN, vin_relation_ok},
+            {main_climit_item, "main", "main", "current limit", 0.0, MAIN_CURRENT_LIMIT_MAX, true, MAIN_CURRENT_LIMIT,
+             CLIMIT_MAIN, main_relation_ok},
+            {main_critical_climit_item, "main_critical", "main", "critical current limit", CRITICAL_CURRENT_LIMIT_MIN,
+             MAIN_CRITICAL_CURRENT_LIMIT_MAX, false, MAIN_CRITICAL_CURRENT_LIMIT, CLIMIT_CRITICAL_MAIN,
+             main_relation_ok},
+            {usb_climit_item, "usb", "usb", "current limit", 0.0, USB_CURRENT_LIMIT_MAX, true, USB_CURRENT_LIMIT,
+             CLIMIT_USB, usb_relation_ok},
+            {usb_critical_climit_item, "usb_critical", "usb", "critical current limit", CRITICAL_CURRENT_LIMIT_MIN,
+             USB_CRITICAL_CURRENT_LIMIT_MAX, false, USB_CRITICAL_CURRENT_LIMIT, CLIMIT_CRITICAL_USB, usb_relation_ok},
+        };
+        const size_t climit_item_count = sizeof(climit_items) / sizeof(climit_items[0]);
+
+        // Valid limits are written in one batch, then saved only if their readback matched.
+        climit_batch_t batch = {0};
+        for (size_t i = 0; i < climit_item_count; i++)
         {
-            handle_climit_item(main_climit_item, "main", "main", "current limit", 0.0, MAIN_CURRENT_LIMIT_MAX, true,
-                               MAIN_CURRENT_LIMIT, climit_set_main, climit_get_main, climit_results,
-                               &climit_success, &climit_failure);
-            handle_climit_item(main_critical_climit_item, "main_critical", "main", "critical current limit",
-                               CRITICAL_CURRENT_LIMIT_MIN, MAIN_CRITICAL_CURRENT_LIMIT_MAX, false, MAIN_CRITICAL_CURRENT_LIMIT,
-                               climit_set_critical_main, climit_get_critical_main, climit_results,
-                               &climit_success, &climit_failure);
+            if (climit_items[i].relation_ok)
+                stage_climit_item(climit_items[i].item, climit_items[i].key, climit_items[i].name,
+                                  climit_items[i].label, climit_items[i].min_value, climit_items[i].max_value,
+                                  climit_items[i].allow_zero, climit_items[i].slot, &batch, climit_results,
+                                  &climit_failure);
         }
-        if (usb_relation_ok)
+
+        if (batch.staged)
         {
-            handle_climit_item(usb_climit_item, "usb", "usb", "current limit", 0.0, USB_CURRENT_LIMIT_MAX, true,
-                               USB_CURRENT_LIMIT, climit_set_usb, climit_get_usb, climit_results, &climit_success,
-                               &climit_failure);
-            handle_climit_item(usb_critical_climit_item, "usb_critical", "usb", "critical current limit",
-                               CRITICAL_CURRENT_LIMIT_MIN, USB_CRITICAL_CURRENT_LIMIT_MAX, false, USB_CRITICAL_CURRENT_LIMIT,
-                               climit_set_critical_usb, climit_get_critical_usb, climit_results, &climit_success,
-                               &climit_failure);
+            climit_batch_result_t applied;
+            climit_apply_batch(&batch, &applied);
+            for (size_t i = 0; i < climit_item_count; i++)
+                finish_climit_item(climit_items[i].key, climit_items[i].name, climit_items[i].label,
+                                   climit_items[i].slot, climit_items[i].config_type, &batch, &applied,
+                                   climit_results, &climit_success, &climit_failure);
         }
 
         if (climit_failure)
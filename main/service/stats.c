@@ -0,0 +1,422 @@
+#include "stats.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "auth.h"
+#include "cJSON.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "nconfig.h"
+#include "pbmsg.h"
+#include "webserver.h"
+
+#define P2_MARKERS 5
+#define P2_QUANTILE 0.99f
+
+static const char* TAG = "stats";
+
+static const uint32_t window_lengths_ms[STATS_WINDOW_COUNT] = {1000, 60 * 1000, 60 * 60 * 1000};
+static const char* const window_names[STATS_WINDOW_COUNT] = {"1s", "1m", "1h"};
+static const char* const channel_names[SENSOR_CHANNEL_COUNT] = {"usb", "main", "vin"};
+static const char* const metric_names[STATS_METRIC_COUNT] = {"voltage", "current", "power"};
+
+// P-square streaming quantile estimator (Jain & Chlamtac): five markers, O(1) per update.
+typedef struct
+{
+    float q[P2_MARKERS];       // marker heights
+    int32_t n[P2_MARKERS];     // marker positions
+    uint32_t count;
+} p2_t;
+
+// Running moments in raw register units: bus mV, shunt 5 uV LSB, power bus * shunt.
+typedef struct
+{
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    double sum_sq; // power squared overflows int64 within seconds
+    p2_t p99;
+} metric_acc_t;
+
+typedef struct
+{
+    int64_t start_us;
+    uint32_t count;
+    uint32_t channel_count[SENSOR_CHANNEL_COUNT]; // samples taken while the channel was enabled
+    metric_acc_t metric[SENSOR_CHANNEL_COUNT][STATS_METRIC_COUNT];
+} window_acc_t;
+
+static window_acc_t current[STATS_WINDOW_COUNT];
+static window_acc_t completed[STATS_WINDOW_COUNT];
+static int64_t completed_end_us[STATS_WINDOW_COUNT];
+static bool has_completed[STATS_WINDOW_COUNT];
+// Sequence lock: odd while the acquisition task is updating. The P-square updates are
+// too long for a critical section, so readers copy and retry instead.
+static volatile uint32_t stats_seq;
+
+static volatile int stream_window = -1; // window sent over WebSocket, -1 when off
+static volatile bool stream_pending;
+
+static const float p2_dn[P2_MARKERS] = {0.0f, P2_QUANTILE / 2, P2_QUANTILE, (1.0f + P2_QUANTILE) / 2, 1.0f};
+
+static void p2_add(p2_t* p2, float x)
+{
+    if (p2->count < P2_MARKERS)
+    {
+        // Insertion sort of the first observations.
+        int i = p2->count++;
+        while (i > 0 && p2->q[i - 1] > x)
+        {
+            p2->q[i] = p2->q[i - 1];
+            i--;
+        }
+        p2->q[i] = x;
+        if (p2->count == P2_MARKERS)
+        {
+            for (int j = 0; j < P2_MARKERS; j++)
+                p2->n[j] = j;
+        }
+        return;
+    }
+
+    int k;
+    if (x < p2->q[0])
+    {
+        p2->q[0] = x;
+        k = 0;
+    }
+    else if (x >= p2->q[4])
+    {
+        p2->q[4] = x;
+        k = 3;
+    }
+    else
+    {
+        for (k = 0; k < 3 && x >= p2->q[k + 1]; k++)
+            ;
+    }
+
+    for (int i = k + 1; i < P2_MARKERS; i++)
+        p2->n[i]++;
+    p2->count++;
+
+    // Desired positions come from the sample count each time: accumulating p2_dn in float
+    // stops moving once the positions reach 2^18 or so, and p99 then follows the max.
+    for (int i = 1; i < P2_MARKERS - 1; i++)
+    {
+        float d = (float)(p2_dn[i] * (double)(p2->count - 1) - p2->n[i]);
+        if ((d >= 1.0f && p2->n[i + 1] - p2->n[i] > 1) || (d <= -1.0f && p2->n[i - 1] - p2->n[i] < -1))
+        {
+            int s = d > 0 ? 1 : -1;
+            float nl = p2->n[i - 1], ni = p2->n[i], nr = p2->n[i + 1];
+            float qp = p2->q[i] + s / (nr - nl) *
+                                      ((ni - nl + s) * (p2->q[i + 1] - p2->q[i]) / (nr - ni) +
+                                       (nr - ni - s) * (p2->q[i] - p2->q[i - 1]) / (ni - nl));
+            if (p2->q[i - 1] < qp && qp < p2->q[i + 1])
+                p2->q[i] = qp;
+            else
+                p2->q[i] += s * (p2->q[i + s] - p2->q[i]) / (p2->n[i + s] - ni);
+            p2->n[i] += s;
+        }
+    }
+}
+
+static float p2_result(const p2_t* p2)
+{
+    if (p2->count == 0)
+        return 0.0f;
+    if (p2->count < P2_MARKERS)
+        return p2->q[(uint32_t)(P2_QUANTILE * (p2->count - 1) + 0.5f)];
+    return p2->q[2];
+}
+
+static void metric_add(metric_acc_t* acc, uint32_t count, int32_t value)
+{
+    if (count == 0 || value < acc->min)
+        acc->min = value;
+    if (count == 0 || value > acc->max)
+        acc->max = value;
+    acc->sum += value;
+    acc->sum_sq += (double)value * value;
+    p2_add(&acc->p99, value);
+}
+
+static void window_start(window_acc_t* window, int64_t now_us)
+{
+    memset(window, 0, sizeof(*window));
+    window->start_us = now_us;
+}
+
+// Called by the acquisition task for every conversion. Windows are tumbling: when one
+// has run its full length it is kept as the last completed window and restarts.
+void stats_add(const sensor_data_t* sample, int64_t sample_us)
+{
+    bool publish = false;
+    uint8_t enabled = sensor_get_channel_mask();
+
+    stats_seq++;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    for (int w = 0; w < STATS_WINDOW_COUNT; w++)
+    {
+        window_acc_t* window = &current[w];
+        if (window->start_us == 0)
+            window->start_us = sample_us;
+
+        if (sample_us - window->start_us >= (int64_t)window_lengths_ms[w] * 1000)
+        {
+            completed[w] = *window;
+            completed_end_us[w] = sample_us;
+            has_completed[w] = true;
+            if (w == stream_window)
+                publish = true;
+            window_start(window, sample_us);
+        }
+
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; c++)
+        {
+            // A disabled channel reads zero, which is not a measurement.
+            if (!(enabled & BIT(c)))
+                continue;
+            int32_t bus = sample->bus_raw[c];
+            int32_t shunt = sample->shunt_raw[c];
+            uint32_t count = window->channel_count[c]++;
+            metric_add(&window->metric[c][STATS_VOLTAGE], count, bus);
+            metric_add(&window->metric[c][STATS_CURRENT], count, shunt);
+            metric_add(&window->metric[c][STATS_POWER], count, bus * shunt);
+        }
+        window->count++;
+    }
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    stats_seq++;
+
+    if (publish)
+        stream_pending = true;
+}
+
+static void summarize(const metric_acc_t* acc, uint32_t count, float scale, stats_summary_t* out)
+{
+    if (count == 0)
+    {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+
+    double mean = (double)acc->sum / count;
+    double variance = acc->sum_sq / count - mean * mean;
+    out->min = acc->min * scale;
+    out->max = acc->max * scale;
+    out->mean = mean * scale;
+    out->stddev = variance > 0 ? sqrt(variance) * scale : 0.0f;
+    out->p99 = p2_result(&acc->p99) * scale;
+}
+
+// Fills the last completed window, or the one still filling if none has completed yet.
+bool stats_get_window(int index, stats_window_t* out)
+{
+    if (index < 0 || index >= STATS_WINDOW_COUNT)
+        return false;
+
+    window_acc_t snapshot;
+    int64_t end_us;
+    uint32_t seq;
+    do
+    {
+        seq = stats_seq;
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        out->complete = has_completed[index];
+        if (out->complete)
+        {
+            snapshot = completed[index];
+            end_us = completed_end_us[index];
+        }
+        else
+        {
+            snapshot = current[index];
+            end_us = esp_timer_get_time();
+        }
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    } while ((seq & 1) || seq != stats_seq);
+
+    out->window_ms = window_lengths_ms[index];
+    out->sample_count = snapshot.count;
+    out->elapsed_ms = snapshot.start_us ? (end_us - snapshot.start_us) / 1000 : 0;
+    out->end_uptime_ms = end_us / 1000;
+    out->channel_mask = sensor_get_channel_mask();
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; c++)
+    {
+        float mohm = sensor_shunt_mohm(c);
+        uint32_t count = snapshot.channel_count[c];
+        summarize(&snapshot.metric[c][STATS_VOLTAGE], count, 0.001f, &out->channel[c][STATS_VOLTAGE]);
+        summarize(&snapshot.metric[c][STATS_CURRENT], count, 0.005f / mohm, &out->channel[c][STATS_CURRENT]);
+        summarize(&snapshot.metric[c][STATS_POWER], count, 0.000005f / mohm, &out->channel[c][STATS_POWER]);
+    }
+    return true;
+}
+
+void stats_init(void)
+{
+    char buf[8];
+    if (nconfig_read(STATS_STREAM, buf, sizeof(buf)) == ESP_OK)
+    {
+        for (int w = 0; w < STATS_WINDOW_COUNT; w++)
+        {
+            if (strcmp(buf, window_names[w]) == 0)
+                stream_window = w;
+        }
+    }
+}
+
+esp_err_t update_stats_stream(const char* window_name)
+{
+    int window = -1;
+    for (int w = 0; w < STATS_WINDOW_COUNT; w++)
+    {
+        if (strcmp(window_name, window_names[w]) == 0)
+            window = w;
+    }
+    if (window < 0 && strcmp(window_name, "off") != 0)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = nconfig_write(STATS_STREAM, window_name);
+    if (err != ESP_OK)
+        return err;
+
+    stream_window = window;
+    stream_pending = false;
+    return ESP_OK;
+}
+
+const char* stats_get_stream(void)
+{
+    int window = stream_window;
+    return window < 0 ? "off" : window_names[window];
+}
+
+static void fill_summary(StatsSummary* out, const stats_summary_t* in)
+{
+    out->min = in->min;
+    out->max = in->max;
+    out->mean = in->mean;
+    out->stddev = in->stddev;
+    out->p99 = in->p99;
+}
+
+// Called from the publish task so the acquisition path never encodes or sends.
+void stats_publish_if_due(void)
+{
+    int window = stream_window;
+    if (!stream_pending || window < 0)
+        return;
+    stream_pending = false;
+
+    stats_window_t stats;
+    if (!stats_get_window(window, &stats))
+        return;
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+
+    StatusMessage message = StatusMessage_init_zero;
+    message.which_payload = StatusMessage_sensor_stats_tag;
+    SensorStats* out = &message.payload.sensor_stats;
+    out->window_ms = stats.window_ms;
+    out->sample_count = stats.sample_count;
+    out->timestamp_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
+    out->uptime_ms = stats.end_uptime_ms;
+    out->has_usb = stats.channel_mask & BIT(0);
+    out->has_main = stats.channel_mask & BIT(1);
+    out->has_vin = stats.channel_mask & BIT(2);
+
+    ChannelStats* channels[] = {&out->usb, &out->main, &out->vin};
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; c++)
+    {
+        if (!(stats.channel_mask & BIT(c)))
+            continue;
+        channels[c]->has_voltage = true;
+        channels[c]->has_current = true;
+        channels[c]->has_power = true;
+        fill_summary(&channels[c]->voltage, &stats.channel[c][STATS_VOLTAGE]);
+        fill_summary(&channels[c]->current, &stats.channel[c][STATS_CURRENT]);
+        fill_summary(&channels[c]->power, &stats.channel[c][STATS_POWER]);
+    }
+
+    send_pb_message(StatusMessage_fields, &message);
+}
+
+static void add_summary(cJSON* parent, const char* name, const stats_summary_t* summary)
+{
+    cJSON* obj = cJSON_AddObjectToObject(parent, name);
+    if (!obj)
+        return;
+    cJSON_AddNumberToObject(obj, "min", summary->min);
+    cJSON_AddNumberToObject(obj, "max", summary->max);
+    cJSON_AddNumberToObject(obj, "mean", summary->mean);
+    cJSON_AddNumberToObject(obj, "stddev", summary->stddev);
+    cJSON_AddNumberToObject(obj, "p99", summary->p99);
+}
+
+static esp_err_t stats_get_handler(httpd_req_t* req)
+{
+    esp_err_t err = api_auth_check(req);
+    if (err != ESP_OK)
+        return err;
+
+    cJSON* root = cJSON_CreateObject();
+    if (!root)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddNumberToObject(root, "uptime_ms", (double)(esp_timer_get_time() / 1000));
+    cJSON_AddStringToObject(root, "stream", stats_get_stream());
+    stats_window_t stats;
+    for (int w = 0; w < STATS_WINDOW_COUNT; w++)
+    {
+        if (!stats_get_window(w, &stats))
+            continue;
+
+        cJSON* window = cJSON_AddObjectToObject(root, window_names[w]);
+        if (!window)
+            continue;
+        cJSON_AddBoolToObject(window, "complete", stats.complete);
+        cJSON_AddNumberToObject(window, "window_ms", stats.window_ms);
+        cJSON_AddNumberToObject(window, "elapsed_ms", stats.elapsed_ms);
+        cJSON_AddNumberToObject(window, "end_uptime_ms", (double)stats.end_uptime_ms);
+        cJSON_AddNumberToObject(window, "sample_count", stats.sample_count);
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; c++)
+        {
+            if (!(stats.channel_mask & BIT(c)))
+                continue;
+            cJSON* channel = cJSON_AddObjectToObject(window, channel_names[c]);
+            if (!channel)
+                continue;
+            for (int m = 0; m < STATS_METRIC_COUNT; m++)
+                add_summary(channel, metric_names[m], &stats.channel[c][m]);
+        }
+    }
+
+    char* response = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    if (!response)
+    {
+        httpd_resp_send_500(req);
+        return ESP_ERR_NO_MEM;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    err = httpd_resp_sendstr(req, response);
+    free(response);
+    return err;
+}
+
+void register_stats_endpoint(httpd_handle_t server)
+{
+    httpd_uri_t get_uri = {.uri = "/api/stats", .method = HTTP_GET, .handler = stats_get_handler, .user_ctx = NULL};
+    httpd_register_uri_handler(server, &get_uri);
+    ESP_LOGD(TAG, "stats endpoint registered");
+}
@@ -0,0 +1,48 @@
+#ifndef ODROID_POWER_MATE_STATS_H
+#define ODROID_POWER_MATE_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "monitor.h"
+
+#define STATS_WINDOW_COUNT 3 // 1 s, 1 min, 1 h
+#define STATS_METRIC_COUNT 3 // voltage, current, power
+
+enum stats_metric
+{
+    STATS_VOLTAGE = 0,
+    STATS_CURRENT = 1,
+    STATS_POWER = 2,
+};
+
+typedef struct
+{
+    float min;
+    float max;
+    float mean;
+    float stddev;
+    float p99;
+} stats_summary_t;
+
+// Statistics of one tumbling window in V, A and W, indexed [channel][metric].
+typedef struct
+{
+    uint32_t window_ms;
+    uint32_t sample_count;
+    uint32_t elapsed_ms; // window_ms for a completed window, less while it is still filling
+    uint64_t end_uptime_ms;
+    bool complete;
+    uint8_t channel_mask; // enabled channels; the others are left out of the output
+    stats_summary_t channel[SENSOR_CHANNEL_COUNT][STATS_METRIC_COUNT];
+} stats_window_t;
+
+void stats_add(const sensor_data_t* sample, int64_t sample_us);
+bool stats_get_window(int index, stats_window_t* window);
+esp_err_t update_stats_stream(const char* window_name);
+const char* stats_get_stream(void);
+void stats_init(void);
+void stats_publish_if_due(void);
+
+#endif // ODROID_POWER_MATE_STATS_H
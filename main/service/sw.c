@@ -15,9 +15,9 @@
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "event.h"
+#include "inrush.h"
 #include "nconfig.h"
-#include "pb.h"
-#include "pb_encode.h"
+#include "pbmsg.h"
 #include "pca9557.h"
 #include "status.pb.h"
 #include "webserver.h"
@@ -34,8 +34,6 @@
 #define POWER_DELAY (CONFIG_TRIGGER_POWER_DELAY_MS * 1000)
 #define RESET_DELAY (CONFIG_TRIGGER_RESET_DELAY_MS * 1000)
 
-#define PB_BUFFER_SIZE 256
-
 static const char* TAG = "control";
 
 static bool load_switch_12v_status = false;
@@ -116,16 +114,7 @@ static void send_sw_status_message()
     sw_status->main = load_switch_12v_status;
     sw_status->usb = load_switch_5v_status;
 
-    uint8_t buffer[PB_BUFFER_SIZE];
-    pb_ostream_t stream = pb_ostream_from_buffer(buffer, sizeof(buffer));
-
-    if (!pb_encode(&stream, StatusMessage_fields, &message))
-    {
-        ESP_LOGE(TAG, "Failed to encode protobuf message: %s", PB_GET_ERROR(&stream));
-        return;
-    }
-
-    push_data_to_ws(buffer, stream.bytes_written);
+    send_pb_message(StatusMessage_fields, &message);
 }
 
 void publish_load_switch_status()
@@ -150,15 +139,16 @@ esp_err_t sync_load_switch_status_from_hw()
     return ESP_OK;
 }
 
-esp_err_t set_load_switches(bool main_on, bool usb_on)
+typedef struct
 {
-    ESP_LOGI(TAG, "Set load switches: main=%s usb=%s", main_on ? "on" : "off", usb_on ? "on" : "off");
-    if (load_switch_12v_status == main_on && load_switch_5v_status == usb_on)
-    {
-        send_sw_status_message();
-        return ESP_OK;
-    }
+    bool main_on;
+    bool usb_on;
+} load_switch_request_t;
 
+// Only the expander writes, so it can run as the edge of an inrush burst.
+static esp_err_t apply_load_switches(void* arg)
+{
+    const load_switch_request_t* request = arg;
     if (xSemaphoreTake(expander_mutex, MUTEX_TIMEOUT) == pdFALSE)
     {
         ESP_LOGW(TAG, "Control error");
@@ -167,10 +157,10 @@ esp_err_t set_load_switches(bool main_on, bool usb_on)
 
     esp_err_t main_err = ESP_OK;
     esp_err_t usb_err = ESP_OK;
-    if (load_switch_12v_status != main_on)
-        main_err = pca9557_set_level(&pca, GPIO_MAIN, main_on);
-    if (load_switch_5v_status != usb_on)
-        usb_err = pca9557_set_level(&pca, GPIO_USB, usb_on);
+    if (load_switch_12v_status != request->main_on)
+        main_err = pca9557_set_level(&pca, GPIO_MAIN, request->main_on);
+    if (load_switch_5v_status != request->usb_on)
+        usb_err = pca9557_set_level(&pca, GPIO_USB, request->usb_on);
     xSemaphoreGive(expander_mutex);
 
     if (main_err != ESP_OK || usb_err != ESP_OK)
@@ -179,6 +169,30 @@ esp_err_t set_load_switches(bool main_on, bool usb_on)
                  esp_err_to_name(usb_err));
         return main_err != ESP_OK ? main_err : usb_err;
     }
+    return ESP_OK;
+}
+
+esp_err_t set_load_switches(bool main_on, bool usb_on)
+{
+    ESP_LOGI(TAG, "Set load switches: main=%s usb=%s", main_on ? "on" : "off", usb_on ? "on" : "off");
+    if (load_switch_12v_status == main_on && load_switch_5v_status == usb_on)
+    {
+        send_sw_status_message();
+        return ESP_OK;
+    }
+
+    // Record the inrush of every output that turns on (sensor channel 0 = USB, 1 = MAIN).
+    uint8_t turning_on = 0;
+    if (main_on && !load_switch_12v_status)
+        turning_on |= BIT(1);
+    if (usb_on && !load_switch_5v_status)
+        turning_on |= BIT(0);
+
+    load_switch_request_t request = {.main_on = main_on, .usb_on = usb_on};
+    esp_err_t err = turning_on ? inrush_run(INRUSH_SOURCE_SWITCH_ON, turning_on, apply_load_switches, &request)
+                               : apply_load_switches(&request);
+    if (err != ESP_OK)
+        return err;
 
     load_switch_12v_status = main_on;
     load_switch_5v_status = usb_on;
@@ -238,16 +252,26 @@ void init_sw()
     ESP_ERROR_CHECK(esp_timer_create(&reset_timer_args, &reset_trigger_timer));
 }
 
-void trig_power()
+static esp_err_t press_trigger(void* arg)
 {
-    ESP_LOGI(TAG, "Trig power");
     if (xSemaphoreTake(expander_mutex, MUTEX_TIMEOUT) == pdFALSE)
     {
         ESP_LOGW(TAG, "Control error");
-        return;
+        return ESP_ERR_TIMEOUT;
     }
-    pca9557_set_level(&pca, GPIO_PWR, 0);
+
+    uint32_t gpio_pin = (int)arg;
+    pca9557_set_level(&pca, gpio_pin, 0);
     xSemaphoreGive(expander_mutex);
+    return ESP_OK;
+}
+
+// The power and reset buttons act on the board behind MAIN, so that is where the burst looks.
+void trig_power()
+{
+    ESP_LOGI(TAG, "Trig power");
+    if (inrush_run(INRUSH_SOURCE_POWER_BUTTON, BIT(1), press_trigger, (void*)GPIO_PWR) != ESP_OK)
+        return;
     push_event(EV_INFO, "power triggered");
     esp_timer_stop(power_trigger_timer);
     esp_timer_start_once(power_trigger_timer, POWER_DELAY);
@@ -256,13 +280,8 @@ void trig_power()
 void trig_reset()
 {
     ESP_LOGI(TAG, "Trig reset");
-    if (xSemaphoreTake(expander_mutex, MUTEX_TIMEOUT) == pdFALSE)
-    {
-        ESP_LOGW(TAG, "Control error");
+    if (inrush_run(INRUSH_SOURCE_RESET_BUTTON, BIT(1), press_trigger, (void*)GPIO_RST) != ESP_OK)
         return;
-    }
-    pca9557_set_level(&pca, GPIO_RST, 0);
-    xSemaphoreGive(expander_mutex);
     push_event(EV_INFO, "reset triggered");
     esp_timer_stop(reset_trigger_timer);
     esp_timer_start_once(reset_trigger_timer, RESET_DELAY);
@@ -7,6 +7,7 @@
 #include "esp_http_server.h"
 #include "esp_log.h"
 #include "esp_wifi.h"
+#include "event.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "lwip/err.h"
@@ -166,11 +167,12 @@ static esp_err_t login_handler(httpd_req_t* req)
 void start_webserver(void)
 {
     auth_init();
+    event_init();
 
     httpd_handle_t server = NULL;
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.stack_size = 1024 * 8;
-    config.max_uri_handlers = 12;
+    config.max_uri_handlers = 28;
     config.task_priority = 12;
     config.max_open_sockets = POWERMATE_HTTP_MAX_OPEN_SOCKETS;
     config.lru_purge_enable = true;
@@ -196,6 +198,15 @@ void start_webserver(void)
     register_ws_endpoint(server);
     register_control_endpoint(server);
     register_diagnostics_endpoint(server);
+    register_history_endpoint(server);
+    register_energy_endpoint(server);
+    register_capture_endpoint(server);
+    register_stats_endpoint(server);
+    register_rules_endpoint(server);
+    register_inrush_endpoint(server);
+    register_histogram_endpoint(server);
+    register_latency_endpoint(server);
+    register_journal_endpoint(server);
     register_reboot_endpoint(server);
     register_version_endpoint(server);
 
@@ -5,12 +5,44 @@
 #ifndef ODROID_REMOTE_HTTP_WEBSERVER_H
 #define ODROID_REMOTE_HTTP_WEBSERVER_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "esp_http_server.h"
 
 #define POWERMATE_HTTP_MAX_OPEN_SOCKETS 7
 
+#define WS_FRAME_SMALL_SIZE 384 // protobuf status messages
+#define WS_FRAME_SMALL_COUNT 16
+#define WS_FRAME_LARGE_SIZE 2048 // UART chunks and sensor batches
+#define WS_FRAME_LARGE_COUNT 12
+#define WS_CLIENT_QUEUE_LENGTH 8 // frames waiting per WebSocket session
+
+// A WebSocket payload from the fixed frame pool. Encoders write into data directly; each
+// holder of a reference (a queue entry, a send in progress) releases it when done, and
+// the last release returns the frame to the pool.
+typedef struct
+{
+    uint8_t* data;
+    uint16_t capacity;
+    uint16_t len;
+    uint8_t refs;
+    uint8_t payload; // StatusMessage payload tag, selects the delivery policy; 0 for UART data
+    bool text; // sent as a text frame; control replies, never dropped
+} ws_frame_t;
+
+typedef struct
+{
+    int fd;
+    bool uart;
+    uint8_t queue_depth;
+    uint8_t max_queue_depth;
+    uint32_t lag_ms; // age of the oldest queued frame
+    uint32_t max_lag_ms; // longest a frame waited before it was sent
+    uint32_t sent;
+    uint32_t dropped;
+} websocket_client_diagnostics_t;
+
 typedef struct
 {
     size_t queue_depth;
@@ -22,13 +54,39 @@ typedef struct
     uint32_t uart_queue_drops;
     uint32_t status_queue_drops;
     uint32_t websocket_send_failures;
+    uint32_t frame_alloc_failures;
+    uint8_t small_frames_free;
+    uint8_t small_frames_low_water;
+    uint8_t large_frames_free;
+    uint8_t large_frames_low_water;
+    uint8_t client_count;
+    websocket_client_diagnostics_t clients[POWERMATE_HTTP_MAX_OPEN_SOCKETS];
 } websocket_diagnostics_t;
 
 void register_wifi_endpoint(httpd_handle_t server);
 void register_ws_endpoint(httpd_handle_t server);
 void register_control_endpoint(httpd_handle_t server);
 void register_diagnostics_endpoint(httpd_handle_t server);
-void push_data_to_ws(const uint8_t* data, size_t len);
+void register_history_endpoint(httpd_handle_t server);
+void register_energy_endpoint(httpd_handle_t server);
+void register_capture_endpoint(httpd_handle_t server);
+void register_stats_endpoint(httpd_handle_t server);
+void register_rules_endpoint(httpd_handle_t server);
+void register_inrush_endpoint(httpd_handle_t server);
+void register_histogram_endpoint(httpd_handle_t server);
+void register_latency_endpoint(httpd_handle_t server);
+void register_journal_endpoint(httpd_handle_t server);
+// Returns a frame of at least capacity bytes holding one reference, NULL if the pool is
+// exhausted. Small requests fall back to a large frame.
+ws_frame_t* ws_frame_alloc(size_t capacity);
+void ws_frame_ref(ws_frame_t* frame);
+void ws_frame_release(ws_frame_t* frame);
+// True if a status session subscribed to the StatusMessage payload type; producers skip
+// encoding when nobody did.
+bool ws_payload_subscribed(uint8_t payload);
+// Queues frame->len bytes for every status WebSocket client; takes over the caller's reference.
+// Each client queue keeps its own reference until the frame is sent or dropped.
+void push_frame_to_ws(ws_frame_t* frame);
 void websocket_get_diagnostics(websocket_diagnostics_t* diagnostics);
 void register_reboot_endpoint(httpd_handle_t server);
 esp_err_t change_baud_rate(int baud_rate);
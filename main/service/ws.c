@@ -3,48 +3,88 @@
 //
 
 #include "auth.h"
+#include "cJSON.h"
 #include "driver/uart.h"
 #include "esp_err.h"
-#include "esp_heap_caps.h"
 #include "esp_http_server.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
+#include "lwip/sockets.h"
 #include "nconfig.h"
+#include "status.pb.h"
 #include <stdlib.h>
 #include "string.h"
 #include "webserver.h"
 
 #define UART_NUM UART_NUM_1
-#define BUF_SIZE 2048
+#define BUF_SIZE WS_FRAME_LARGE_SIZE
 #define UART_RX_BUFFER_SIZE (16 * 1024)
 #define UART_TX_BUFFER_SIZE 2048
-#define UART_WS_QUEUE_LENGTH 8
-#define UART_MIN_FREE_HEAP (48 * 1024)
+#define WS_CLIENT_RETRY_MS 10
+#define WS_PAYLOAD_TAG_LIMIT 16 // StatusMessage payload tags are below this
 #define UART_WS_LRU_UPDATE_INTERVAL_MS 1000
 #define UART_TX_PIN CONFIG_GPIO_UART_TX
 #define UART_RX_PIN CONFIG_GPIO_UART_RX
 
 static const char* TAG = "ws-uart";
 
-struct ws_message
-{
-    uint8_t* data;
-    size_t len;
-};
-
 struct ws_sender_config
 {
-    QueueHandle_t queue;
+    TaskHandle_t task;
     httpd_handle_t server;
     bool uart_stream;
     const char* name;
 };
 
 #define MAX_CLIENT POWERMATE_HTTP_MAX_OPEN_SOCKETS
-static QueueHandle_t status_ws_queue;
-static QueueHandle_t uart_ws_queue;
+
+// Per-session send queue, a ring of frame references. The slot doubles as the httpd
+// session context and is freed with the session.
+typedef struct
+{
+    int fd; // 0 while the slot is free
+    bool uart;
+    bool open; // handshake completed
+    bool closing; // send failed or fell behind on frames that must not be dropped
+    uint8_t head;
+    uint8_t count;
+    uint8_t max_depth;
+    ws_frame_t* frames[WS_CLIENT_QUEUE_LENGTH];
+    TickType_t queued_at[WS_CLIENT_QUEUE_LENGTH];
+    uint32_t sent;
+    uint32_t dropped;
+    uint32_t max_lag_ms;
+    uint8_t decimation[WS_PAYLOAD_TAG_LIMIT]; // send every Nth frame of a payload type, 0 = unsubscribed
+    uint8_t decimation_count[WS_PAYLOAD_TAG_LIMIT];
+} ws_client_t;
+
+static const struct
+{
+    const char* name;
+    uint8_t tag;
+} ws_payload_names[] = {
+    {"sensor_data", StatusMessage_sensor_data_tag},
+    {"wifi_status", StatusMessage_wifi_status_tag},
+    {"sw_status", StatusMessage_sw_status_tag},
+    {"event_data", StatusMessage_event_data_tag},
+    {"sensor_data_raw", StatusMessage_sensor_data_raw_tag},
+    {"sensor_stats", StatusMessage_sensor_stats_tag},
+    {"clock_sync", StatusMessage_clock_sync_tag},
+    {"sensor_batch", StatusMessage_sensor_batch_tag},
+};
+
 static QueueHandle_t uart_event_queue;
+static ws_client_t ws_clients[MAX_CLIENT];
+static portMUX_TYPE ws_client_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Session registry, rebuilt under ws_client_lock whenever a session opens, closes or
+// changes its subscription, so per-frame paths never walk the httpd client list.
+// Index [1] is the UART stream.
+static uint8_t ws_live_slots[2][MAX_CLIENT];
+static volatile uint8_t ws_live_count[2];
+static volatile uint32_t ws_status_subscriptions; // bit per payload tag some status session wants
 static struct ws_sender_config status_sender;
 static struct ws_sender_config uart_sender;
 static volatile uint32_t uart_received_bytes;
@@ -53,181 +93,479 @@ static volatile uint32_t uart_buffer_full_events;
 static volatile uint32_t uart_queue_drops;
 static volatile uint32_t status_queue_drops;
 static volatile uint32_t websocket_send_failures;
-static int blocked_ws_fds[MAX_CLIENT];
 static uint8_t status_ws_session;
 static uint8_t uart_ws_session;
 
-static void websocket_session_ctx_free(void* ctx)
+// Frame pool: storage is static so streaming never touches the heap. refs is only
+// changed under ws_frame_lock.
+static uint8_t ws_small_storage[WS_FRAME_SMALL_COUNT][WS_FRAME_SMALL_SIZE];
+static uint8_t ws_large_storage[WS_FRAME_LARGE_COUNT][WS_FRAME_LARGE_SIZE];
+static ws_frame_t ws_frames[WS_FRAME_SMALL_COUNT + WS_FRAME_LARGE_COUNT];
+static portMUX_TYPE ws_frame_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t ws_small_free = WS_FRAME_SMALL_COUNT;
+static uint8_t ws_small_low_water = WS_FRAME_SMALL_COUNT;
+static uint8_t ws_large_free = WS_FRAME_LARGE_COUNT;
+static uint8_t ws_large_low_water = WS_FRAME_LARGE_COUNT;
+static volatile uint32_t ws_frame_alloc_failures;
+
+static void ws_frame_pool_init(void)
 {
+    for (size_t i = 0; i < WS_FRAME_SMALL_COUNT; ++i)
+        ws_frames[i] = (ws_frame_t){.data = ws_small_storage[i], .capacity = WS_FRAME_SMALL_SIZE};
+    for (size_t i = 0; i < WS_FRAME_LARGE_COUNT; ++i)
+        ws_frames[WS_FRAME_SMALL_COUNT + i] =
+            (ws_frame_t){.data = ws_large_storage[i], .capacity = WS_FRAME_LARGE_SIZE};
 }
 
-static bool fd_in_list(const int* fds, int fd)
+static ws_frame_t* ws_frame_take(size_t first, size_t count)
 {
-    for (size_t i = 0; i < MAX_CLIENT; ++i)
+    for (size_t i = first; i < first + count; ++i)
+    {
+        if (ws_frames[i].refs == 0)
+        {
+            ws_frames[i].refs = 1;
+            ws_frames[i].len = 0;
+            ws_frames[i].payload = 0;
+            ws_frames[i].text = false;
+            return &ws_frames[i];
+        }
+    }
+    return NULL;
+}
+
+ws_frame_t* ws_frame_alloc(size_t capacity)
+{
+    if (capacity > WS_FRAME_LARGE_SIZE)
+        return NULL;
+
+    ws_frame_t* frame = NULL;
+    taskENTER_CRITICAL(&ws_frame_lock);
+    if (capacity <= WS_FRAME_SMALL_SIZE)
+        frame = ws_frame_take(0, WS_FRAME_SMALL_COUNT);
+    if (frame)
     {
-        if (fds[i] == fd)
-            return true;
+        if (--ws_small_free < ws_small_low_water)
+            ws_small_low_water = ws_small_free;
     }
-    return false;
+    else
+    {
+        frame = ws_frame_take(WS_FRAME_SMALL_COUNT, WS_FRAME_LARGE_COUNT);
+        if (frame && --ws_large_free < ws_large_low_water)
+            ws_large_low_water = ws_large_free;
+    }
+    taskEXIT_CRITICAL(&ws_frame_lock);
+
+    if (!frame)
+        ws_frame_alloc_failures++;
+    return frame;
 }
 
-static void add_fd_to_list(int* fds, int fd)
+void ws_frame_ref(ws_frame_t* frame)
 {
-    for (size_t i = 0; i < MAX_CLIENT; ++i)
+    taskENTER_CRITICAL(&ws_frame_lock);
+    frame->refs++;
+    taskEXIT_CRITICAL(&ws_frame_lock);
+}
+
+void ws_frame_release(ws_frame_t* frame)
+{
+    if (!frame)
+        return;
+
+    taskENTER_CRITICAL(&ws_frame_lock);
+    if (frame->refs && --frame->refs == 0)
+    {
+        if (frame->capacity == WS_FRAME_SMALL_SIZE)
+            ws_small_free++;
+        else
+            ws_large_free++;
+    }
+    taskEXIT_CRITICAL(&ws_frame_lock);
+}
+
+// Delivery policy per stream. Events and switch changes are state a client cannot
+// recover from a later frame, so they are never dropped; periodic streams (sensor data,
+// batches, Wi-Fi, stats, UART) keep only the newest frames when a client falls behind.
+static bool ws_frame_droppable(const ws_frame_t* frame)
+{
+    if (frame->text)
+        return false;
+
+    switch (frame->payload)
+    {
+    case StatusMessage_event_data_tag:
+    case StatusMessage_sw_status_tag:
+        return false;
+    default:
+        return true;
+    }
+}
+
+// Removes the frame at position pos (0 = oldest) and closes the gap. Caller holds ws_client_lock.
+static ws_frame_t* ws_client_remove_at(ws_client_t* client, uint8_t pos)
+{
+    uint8_t index = (client->head + pos) % WS_CLIENT_QUEUE_LENGTH;
+    ws_frame_t* frame = client->frames[index];
+
+    if (pos == 0)
+    {
+        client->head = (client->head + 1) % WS_CLIENT_QUEUE_LENGTH;
+    }
+    else
     {
-        if (fds[i] == fd)
-            return;
-        if (fds[i] == 0)
+        for (uint8_t i = pos; i + 1 < client->count; ++i)
         {
-            fds[i] = fd;
-            return;
+            uint8_t to = (client->head + i) % WS_CLIENT_QUEUE_LENGTH;
+            uint8_t from = (to + 1) % WS_CLIENT_QUEUE_LENGTH;
+            client->frames[to] = client->frames[from];
+            client->queued_at[to] = client->queued_at[from];
         }
     }
+    client->count--;
+    return frame;
+}
+
+static void ws_client_drain(ws_client_t* client)
+{
+    ws_frame_t* frames[WS_CLIENT_QUEUE_LENGTH];
+    uint8_t count = 0;
+
+    taskENTER_CRITICAL(&ws_client_lock);
+    while (client->count)
+        frames[count++] = ws_client_remove_at(client, 0);
+    taskEXIT_CRITICAL(&ws_client_lock);
+
+    for (uint8_t i = 0; i < count; ++i)
+        ws_frame_release(frames[i]);
 }
 
-static void remove_fd_from_list(int* fds, int fd)
+// Caller holds ws_client_lock.
+static void ws_update_registry(void)
 {
+    uint8_t count[2] = {0};
+    uint32_t mask = 0;
     for (size_t i = 0; i < MAX_CLIENT; ++i)
     {
-        if (fds[i] == fd)
-            fds[i] = 0;
+        const ws_client_t* client = &ws_clients[i];
+        if (!client->fd || !client->open || client->closing)
+            continue;
+
+        ws_live_slots[client->uart][count[client->uart]++] = i;
+        for (uint8_t tag = 0; !client->uart && tag < WS_PAYLOAD_TAG_LIMIT; ++tag)
+        {
+            if (client->decimation[tag])
+                mask |= 1u << tag;
+        }
     }
+    ws_live_count[0] = count[0];
+    ws_live_count[1] = count[1];
+    ws_status_subscriptions = mask;
 }
 
-static void cleanup_fd_list(int* fds, const int* client_fds, size_t clients)
+static bool ws_stream_has_clients(bool uart_stream)
 {
-    for (size_t i = 0; i < MAX_CLIENT; ++i)
+    return ws_live_count[uart_stream] != 0;
+}
+
+// Takes a session out of the registry and asks httpd to close it; free_ctx frees the slot.
+static void ws_client_close(httpd_handle_t server, ws_client_t* client, int fd)
+{
+    bool same_session;
+    taskENTER_CRITICAL(&ws_client_lock);
+    same_session = client->fd == fd && !client->closing;
+    if (same_session)
     {
-        if (fds[i] == 0)
-            continue;
+        client->closing = true;
+        ws_update_registry();
+    }
+    taskEXIT_CRITICAL(&ws_client_lock);
+
+    // The slot may already belong to a new session that reused the fd.
+    if (!same_session)
+        return;
+    ws_client_drain(client);
+    httpd_sess_trigger_close(server, fd);
+}
+
+bool ws_payload_subscribed(uint8_t payload)
+{
+    return payload < WS_PAYLOAD_TAG_LIMIT && (ws_status_subscriptions & (1u << payload));
+}
+
+// Called before the handshake response (open = false) and again once it was sent.
+static ws_client_t* ws_client_acquire(int fd, bool uart_stream, bool open)
+{
+    ws_client_t* client = NULL;
 
-        bool still_connected = false;
-        for (size_t j = 0; j < clients; ++j)
+    taskENTER_CRITICAL(&ws_client_lock);
+    for (size_t i = 0; i < MAX_CLIENT && !client; ++i)
+    {
+        if (ws_clients[i].fd == fd)
+            client = &ws_clients[i];
+    }
+    for (size_t i = 0; i < MAX_CLIENT && !client; ++i)
+    {
+        if (ws_clients[i].fd == 0)
         {
-            if (fds[i] == client_fds[j])
-            {
-                still_connected = true;
-                break;
-            }
+            client = &ws_clients[i];
+            memset(client, 0, sizeof(*client));
+            client->fd = fd;
+            client->uart = uart_stream;
+            // Until a subscription message arrives, a status session gets every frame.
+            if (!uart_stream)
+                memset(client->decimation, 1, sizeof(client->decimation));
         }
-        if (!still_connected)
-            fds[i] = 0;
     }
+    if (client && open && !client->open)
+    {
+        client->open = true;
+        ws_update_registry();
+    }
+    taskEXIT_CRITICAL(&ws_client_lock);
+
+    return client;
 }
 
-static void cleanup_client_fds(const int* client_fds, size_t clients)
+static void websocket_session_ctx_free(void* ctx)
 {
-    cleanup_fd_list(blocked_ws_fds, client_fds, clients);
+    ws_client_t* client = ctx;
+    if (!client)
+        return;
+
+    ws_client_drain(client);
+    taskENTER_CRITICAL(&ws_client_lock);
+    client->fd = 0;
+    ws_update_registry();
+    taskEXIT_CRITICAL(&ws_client_lock);
 }
 
-static bool uart_websocket_client_connected(httpd_handle_t server)
+static bool ws_session_is(const void* ctx, bool uart_stream)
 {
-    int client_fds[MAX_CLIENT];
-    size_t clients = MAX_CLIENT;
+    const ws_client_t* client = ctx;
+    return client && client->fd && client->uart == uart_stream;
+}
 
-    if (httpd_get_client_list(server, &clients, client_fds) != ESP_OK)
-        return false;
+// Queues frame on every live session of the stream. A full queue first gives up its oldest
+// droppable frame; a client whose queue holds only frames that must be kept is closed.
+// Returns true if the sender task has work.
+enum ws_push_result
+{
+    WS_PUSH_QUEUED,
+    WS_PUSH_DROPPED,
+    WS_PUSH_OVERFLOW,
+};
 
-    cleanup_client_fds(client_fds, clients);
-    for (size_t i = 0; i < clients; ++i)
+// Appends frame to one session's queue, evicting the oldest droppable frame if it is
+// full. Caller holds ws_client_lock and releases *evicted afterwards.
+static enum ws_push_result ws_client_push(ws_client_t* client, ws_frame_t* frame, TickType_t now,
+                                          ws_frame_t** evicted)
+{
+    *evicted = NULL;
+    if (client->count == WS_CLIENT_QUEUE_LENGTH)
     {
-        if (httpd_sess_get_ctx(server, client_fds[i]) == &uart_ws_session && !fd_in_list(blocked_ws_fds, client_fds[i]) &&
-            httpd_ws_get_fd_info(server, client_fds[i]) == HTTPD_WS_CLIENT_WEBSOCKET)
-            return true;
+        int victim = -1;
+        for (uint8_t pos = 0; pos < client->count && victim < 0; ++pos)
+        {
+            if (ws_frame_droppable(client->frames[(client->head + pos) % WS_CLIENT_QUEUE_LENGTH]))
+                victim = pos;
+        }
+
+        if (victim < 0)
+        {
+            if (!ws_frame_droppable(frame))
+                return WS_PUSH_OVERFLOW;
+            client->dropped++;
+            return WS_PUSH_DROPPED;
+        }
+        *evicted = ws_client_remove_at(client, victim);
+        client->dropped++;
     }
 
-    return false;
+    uint8_t index = (client->head + client->count) % WS_CLIENT_QUEUE_LENGTH;
+    client->frames[index] = frame;
+    client->queued_at[index] = now;
+    if (++client->count > client->max_depth)
+        client->max_depth = client->count;
+    ws_frame_ref(frame);
+    return WS_PUSH_QUEUED;
 }
 
-static bool status_websocket_client_connected(httpd_handle_t server)
+static bool ws_clients_enqueue(ws_frame_t* frame, bool uart_stream)
 {
-    int client_fds[MAX_CLIENT];
-    size_t clients = MAX_CLIENT;
+    ws_frame_t* evicted[MAX_CLIENT];
+    ws_client_t* overflow[MAX_CLIENT];
+    int overflow_fds[MAX_CLIENT];
+    size_t evicted_count = 0;
+    size_t overflow_count = 0;
+    uint32_t drops = 0;
+    bool queued = false;
+    TickType_t now = xTaskGetTickCount();
+
+    taskENTER_CRITICAL(&ws_client_lock);
+    for (uint8_t i = 0; i < ws_live_count[uart_stream]; ++i)
+    {
+        ws_client_t* client = &ws_clients[ws_live_slots[uart_stream][i]];
 
-    if (httpd_get_client_list(server, &clients, client_fds) != ESP_OK)
-        return false;
+        if (!uart_stream && frame->payload < WS_PAYLOAD_TAG_LIMIT)
+        {
+            uint8_t every = client->decimation[frame->payload];
+            if (!every || ++client->decimation_count[frame->payload] < every)
+                continue;
+            client->decimation_count[frame->payload] = 0;
+        }
+
+        ws_frame_t* victim;
+        enum ws_push_result result = ws_client_push(client, frame, now, &victim);
+        if (victim)
+        {
+            evicted[evicted_count++] = victim;
+            drops++;
+        }
+        if (result == WS_PUSH_QUEUED)
+        {
+            queued = true;
+        }
+        else if (result == WS_PUSH_DROPPED)
+        {
+            drops++;
+        }
+        else
+        {
+            overflow[overflow_count] = client;
+            overflow_fds[overflow_count++] = client->fd;
+        }
+    }
+    taskEXIT_CRITICAL(&ws_client_lock);
 
-    cleanup_client_fds(client_fds, clients);
-    for (size_t i = 0; i < clients; ++i)
+    for (size_t i = 0; i < evicted_count; ++i)
+        ws_frame_release(evicted[i]);
+
+    if (uart_stream)
+        uart_queue_drops += drops;
+    else
+        status_queue_drops += drops;
+
+    for (size_t i = 0; i < overflow_count; ++i)
     {
-        if (httpd_sess_get_ctx(server, client_fds[i]) == &status_ws_session && !fd_in_list(blocked_ws_fds, client_fds[i]) &&
-            httpd_ws_get_fd_info(server, client_fds[i]) == HTTPD_WS_CLIENT_WEBSOCKET)
-            return true;
+        ESP_LOGW(TAG, "fd %d fell %d frames behind, closing", overflow_fds[i], WS_CLIENT_QUEUE_LENGTH);
+        ws_client_close(status_sender.server, overflow[i], overflow_fds[i]);
     }
 
-    return false;
+    return queued;
+}
+
+// Sending to a socket whose buffer is full would block the whole stream, so such a client
+// is skipped and retried; its queue absorbs the backlog.
+static bool ws_fd_writable(int fd)
+{
+    fd_set write_fds;
+    FD_ZERO(&write_fds);
+    FD_SET(fd, &write_fds);
+    struct timeval timeout = {0};
+    return select(fd + 1, NULL, &write_fds, NULL, &timeout) > 0;
 }
 
 static void ws_sender_task(void* arg)
 {
     const struct ws_sender_config* config = arg;
     httpd_handle_t server = config->server;
-    struct ws_message msg;
-    int client_fds[MAX_CLIENT];
     TickType_t last_lru_update = 0;
+    TickType_t wait = portMAX_DELAY;
 
     while (1)
     {
-        if (xQueueReceive(config->queue, &msg, portMAX_DELAY) != pdPASS)
-            continue;
-
-        if (config->uart_stream && heap_caps_get_free_size(MALLOC_CAP_8BIT) < UART_MIN_FREE_HEAP)
+        ulTaskNotifyTake(pdTRUE, wait);
+        wait = portMAX_DELAY;
+
+        TickType_t now = xTaskGetTickCount();
+        bool update_uart_lru =
+            config->uart_stream &&
+            (last_lru_update == 0 || now - last_lru_update >= pdMS_TO_TICKS(UART_WS_LRU_UPDATE_INTERVAL_MS));
+        bool uart_lru_updated = false;
+
+        // One frame per client per pass, so a deep queue cannot starve the other clients.
+        bool sent_any;
+        do
         {
-            uart_queue_drops++;
-            free(msg.data);
-            continue;
-        }
+            sent_any = false;
 
-        size_t clients = MAX_CLIENT;
-        if (httpd_get_client_list(server, &clients, client_fds) == ESP_OK)
-        {
-            TickType_t now = xTaskGetTickCount();
-            bool update_uart_lru =
-                config->uart_stream &&
-                (last_lru_update == 0 ||
-                 now - last_lru_update >= pdMS_TO_TICKS(UART_WS_LRU_UPDATE_INTERVAL_MS));
-            bool uart_lru_updated = false;
-
-            cleanup_client_fds(client_fds, clients);
-
-            httpd_ws_frame_t frame = {
-                .payload = msg.data,
-                .len = msg.len,
-                .type = HTTPD_WS_TYPE_BINARY,
-            };
-
-            for (size_t i = 0; i < clients; ++i)
+            uint8_t slots[MAX_CLIENT];
+            uint8_t slot_count;
+            taskENTER_CRITICAL(&ws_client_lock);
+            slot_count = ws_live_count[config->uart_stream];
+            memcpy(slots, ws_live_slots[config->uart_stream], slot_count);
+            taskEXIT_CRITICAL(&ws_client_lock);
+
+            for (uint8_t i = 0; i < slot_count; ++i)
             {
-                int fd = client_fds[i];
-                if (httpd_sess_get_ctx(server, fd) != (config->uart_stream ? (void*)&uart_ws_session : (void*)&status_ws_session) ||
-                    fd_in_list(blocked_ws_fds, fd) ||
-                    httpd_ws_get_fd_info(server, fd) != HTTPD_WS_CLIENT_WEBSOCKET)
+                ws_client_t* client = &ws_clients[slots[i]];
+
+                taskENTER_CRITICAL(&ws_client_lock);
+                int fd = client->closing ? 0 : client->fd;
+                uint8_t pending = client->count;
+                taskEXIT_CRITICAL(&ws_client_lock);
+
+                if (!fd || !pending)
+                    continue;
+                if (!ws_fd_writable(fd))
+                {
+                    wait = pdMS_TO_TICKS(WS_CLIENT_RETRY_MS);
+                    continue;
+                }
+
+                ws_frame_t* msg = NULL;
+                TickType_t queued_at = 0;
+                taskENTER_CRITICAL(&ws_client_lock);
+                if (client->fd == fd && client->count)
+                {
+                    queued_at = client->queued_at[client->head];
+                    msg = ws_client_remove_at(client, 0);
+                }
+                taskEXIT_CRITICAL(&ws_client_lock);
+                if (!msg)
                     continue;
 
+                // The queue's reference now belongs to this send.
+                httpd_ws_frame_t frame = {
+                    .payload = msg->data,
+                    .len = msg->len,
+                    .type = msg->text ? HTTPD_WS_TYPE_TEXT : HTTPD_WS_TYPE_BINARY,
+                };
                 esp_err_t err = httpd_ws_send_frame_async(server, fd, &frame);
+                ws_frame_release(msg);
+
+                uint32_t lag_ms = (xTaskGetTickCount() - queued_at) * portTICK_PERIOD_MS;
+                taskENTER_CRITICAL(&ws_client_lock);
+                if (client->fd == fd)
+                {
+                    if (err == ESP_OK)
+                        client->sent++;
+                    if (lag_ms > client->max_lag_ms)
+                        client->max_lag_ms = lag_ms;
+                }
+                taskEXIT_CRITICAL(&ws_client_lock);
+
                 if (err != ESP_OK)
                 {
                     websocket_send_failures++;
-                    add_fd_to_list(blocked_ws_fds, fd);
                     ESP_LOGW(TAG, "%s: send failed for fd %d: %s", config->name, fd, esp_err_to_name(err));
-                    httpd_sess_trigger_close(server, fd);
+                    ws_client_close(server, client, fd);
+                    continue;
                 }
-                else if (update_uart_lru && httpd_sess_update_lru_counter(server, fd) == ESP_OK)
-                {
+
+                sent_any = true;
+                if (update_uart_lru && httpd_sess_update_lru_counter(server, fd) == ESP_OK)
                     uart_lru_updated = true;
-                }
             }
+        } while (sent_any);
 
-            if (uart_lru_updated)
-                last_lru_update = now;
-        }
-        free(msg.data);
+        if (uart_lru_updated)
+            last_lru_update = now;
     }
 }
 
 static void uart_polling_task(void* arg)
 {
-    httpd_handle_t server = arg;
     static uint8_t data_buf[BUF_SIZE];
 
     while (1)
@@ -240,39 +578,35 @@ static void uart_polling_task(void* arg)
             continue;
         }
 
-        size_t read_len = available_len < sizeof(data_buf) ? available_len : sizeof(data_buf);
-        int bytes_read = uart_read_bytes(UART_NUM, data_buf, read_len, 0);
-        if (bytes_read <= 0)
-            continue;
-
-        uart_received_bytes += bytes_read;
-
-        if (!uart_websocket_client_connected(server))
-            continue;
+        // Read straight into a pool frame when it can be forwarded; otherwise the bytes are
+        // drained into data_buf and dropped so the UART FIFO keeps moving.
+        ws_frame_t* frame = NULL;
+        bool forward = ws_stream_has_clients(true);
+        if (forward)
+            frame = ws_frame_alloc(BUF_SIZE);
 
-        if (uxQueueSpacesAvailable(uart_ws_queue) == 0 ||
-            heap_caps_get_free_size(MALLOC_CAP_8BIT) < UART_MIN_FREE_HEAP)
+        uint8_t* dest = frame ? frame->data : data_buf;
+        size_t read_len = available_len < BUF_SIZE ? available_len : BUF_SIZE;
+        int bytes_read = uart_read_bytes(UART_NUM, dest, read_len, 0);
+        if (bytes_read <= 0)
         {
-            uart_queue_drops++;
+            ws_frame_release(frame);
             continue;
         }
 
-        struct ws_message msg = {
-            .data = malloc(bytes_read),
-            .len = bytes_read,
-        };
-        if (!msg.data)
+        uart_received_bytes += bytes_read;
+
+        if (!frame)
         {
-            uart_queue_drops++;
+            if (forward)
+                uart_queue_drops++;
             continue;
         }
-        memcpy(msg.data, data_buf, bytes_read);
 
-        if (xQueueSend(uart_ws_queue, &msg, 0) != pdPASS)
-        {
-            uart_queue_drops++;
-            free(msg.data);
-        }
+        frame->len = bytes_read;
+        if (ws_clients_enqueue(frame, true))
+            xTaskNotifyGive(uart_sender.task);
+        ws_frame_release(frame);
     }
 }
 
@@ -301,7 +635,10 @@ static void uart_event_task(void* arg)
     }
 }
 
-static esp_err_t websocket_handshake(httpd_req_t* req, bool uart_stream)
+// Runs twice per connection: from the pre-handshake callback, which authenticates and
+// reserves the slot, and from the handler once the upgrade response went out, which
+// registers the session for streaming.
+static esp_err_t websocket_handshake(httpd_req_t* req, bool uart_stream, bool handshake_done)
 {
     size_t query_len = httpd_req_get_url_query_len(req) + 1;
     if (query_len <= 1)
@@ -322,8 +659,14 @@ static esp_err_t websocket_handshake(httpd_req_t* req, bool uart_stream)
     free(query);
 
     int fd = httpd_req_to_sockfd(req);
-    remove_fd_from_list(blocked_ws_fds, fd);
-    req->sess_ctx = uart_stream ? (void*)&uart_ws_session : (void*)&status_ws_session;
+    ws_client_t* client = ws_client_acquire(fd, uart_stream, handshake_done);
+    if (!client)
+    {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "No free WebSocket slot");
+        return ESP_FAIL;
+    }
+
+    req->sess_ctx = client;
     req->free_ctx = websocket_session_ctx_free;
 
     return ESP_OK;
@@ -331,26 +674,145 @@ static esp_err_t websocket_handshake(httpd_req_t* req, bool uart_stream)
 
 static esp_err_t ws_pre_handshake_cb(httpd_req_t* req)
 {
-    return websocket_handshake(req, req->user_ctx == &uart_ws_session);
+    return websocket_handshake(req, req->user_ctx == &uart_ws_session, false);
+}
+
+// Replies go through the session's own queue behind the frames already waiting, so the
+// sender task is the only writer on the socket.
+static esp_err_t ws_queue_text(httpd_req_t* req, const char* text)
+{
+    ws_client_t* client = req->sess_ctx;
+    int fd = httpd_req_to_sockfd(req);
+    size_t len = strlen(text);
+
+    // A reply that cannot be queued is dropped; failing the handler would close the session.
+    ws_frame_t* frame = ws_frame_alloc(len);
+    if (!frame)
+    {
+        ESP_LOGW(TAG, "fd %d: no frame for a %u byte reply", fd, (unsigned)len);
+        return ESP_OK;
+    }
+    memcpy(frame->data, text, len);
+    frame->len = len;
+    frame->text = true;
+
+    enum ws_push_result result = WS_PUSH_DROPPED;
+    ws_frame_t* evicted = NULL;
+    taskENTER_CRITICAL(&ws_client_lock);
+    if (client && client->fd == fd && !client->closing)
+        result = ws_client_push(client, frame, xTaskGetTickCount(), &evicted);
+    taskEXIT_CRITICAL(&ws_client_lock);
+
+    ws_frame_release(evicted);
+    ws_frame_release(frame);
+    if (result == WS_PUSH_OVERFLOW)
+    {
+        ESP_LOGW(TAG, "fd %d fell %d frames behind, closing", fd, WS_CLIENT_QUEUE_LENGTH);
+        ws_client_close(req->handle, client, fd);
+    }
+    else if (result == WS_PUSH_QUEUED)
+    {
+        xTaskNotifyGive(client->uart ? uart_sender.task : status_sender.task);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t ws_send_text(httpd_req_t* req, cJSON* root)
+{
+    char* text = root ? cJSON_PrintUnformatted(root) : NULL;
+    cJSON_Delete(root);
+    if (!text)
+        return ESP_ERR_NO_MEM;
+
+    esp_err_t err = ws_queue_text(req, text);
+    free(text);
+    return err;
+}
+
+static esp_err_t ws_send_error(httpd_req_t* req, const char* message)
+{
+    cJSON* root = cJSON_CreateObject();
+    if (root)
+        cJSON_AddStringToObject(root, "error", message);
+    return ws_send_text(req, root);
+}
+
+// {"subscribe": {"sensor_data": 10, "event_data": 1}} replaces the session's subscription:
+// each listed payload type is sent every Nth frame (0-255, where 0 turns it off), unlisted
+// ones not at all.
+// The reply echoes the subscription now in effect.
+static esp_err_t ws_handle_subscribe(httpd_req_t* req, const cJSON* streams)
+{
+    if (!cJSON_IsObject(streams))
+        return ws_send_error(req, "subscribe must be an object");
+
+    uint8_t decimation[WS_PAYLOAD_TAG_LIMIT] = {0};
+    const cJSON* item;
+    cJSON_ArrayForEach(item, streams)
+    {
+        int tag = -1;
+        for (size_t i = 0; i < sizeof(ws_payload_names) / sizeof(ws_payload_names[0]); ++i)
+        {
+            if (strcmp(item->string, ws_payload_names[i].name) == 0)
+                tag = ws_payload_names[i].tag;
+        }
+        if (tag < 0)
+            return ws_send_error(req, "Unknown payload type");
+        if (!cJSON_IsNumber(item) || item->valuedouble != item->valueint || item->valueint < 0 ||
+            item->valueint > UINT8_MAX)
+            return ws_send_error(req, "Decimation must be an integer from 0 to 255");
+        decimation[tag] = item->valueint;
+    }
+
+    ws_client_t* client = req->sess_ctx;
+    if (!ws_session_is(client, false))
+        return ws_send_error(req, "Not a status session");
+
+    taskENTER_CRITICAL(&ws_client_lock);
+    memcpy(client->decimation, decimation, sizeof(decimation));
+    memset(client->decimation_count, 0, sizeof(client->decimation_count));
+    ws_update_registry();
+    taskEXIT_CRITICAL(&ws_client_lock);
+
+    cJSON* root = cJSON_CreateObject();
+    cJSON* subscribed = root ? cJSON_AddObjectToObject(root, "subscribed") : NULL;
+    for (size_t i = 0; subscribed && i < sizeof(ws_payload_names) / sizeof(ws_payload_names[0]); ++i)
+    {
+        if (decimation[ws_payload_names[i].tag])
+            cJSON_AddNumberToObject(subscribed, ws_payload_names[i].name, decimation[ws_payload_names[i].tag]);
+    }
+    return ws_send_text(req, root);
 }
 
 static esp_err_t ws_handler(httpd_req_t* req)
 {
     if (req->method == HTTP_GET)
-        return websocket_handshake(req, false);
+        return websocket_handshake(req, false, true);
 
     httpd_ws_frame_t frame = {0};
     uint8_t buffer[BUF_SIZE];
     frame.payload = buffer;
-    esp_err_t err = httpd_ws_recv_frame(req, &frame, sizeof(buffer));
+    esp_err_t err = httpd_ws_recv_frame(req, &frame, sizeof(buffer) - 1);
     if (err != ESP_OK)
         return err;
 
     if (frame.type == HTTPD_WS_TYPE_TEXT && frame.len == strlen("ping") &&
         strncmp((const char*)frame.payload, "ping", frame.len) == 0)
     {
-        httpd_ws_frame_t pong = {.payload = (uint8_t*)"pong", .len = strlen("pong"), .type = HTTPD_WS_TYPE_TEXT};
-        return httpd_ws_send_frame(req, &pong);
+        return ws_queue_text(req, "pong");
+    }
+
+    if (frame.type == HTTPD_WS_TYPE_TEXT && frame.len > 0 && buffer[0] == '{')
+    {
+        buffer[frame.len] = '\0';
+        cJSON* root = cJSON_Parse((const char*)buffer);
+        if (!root)
+            return ws_send_error(req, "Invalid JSON");
+
+        const cJSON* streams = cJSON_GetObjectItem(root, "subscribe");
+        err = streams ? ws_handle_subscribe(req, streams) : ws_send_error(req, "Unknown control message");
+        cJSON_Delete(root);
+        return err;
     }
     return ESP_OK;
 }
@@ -358,7 +820,7 @@ static esp_err_t ws_handler(httpd_req_t* req)
 static esp_err_t uart_ws_handler(httpd_req_t* req)
 {
     if (req->method == HTTP_GET)
-        return websocket_handshake(req, true);
+        return websocket_handshake(req, true, true);
 
     httpd_ws_frame_t frame = {0};
     uint8_t buffer[BUF_SIZE];
@@ -414,33 +876,23 @@ void register_ws_endpoint(httpd_handle_t server)
     httpd_register_uri_handler(server, &ws);
     httpd_register_uri_handler(server, &uart_ws);
 
-    status_ws_queue = xQueueCreate(10, sizeof(struct ws_message));
-    uart_ws_queue = xQueueCreate(UART_WS_QUEUE_LENGTH, sizeof(struct ws_message));
-    status_sender = (struct ws_sender_config){
-        .queue = status_ws_queue, .server = server, .uart_stream = false, .name = "ws-status"};
-    uart_sender = (struct ws_sender_config){
-        .queue = uart_ws_queue, .server = server, .uart_stream = true, .name = "ws-uart"};
-    xTaskCreate(uart_polling_task, "uart_polling_task", 1024 * 4, server, 8, NULL);
-    xTaskCreate(ws_sender_task, "ws_status_sender", 1024 * 6, &status_sender, 9, NULL);
-    xTaskCreate(ws_sender_task, "ws_uart_sender", 1024 * 6, &uart_sender, 9, NULL);
+    ws_frame_pool_init();
+    status_sender = (struct ws_sender_config){.server = server, .uart_stream = false, .name = "ws-status"};
+    uart_sender = (struct ws_sender_config){.server = server, .uart_stream = true, .name = "ws-uart"};
+    xTaskCreate(ws_sender_task, "ws_status_sender", 1024 * 6, &status_sender, 9, &status_sender.task);
+    xTaskCreate(ws_sender_task, "ws_uart_sender", 1024 * 6, &uart_sender, 9, &uart_sender.task);
+    xTaskCreate(uart_polling_task, "uart_polling_task", 1024 * 4, NULL, 8, NULL);
     xTaskCreate(uart_event_task, "uart_event_task", 1024 * 2, NULL, 10, NULL);
 }
 
-void push_data_to_ws(const uint8_t* data, size_t len)
+void push_frame_to_ws(ws_frame_t* frame)
 {
-    if (!status_websocket_client_connected(status_sender.server))
+    if (!frame)
         return;
 
-    struct ws_message msg = {.data = malloc(len), .len = len};
-    if (!msg.data)
-        return;
-    memcpy(msg.data, data, len);
-
-    if (xQueueSend(status_ws_queue, &msg, 0) != pdPASS)
-    {
-        status_queue_drops++;
-        free(msg.data);
-    }
+    if (status_sender.task && ws_stream_has_clients(false) && ws_clients_enqueue(frame, false))
+        xTaskNotifyGive(status_sender.task);
+    ws_frame_release(frame);
 }
 
 void websocket_get_diagnostics(websocket_diagnostics_t* diagnostics)
@@ -449,11 +901,29 @@ void websocket_get_diagnostics(websocket_diagnostics_t* diagnostics)
         return;
 
     memset(diagnostics, 0, sizeof(*diagnostics));
-    if (uart_ws_queue)
+    diagnostics->queue_capacity = WS_CLIENT_QUEUE_LENGTH;
+
+    TickType_t now = xTaskGetTickCount();
+    taskENTER_CRITICAL(&ws_client_lock);
+    for (size_t i = 0; i < MAX_CLIENT; ++i)
     {
-        diagnostics->queue_depth = uxQueueMessagesWaiting(uart_ws_queue);
-        diagnostics->queue_capacity = diagnostics->queue_depth + uxQueueSpacesAvailable(uart_ws_queue);
+        const ws_client_t* client = &ws_clients[i];
+        if (!client->fd)
+            continue;
+
+        websocket_client_diagnostics_t* entry = &diagnostics->clients[diagnostics->client_count++];
+        entry->fd = client->fd;
+        entry->uart = client->uart;
+        entry->queue_depth = client->count;
+        entry->max_queue_depth = client->max_depth;
+        entry->lag_ms = client->count ? (now - client->queued_at[client->head]) * portTICK_PERIOD_MS : 0;
+        entry->max_lag_ms = client->max_lag_ms;
+        entry->sent = client->sent;
+        entry->dropped = client->dropped;
+        if (client->count > diagnostics->queue_depth)
+            diagnostics->queue_depth = client->count;
     }
+    taskEXIT_CRITICAL(&ws_client_lock);
     if (uart_event_queue)
         uart_get_buffered_data_len(UART_NUM, &diagnostics->uart_buffered_bytes);
 
@@ -463,6 +933,14 @@ void websocket_get_diagnostics(websocket_diagnostics_t* diagnostics)
     diagnostics->uart_queue_drops = uart_queue_drops;
     diagnostics->status_queue_drops = status_queue_drops;
     diagnostics->websocket_send_failures = websocket_send_failures;
+    diagnostics->frame_alloc_failures = ws_frame_alloc_failures;
+
+    taskENTER_CRITICAL(&ws_frame_lock);
+    diagnostics->small_frames_free = ws_small_free;
+    diagnostics->small_frames_low_water = ws_small_low_water;
+    diagnostics->large_frames_free = ws_large_free;
+    diagnostics->large_frames_low_water = ws_large_low_water;
+    taskEXIT_CRITICAL(&ws_frame_lock);
 }
 
 esp_err_t change_baud_rate(int baud_rate)
@@ -140,6 +140,33 @@ export async function postPeriodSetting(period) {
     return await handleResponse(response);
 }
 
+/**
+ * Posts the INA3221 averaging and conversion times to the server.
+ * @param {number} averaging Samples averaged per conversion.
+ * @param {number} busCtUs Bus voltage conversion time in microseconds.
+ * @param {number} shuntCtUs Shunt voltage conversion time in microseconds.
+ * @param {string} format Sensor stream encoding, 'float', 'raw' or 'batch'.
+ * @param {string} channels Enabled channels, a comma separated subset of 'usb,main,vin'.
+ * @returns {Promise<Object>} A promise that resolves to the server response with the resulting timing.
+ */
+export async function postSensorTimingSetting(averaging, busCtUs, shuntCtUs, format, channels) {
+    const response = await fetch('/api/setting', {
+        method: 'POST',
+        headers: {
+            'Content-Type': 'application/json',
+            ...getAuthHeaders(),
+        },
+        body: JSON.stringify({
+            sensor_averaging: averaging,
+            sensor_bus_ct_us: busCtUs,
+            sensor_shunt_ct_us: shuntCtUs,
+            sensor_format: format,
+            sensor_channels: channels,
+        }),
+    });
+    return await handleResponse(response).then(res => res.json());
+}
+
 /**
  * Enables or disables restoring the last output states after input power loss.
  * @param {boolean} enabled Whether output state restoration should be enabled.
@@ -169,6 +196,19 @@ export async function fetchSettings() {
     return await handleResponse(response).then(res => res.json());
 }
 
+/**
+ * Fetches journaled events newer than a sequence number, one page at a time.
+ * @param {number} since The last sequence number already seen.
+ * @returns {Promise<Object>} A promise that resolves to { events, next_since, more, oldest_seq, latest_seq }.
+ * @throws {Error} Throws an error if the network request fails.
+ */
+export async function fetchEventsSince(since) {
+    const response = await fetch(`/api/events?since=${since}`, {
+        headers: getAuthHeaders(),
+    });
+    return await handleResponse(response).then(res => res.json());
+}
+
 /**
  * Fetches the current status of the power control relays (12V and 5V).
  * @returns {Promise<Object>} A promise that resolves to an object with the power status.
@@ -70,18 +70,38 @@ function createChartOptions(title) {
 
 /**
  * Creates the dataset objects for a chart.
+ * @param {string} metric - The metric key plotted by the solid lines (e.g., 'current').
  * @param {string} unit - The unit for the dataset label (e.g., 'W', 'V', 'A').
+ * @param {string} [peakMetric] - Optional metric key plotted as a dashed line per channel (e.g., 'currentMax').
  * @returns {Array<Object>} An array of Chart.js dataset objects.
  */
-function createDatasets(unit) {
-    return channelKeys.map(channel => ({
+function createDatasets(metric, unit, peakMetric) {
+    const datasets = channelKeys.map(channel => ({
         label: `${channel} (${unit})`,
+        channel,
+        metric,
         data: initialData(),
         borderWidth: 2,
         fill: false,
         tension: 0.2,
         pointRadius: 0
     }));
+
+    if (peakMetric) {
+        // The device averages many conversions per message; the peak keeps short spikes visible.
+        channelKeys.forEach(channel => datasets.push({
+            label: `${channel} peak (${unit})`,
+            channel,
+            metric: peakMetric,
+            data: initialData(),
+            borderWidth: 1,
+            borderDash: [4, 4],
+            fill: false,
+            tension: 0,
+            pointRadius: 0
+        }));
+    }
+    return datasets;
 }
 
 /**
@@ -90,9 +110,10 @@ function createDatasets(unit) {
  * @param {string} title - The chart title.
  * @param {string} metric - The metric key ('power', 'voltage', 'current').
  * @param {string} unit - The data unit ('W', 'V', 'A').
+ * @param {string} [peakMetric] - Optional metric key for the per-channel peak lines.
  * @returns {Chart} A new Chart.js instance.
  */
-function initializeSingleChart(context, title, metric, unit) {
+function initializeSingleChart(context, title, metric, unit, peakMetric) {
     if (!context) return null;
 
     const options = createChartOptions(title);
@@ -102,7 +123,7 @@ function initializeSingleChart(context, title, metric, unit) {
 
     return new Chart(context, {
         type: 'line',
-        data: {labels: initialLabels(), datasets: createDatasets(unit)},
+        data: {labels: initialLabels(), datasets: createDatasets(metric, unit, peakMetric)},
         options: options
     });
 }
@@ -121,7 +142,7 @@ export function initCharts() {
 
     charts.power = initializeSingleChart(powerChartCtx, 'Power', 'power', 'W');
     charts.voltage = initializeSingleChart(voltageChartCtx, 'Voltage', 'voltage', 'V');
-    charts.current = initializeSingleChart(currentChartCtx, 'Current', 'current', 'A');
+    charts.current = initializeSingleChart(currentChartCtx, 'Current', 'current', 'A', 'currentMax');
 }
 
 /**
@@ -148,8 +169,8 @@ export function applyChartsTheme(themeName) {
         chart.options.plugins.legend.labels.color = labelColor;
         chart.options.plugins.title.color = labelColor;
 
-        chart.data.datasets.forEach((dataset, index) => {
-            dataset.borderColor = channelColors[index];
+        chart.data.datasets.forEach(dataset => {
+            dataset.borderColor = channelColors[channelKeys.indexOf(dataset.channel)];
         });
 
         chart.update('none');
@@ -171,10 +192,9 @@ function updateSingleChart(chart, metric, data, timeLabel) {
     // Shift old data and push new data
     chart.data.labels.shift();
     chart.data.labels.push(timeLabel);
-    chart.data.datasets.forEach((dataset, index) => {
+    chart.data.datasets.forEach(dataset => {
         dataset.data.shift();
-        const channel = channelKeys[index];
-        const value = data[channel]?.[metric];
+        const value = data[dataset.channel]?.[dataset.metric];
         dataset.data.push(value !== undefined ? value.toFixed(2) : null);
     });
 
@@ -17,6 +17,7 @@ export const powerActionButton = document.getElementById('power-action-button');
 export const voltageDisplay = document.getElementById('voltage-display');
 export const currentDisplay = document.getElementById('current-display');
 export const powerDisplay = document.getElementById('power-display');
+export const energyDisplay = document.getElementById('energy-display');
 export const uptimeDisplay = document.getElementById('uptime-display');
 
 // --- Terminal Elements ---
@@ -43,6 +44,7 @@ export const diagnosticsUart = document.getElementById('diagnostics-uart');
 export const diagnosticsUartErrors = document.getElementById('diagnostics-uart-errors');
 export const diagnosticsQueueDrops = document.getElementById('diagnostics-queue-drops');
 export const diagnosticsWsFailures = document.getElementById('diagnostics-ws-failures');
+export const diagnosticsSampling = document.getElementById('diagnostics-sampling');
 export const diagnosticsWifi = document.getElementById('diagnostics-wifi');
 export const diagnosticsWifiStaState = document.getElementById('diagnostics-wifi-sta-state');
 export const diagnosticsWifiLastDisconnect = document.getElementById('diagnostics-wifi-last-disconnect');
@@ -102,6 +104,17 @@ export const baudRateApplyButton = document.getElementById('baud-rate-apply-butt
 export const periodSlider = document.getElementById('period-slider');
 export const periodValue = document.getElementById('period-value');
 export const periodApplyButton = document.getElementById('period-apply-button');
+export const sensorAveragingSelect = document.getElementById('sensor-averaging-select');
+export const sensorBusCtSelect = document.getElementById('sensor-bus-ct-select');
+export const sensorShuntCtSelect = document.getElementById('sensor-shunt-ct-select');
+export const sensorFormatSelect = document.getElementById('sensor-format-select');
+export const sensorChannelCheckboxes = [
+    document.getElementById('sensor-channel-usb'),
+    document.getElementById('sensor-channel-main'),
+    document.getElementById('sensor-channel-vin'),
+];
+export const sensorTimingInfo = document.getElementById('sensor-timing-info');
+export const sensorTimingApplyButton = document.getElementById('sensor-timing-apply-button');
 export const restoreOutputStateToggle = document.getElementById('restore-output-state-toggle');
 export const restoreOutputStateApplyButton = document.getElementById('restore-output-state-apply-button');
 export const rebootButton = document.getElementById('reboot-button');
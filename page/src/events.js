@@ -83,6 +83,7 @@ async function refreshDiagnostics() {
         dom.diagnosticsUartErrors.textContent = `FIFO ${data.uart_fifo_overflows}, buffer ${data.uart_buffer_full_events}`;
         dom.diagnosticsQueueDrops.textContent = `UART ${data.uart_queue_drops}, status ${data.status_queue_drops}`;
         dom.diagnosticsWsFailures.textContent = data.websocket_send_failures;
+        dom.diagnosticsSampling.textContent = `${data.sensor_samples} samples, ${data.sensor_missed_deadlines} missed, max jitter ${(data.sensor_max_jitter_us / 1000).toFixed(1)} ms`;
         dom.diagnosticsWifi.textContent = data.wifi_connected ? `Connected (${data.wifi_rssi} dBm)` : 'Disconnected';
 
         const staState = data.wifi_sta_state || 'unknown';
@@ -362,6 +363,7 @@ export function setupEventListeners() {
     dom.apModeApplyButton.addEventListener('click', ui.applyApModeSettings);
     dom.baudRateApplyButton.addEventListener('click', ui.applyBaudRateSettings);
     dom.periodApplyButton.addEventListener('click', ui.applyPeriodSettings);
+    dom.sensorTimingApplyButton.addEventListener('click', ui.applySensorTimingSettings);
     dom.restoreOutputStateApplyButton.addEventListener('click', ui.applyRestoreOutputStateSetting);
 
     // --- Device Settings (Reboot & Period Slider) ---
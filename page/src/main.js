@@ -44,6 +44,14 @@ let uartReconnectDelayMs = 1000;
 const UART_RECONNECT_DELAY_MAX_MS = 10000;
 let browserOffline = false;
 let statusWebSocketConnected = false;
+// Highest journal sequence number shown, so a reconnect can fetch what was missed.
+let lastEventSeq = 0;
+const EVENT_CATCH_UP_MAX_PAGES = 10;
+// Wall clock minus esp_timer clock from the latest ClockSync, null until one arrives.
+let clockOffsetUs = null;
+// While SensorBatch frames arrive, recordings take their samples instead of the windows.
+let lastSensorBatchAt = 0;
+const SENSOR_BATCH_STALE_MS = 1000;
 
 // --- DOM Elements ---
 const loginContainer = document.getElementById('login-container');
@@ -134,6 +142,60 @@ function onWsOpen() {
     updateWebsocketStatus(true);
     console.log('Connected to WebSocket Server');
     updateUartStream();
+    fetchMissedEvents();
+}
+
+async function fetchMissedEvents() {
+    if (!lastEventSeq) return;
+
+    try {
+        let since = lastEventSeq;
+        for (let page = 0; page < EVENT_CATCH_UP_MAX_PAGES; page++) {
+            const result = await api.fetchEventsSince(since);
+            result.events.forEach(event => handleEvent({
+                seq: event.seq,
+                level: event.level,
+                timestampMs: event.timestamp_ms,
+                uptimeMs: event.uptime_ms,
+                message: event.message,
+            }));
+            if (!result.more) break;
+            since = result.next_since;
+        }
+    } catch (error) {
+        console.warn('Failed to fetch missed events:', error);
+    }
+}
+
+function handleEvent({seq, level, timestampMs, uptimeMs, message}) {
+    // Live events arriving while missed ones are fetched are not shown twice.
+    if (seq) {
+        if (seq <= lastEventSeq && recordedEvents.some(event => event.seq === seq)) return;
+        lastEventSeq = Math.max(lastEventSeq, seq);
+    }
+
+    recordedEvents.push({ seq, level, timestampMs, uptimeMs, message });
+    addEventToTable(level, timestampMs, uptimeMs, message);
+
+    const dateStr = timestampMs ? new Date(Number(timestampMs)).toLocaleString() : 'Unknown Time';
+    const uptimeStr = uptimeMs ? (Number(uptimeMs) / 1000).toFixed(0) : '0';
+
+    const prefix = `[PowerMate] (${dateStr}) (ut: ${uptimeStr}s)`;
+
+    switch (level) {
+        case 0: // EV_INFO
+            console.info(`${prefix} ${message}`);
+            break;
+        case 1: // EV_WARNING
+            console.warn(`${prefix} ${message}`);
+            break;
+        case 2: // EV_CRITICAL
+        case 3: // EV_FATAL
+            console.error(`${prefix} ${message}`);
+            break;
+        default:
+            console.log(`${prefix} ${message}`);
+    }
 }
 
 function onWsClose() {
@@ -191,6 +253,84 @@ function handleBrowserOnline() {
     updateUartStream();
 }
 
+/**
+ * Converts one channel of a SensorDataRaw message into the SensorData channel shape.
+ * @param {Object} raw - The decoded SensorDataRaw message.
+ * @param {number} index - Channel index (0 = USB, 1 = MAIN, 2 = VIN).
+ * @returns {Object|undefined} Channel data in volts, amps, watts, Wh and mAh, undefined if disabled.
+ */
+function rawChannel(raw, index) {
+    if (raw.disabledChannels & (1 << index)) return undefined;
+    const at = (values) => Number((values && values[index]) || 0);
+    const voltage = at(raw.voltageMv) / 1000;
+    const current = at(raw.currentUa) / 1e6;
+    return {
+        voltage,
+        current,
+        power: voltage * current,
+        voltageMin: at(raw.voltageMinMv) / 1000,
+        voltageMax: at(raw.voltageMaxMv) / 1000,
+        currentMin: at(raw.currentMinUa) / 1e6,
+        currentMax: at(raw.currentMaxUa) / 1e6,
+        energyWh: at(raw.energyUwh) / 1e6,
+        chargeMah: at(raw.chargeUah) / 1000,
+    };
+}
+
+/**
+ * Expands a SensorBatch message into one sensor payload per conversion.
+ * @param {Object} batch - The decoded SensorBatch message.
+ * @returns {Array<Object>} Payloads in the handleSensorPayload shape, oldest first.
+ */
+function batchSamples(batch) {
+    const count = batch.sampleCount || 0;
+    const busMv = batch.busMv || [];
+    const shuntRaw = batch.shuntRaw || [];
+    const deltas = batch.conversionDeltaUs || [];
+    const mohm = batch.shuntMohm || [];
+    const names = ['USB', 'MAIN', 'VIN'];
+    const bus = [0, 0, 0];
+    const shunt = [0, 0, 0];
+    const samples = [];
+    let conversionUs = Number(batch.firstConversionUs);
+
+    for (let i = 0; i < count; i++) {
+        if (i > 0) conversionUs += Number(deltas[i - 1] || 0);
+        const payload = {
+            timestamp: clockOffsetUs === null ? 0 : (conversionUs + clockOffsetUs) / 1000,
+            uptime: conversionUs / 1000,
+        };
+        names.forEach((name, ch) => {
+            // Values are deltas against the previous sample of the same channel.
+            bus[ch] += Number(busMv[i * 3 + ch] || 0);
+            shunt[ch] += Number(shuntRaw[i * 3 + ch] || 0);
+            if (batch.disabledChannels & (1 << ch)) return;
+            const voltage = bus[ch] / 1000;
+            const current = mohm[ch] ? shunt[ch] * 0.005 / mohm[ch] : 0;
+            payload[name] = {voltage, current, power: voltage * current};
+        });
+        samples.push(payload);
+    }
+    return samples;
+}
+
+/**
+ * Feeds one sensor update to the charts, header and recorder.
+ * @param {Object} sensorPayload - Channel data keyed by USB, MAIN and VIN plus timestamp and uptime.
+ */
+function handleSensorPayload(sensorPayload) {
+    updateSensorUI(sensorPayload);
+
+    if (isRecording && Date.now() - lastSensorBatchAt > SENSOR_BATCH_STALE_MS) {
+        recordedData.push(sensorPayload);
+    }
+
+    // Update uptime separately from the sensor data payload
+    if (sensorPayload.uptime !== undefined) {
+        updateUptimeUI(Number(sensorPayload.uptime) / 1000);
+    }
+}
+
 /**
  * Callback for when a message is received from the WebSocket server.
  * @param {MessageEvent} event - The WebSocket message event.
@@ -210,28 +350,54 @@ function onWsMessage(event) {
             case 'sensorData': {
                 const sensorData = decodedMessage.sensorData;
                 if (sensorData) {
-                    // Create a payload for the sensor UI (charts and header)
-                    const sensorPayload = {
-                        USB: sensorData.usb,
-                        MAIN: sensorData.main,
-                        VIN: sensorData.vin,
+                    // Create a payload for the sensor UI (charts and header); disabled channels are null
+                    handleSensorPayload({
+                        USB: sensorData.usb ?? undefined,
+                        MAIN: sensorData.main ?? undefined,
+                        VIN: sensorData.vin ?? undefined,
                         timestamp: sensorData.timestampMs,
                         uptime: sensorData.uptimeMs
-                    };
-                    updateSensorUI(sensorPayload);
+                    });
+                }
+                break;
+            }
+
+            case 'sensorDataRaw': {
+                const raw = decodedMessage.sensorDataRaw;
+                if (raw) {
+                    handleSensorPayload({
+                        USB: rawChannel(raw, 0),
+                        MAIN: rawChannel(raw, 1),
+                        VIN: rawChannel(raw, 2),
+                        timestamp: raw.timestampMs,
+                        uptime: raw.uptimeMs
+                    });
+                }
+                break;
+            }
 
-                    if (isRecording) {
-                        recordedData.push(sensorPayload);
-                    }
+            case 'sensorStats':
+                // Window summaries are meant for unattended monitors; the page plots live data.
+                break;
 
-                    // Update uptime separately from the sensor data payload
-                    if (sensorData.uptimeMs !== undefined) {
-                        updateUptimeUI(sensorData.uptimeMs / 1000);
-                    }
+            case 'sensorBatch': {
+                // Every conversion at full rate; the charts keep following the window messages
+                // and the recorder takes these instead.
+                lastSensorBatchAt = Date.now();
+                if (isRecording && decodedMessage.sensorBatch) {
+                    recordedData.push(...batchSamples(decodedMessage.sensorBatch));
                 }
                 break;
             }
 
+            case 'clockSync':
+                // Maps SensorBatch conversion times to wall time; the charts plot timestamp_ms.
+                if (decodedMessage.clockSync) {
+                    const sync = decodedMessage.clockSync;
+                    clockOffsetUs = Number(sync.wallUs) - Number(sync.uptimeUs);
+                }
+                break;
+
             case 'wifiStatus':
                 updateWifiStatusUI(decodedMessage.wifiStatus);
                 break;
@@ -248,33 +414,14 @@ function onWsMessage(event) {
 
             case 'eventData':
                 if (decodedMessage.eventData) {
-                    const level = decodedMessage.eventData.level;
-                    const msg = decodedMessage.eventData.message;
-                    const timestampMs = decodedMessage.eventData.timestampMs;
-                    const uptimeMs = decodedMessage.eventData.uptimeMs;
-
-                    recordedEvents.push({ level, timestampMs, uptimeMs, message: msg });
-                    addEventToTable(level, timestampMs, uptimeMs, msg);
-
-                    const dateStr = timestampMs ? new Date(Number(timestampMs)).toLocaleString() : 'Unknown Time';
-                    const uptimeStr = uptimeMs ? (Number(uptimeMs) / 1000).toFixed(0) : '0';
-
-                    const prefix = `[PowerMate] (${dateStr}) (ut: ${uptimeStr}s)`;
-
-                    switch (level) {
-                        case 0: // EV_INFO
-                            console.info(`${prefix} ${msg}`);
-                            break;
-                        case 1: // EV_WARNING
-                            console.warn(`${prefix} ${msg}`);
-                            break;
-                        case 2: // EV_CRITICAL
-                        case 3: // EV_FATAL
-                            console.error(`${prefix} ${msg}`);
-                            break;
-                        default:
-                            console.log(`${prefix} ${msg}`);
-                    }
+                    const event = decodedMessage.eventData;
+                    handleEvent({
+                        seq: event.seq,
+                        level: event.level,
+                        timestampMs: event.timestampMs,
+                        uptimeMs: event.uptimeMs,
+                        message: event.message,
+                    });
                 }
                 break;
             default:
@@ -440,14 +587,19 @@ function downloadCSV() {
     ];
     const csvRows = [headers.join(',')];
 
+    // Disabled channels are left empty
+    const channelColumns = (channel) => channel
+        ? [Number(channel.voltage).toFixed(3), Number(channel.current).toFixed(3), Number(channel.power).toFixed(3)]
+        : ['', '', ''];
+
     recordedData.forEach(data => {
         const timestamp = new Date(data.timestamp).toISOString();
         const row = [
             timestamp,
             data.uptime,
-            Number(data.VIN.voltage).toFixed(3), Number(data.VIN.current).toFixed(3), Number(data.VIN.power).toFixed(3),
-            Number(data.MAIN.voltage).toFixed(3), Number(data.MAIN.current).toFixed(3), Number(data.MAIN.power).toFixed(3),
-            Number(data.USB.voltage).toFixed(3), Number(data.USB.current).toFixed(3), Number(data.USB.power).toFixed(3)
+            ...channelColumns(data.VIN),
+            ...channelColumns(data.MAIN),
+            ...channelColumns(data.USB)
         ];
         csvRows.push(row.join(','));
     });
@@ -16,6 +16,12 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
      * @property {number|null} [voltage] SensorChannelData voltage
      * @property {number|null} [current] SensorChannelData current
      * @property {number|null} [power] SensorChannelData power
+     * @property {number|null} [voltageMin] SensorChannelData voltageMin
+     * @property {number|null} [voltageMax] SensorChannelData voltageMax
+     * @property {number|null} [currentMin] SensorChannelData currentMin
+     * @property {number|null} [currentMax] SensorChannelData currentMax
+     * @property {number|null} [energyWh] SensorChannelData energyWh
+     * @property {number|null} [chargeMah] SensorChannelData chargeMah
      */
 
     /**
@@ -57,6 +63,54 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
      */
     SensorChannelData.prototype.power = 0;
 
+    /**
+     * SensorChannelData voltageMin.
+     * @member {number} voltageMin
+     * @memberof SensorChannelData
+     * @instance
+     */
+    SensorChannelData.prototype.voltageMin = 0;
+
+    /**
+     * SensorChannelData voltageMax.
+     * @member {number} voltageMax
+     * @memberof SensorChannelData
+     * @instance
+     */
+    SensorChannelData.prototype.voltageMax = 0;
+
+    /**
+     * SensorChannelData currentMin.
+     * @member {number} currentMin
+     * @memberof SensorChannelData
+     * @instance
+     */
+    SensorChannelData.prototype.currentMin = 0;
+
+    /**
+     * SensorChannelData currentMax.
+     * @member {number} currentMax
+     * @memberof SensorChannelData
+     * @instance
+     */
+    SensorChannelData.prototype.currentMax = 0;
+
+    /**
+     * SensorChannelData energyWh.
+     * @member {number} energyWh
+     * @memberof SensorChannelData
+     * @instance
+     */
+    SensorChannelData.prototype.energyWh = 0;
+
+    /**
+     * SensorChannelData chargeMah.
+     * @member {number} chargeMah
+     * @memberof SensorChannelData
+     * @instance
+     */
+    SensorChannelData.prototype.chargeMah = 0;
+
     /**
      * Creates a new SensorChannelData instance using the specified properties.
      * @function create
@@ -87,6 +141,18 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
             writer.uint32(/* id 2, wireType 5 =*/21).float(message.current);
         if (message.power != null && Object.hasOwnProperty.call(message, "power"))
             writer.uint32(/* id 3, wireType 5 =*/29).float(message.power);
+        if (message.voltageMin != null && Object.hasOwnProperty.call(message, "voltageMin"))
+            writer.uint32(/* id 4, wireType 5 =*/37).float(message.voltageMin);
+        if (message.voltageMax != null && Object.hasOwnProperty.call(message, "voltageMax"))
+            writer.uint32(/* id 5, wireType 5 =*/45).float(message.voltageMax);
+        if (message.currentMin != null && Object.hasOwnProperty.call(message, "currentMin"))
+            writer.uint32(/* id 6, wireType 5 =*/53).float(message.currentMin);
+        if (message.currentMax != null && Object.hasOwnProperty.call(message, "currentMax"))
+            writer.uint32(/* id 7, wireType 5 =*/61).float(message.currentMax);
+        if (message.energyWh != null && Object.hasOwnProperty.call(message, "energyWh"))
+            writer.uint32(/* id 8, wireType 5 =*/69).float(message.energyWh);
+        if (message.chargeMah != null && Object.hasOwnProperty.call(message, "chargeMah"))
+            writer.uint32(/* id 9, wireType 5 =*/77).float(message.chargeMah);
         return writer;
     };
 
@@ -135,6 +201,30 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
                     message.power = reader.float();
                     break;
                 }
+            case 4: {
+                    message.voltageMin = reader.float();
+                    break;
+                }
+            case 5: {
+                    message.voltageMax = reader.float();
+                    break;
+                }
+            case 6: {
+                    message.currentMin = reader.float();
+                    break;
+                }
+            case 7: {
+                    message.currentMax = reader.float();
+                    break;
+                }
+            case 8: {
+                    message.energyWh = reader.float();
+                    break;
+                }
+            case 9: {
+                    message.chargeMah = reader.float();
+                    break;
+                }
             default:
                 reader.skipType(tag & 7);
                 break;
@@ -179,6 +269,24 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
         if (message.power != null && message.hasOwnProperty("power"))
             if (typeof message.power !== "number")
                 return "power: number expected";
+        if (message.voltageMin != null && message.hasOwnProperty("voltageMin"))
+            if (typeof message.voltageMin !== "number")
+                return "voltageMin: number expected";
+        if (message.voltageMax != null && message.hasOwnProperty("voltageMax"))
+            if (typeof message.voltageMax !== "number")
+                return "voltageMax: number expected";
+        if (message.currentMin != null && message.hasOwnProperty("currentMin"))
+            if (typeof message.currentMin !== "number")
+                return "currentMin: number expected";
+        if (message.currentMax != null && message.hasOwnProperty("currentMax"))
+            if (typeof message.currentMax !== "number")
+                return "currentMax: number expected";
+        if (message.energyWh != null && message.hasOwnProperty("energyWh"))
+            if (typeof message.energyWh !== "number")
+                return "energyWh: number expected";
+        if (message.chargeMah != null && message.hasOwnProperty("chargeMah"))
+            if (typeof message.chargeMah !== "number")
+                return "chargeMah: number expected";
         return null;
     };
 
@@ -200,6 +308,18 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
             message.current = Number(object.current);
         if (object.power != null)
             message.power = Number(object.power);
+        if (object.voltageMin != null)
+            message.voltageMin = Number(object.voltageMin);
+        if (object.voltageMax != null)
+            message.voltageMax = Number(object.voltageMax);
+        if (object.currentMin != null)
+            message.currentMin = Number(object.currentMin);
+        if (object.currentMax != null)
+            message.currentMax = Number(object.currentMax);
+        if (object.energyWh != null)
+            message.energyWh = Number(object.energyWh);
+        if (object.chargeMah != null)
+            message.chargeMah = Number(object.chargeMah);
         return message;
     };
 
@@ -220,6 +340,12 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
             object.voltage = 0;
             object.current = 0;
             object.power = 0;
+            object.voltageMin = 0;
+            object.voltageMax = 0;
+            object.currentMin = 0;
+            object.currentMax = 0;
+            object.energyWh = 0;
+            object.chargeMah = 0;
         }
         if (message.voltage != null && message.hasOwnProperty("voltage"))
             object.voltage = options.json && !isFinite(message.voltage) ? String(message.voltage) : message.voltage;
@@ -227,6 +353,18 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
             object.current = options.json && !isFinite(message.current) ? String(message.current) : message.current;
         if (message.power != null && message.hasOwnProperty("power"))
             object.power = options.json && !isFinite(message.power) ? String(message.power) : message.power;
+        if (message.voltageMin != null && message.hasOwnProperty("voltageMin"))
+            object.voltageMin = options.json && !isFinite(message.voltageMin) ? String(message.voltageMin) : message.voltageMin;
+        if (message.voltageMax != null && message.hasOwnProperty("voltageMax"))
+            object.voltageMax = options.json && !isFinite(message.voltageMax) ? String(message.voltageMax) : message.voltageMax;
+        if (message.currentMin != null && message.hasOwnProperty("currentMin"))
+            object.currentMin = options.json && !isFinite(message.currentMin) ? String(message.currentMin) : message.currentMin;
+        if (message.currentMax != null && message.hasOwnProperty("currentMax"))
+            object.currentMax = options.json && !isFinite(message.currentMax) ? String(message.currentMax) : message.currentMax;
+        if (message.energyWh != null && message.hasOwnProperty("energyWh"))
+            object.energyWh = options.json && !isFinite(message.energyWh) ? String(message.energyWh) : message.energyWh;
+        if (message.chargeMah != null && message.hasOwnProperty("chargeMah"))
+            object.chargeMah = options.json && !isFinite(message.chargeMah) ? String(message.chargeMah) : message.chargeMah;
         return object;
     };
 
@@ -262,25 +400,2667 @@ export const SensorChannelData = $root.SensorChannelData = (() => {
 export const SensorData = $root.SensorData = (() => {
 
     /**
-     * Properties of a SensorData.
-     * @exports ISensorData
-     * @interface ISensorData
-     * @property {ISensorChannelData|null} [usb] SensorData usb
-     * @property {ISensorChannelData|null} [main] SensorData main
-     * @property {ISensorChannelData|null} [vin] SensorData vin
-     * @property {number|Long|null} [timestampMs] SensorData timestampMs
-     * @property {number|Long|null} [uptimeMs] SensorData uptimeMs
+     * Properties of a SensorData.
+     * @exports ISensorData
+     * @interface ISensorData
+     * @property {ISensorChannelData|null} [usb] SensorData usb
+     * @property {ISensorChannelData|null} [main] SensorData main
+     * @property {ISensorChannelData|null} [vin] SensorData vin
+     * @property {number|Long|null} [timestampMs] SensorData timestampMs
+     * @property {number|Long|null} [uptimeMs] SensorData uptimeMs
+     * @property {number|null} [sampleCount] SensorData sampleCount
+     * @property {number|Long|null} [firstConversionUs] SensorData firstConversionUs
+     * @property {number|Long|null} [lastConversionUs] SensorData lastConversionUs
+     */
+
+    /**
+     * Constructs a new SensorData.
+     * @exports SensorData
+     * @classdesc Represents a SensorData.
+     * @implements ISensorData
+     * @constructor
+     * @param {ISensorData=} [properties] Properties to set
+     */
+    function SensorData(properties) {
+        if (properties)
+            for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
+                if (properties[keys[i]] != null)
+                    this[keys[i]] = properties[keys[i]];
+    }
+
+    /**
+     * SensorData usb.
+     * @member {ISensorChannelData|null|undefined} usb
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.usb = null;
+
+    /**
+     * SensorData main.
+     * @member {ISensorChannelData|null|undefined} main
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.main = null;
+
+    /**
+     * SensorData vin.
+     * @member {ISensorChannelData|null|undefined} vin
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.vin = null;
+
+    /**
+     * SensorData timestampMs.
+     * @member {number|Long} timestampMs
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.timestampMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorData uptimeMs.
+     * @member {number|Long} uptimeMs
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.uptimeMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorData sampleCount.
+     * @member {number} sampleCount
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.sampleCount = 0;
+
+    /**
+     * SensorData firstConversionUs.
+     * @member {number|Long} firstConversionUs
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.firstConversionUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorData lastConversionUs.
+     * @member {number|Long} lastConversionUs
+     * @memberof SensorData
+     * @instance
+     */
+    SensorData.prototype.lastConversionUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * Creates a new SensorData instance using the specified properties.
+     * @function create
+     * @memberof SensorData
+     * @static
+     * @param {ISensorData=} [properties] Properties to set
+     * @returns {SensorData} SensorData instance
+     */
+    SensorData.create = function create(properties) {
+        return new SensorData(properties);
+    };
+
+    /**
+     * Encodes the specified SensorData message. Does not implicitly {@link SensorData.verify|verify} messages.
+     * @function encode
+     * @memberof SensorData
+     * @static
+     * @param {ISensorData} message SensorData message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorData.encode = function encode(message, writer) {
+        if (!writer)
+            writer = $Writer.create();
+        if (message.usb != null && Object.hasOwnProperty.call(message, "usb"))
+            $root.SensorChannelData.encode(message.usb, writer.uint32(/* id 1, wireType 2 =*/10).fork()).ldelim();
+        if (message.main != null && Object.hasOwnProperty.call(message, "main"))
+            $root.SensorChannelData.encode(message.main, writer.uint32(/* id 2, wireType 2 =*/18).fork()).ldelim();
+        if (message.vin != null && Object.hasOwnProperty.call(message, "vin"))
+            $root.SensorChannelData.encode(message.vin, writer.uint32(/* id 3, wireType 2 =*/26).fork()).ldelim();
+        if (message.timestampMs != null && Object.hasOwnProperty.call(message, "timestampMs"))
+            writer.uint32(/* id 4, wireType 0 =*/32).uint64(message.timestampMs);
+        if (message.uptimeMs != null && Object.hasOwnProperty.call(message, "uptimeMs"))
+            writer.uint32(/* id 5, wireType 0 =*/40).uint64(message.uptimeMs);
+        if (message.sampleCount != null && Object.hasOwnProperty.call(message, "sampleCount"))
+            writer.uint32(/* id 6, wireType 0 =*/48).uint32(message.sampleCount);
+        if (message.firstConversionUs != null && Object.hasOwnProperty.call(message, "firstConversionUs"))
+            writer.uint32(/* id 7, wireType 0 =*/56).uint64(message.firstConversionUs);
+        if (message.lastConversionUs != null && Object.hasOwnProperty.call(message, "lastConversionUs"))
+            writer.uint32(/* id 8, wireType 0 =*/64).uint64(message.lastConversionUs);
+        return writer;
+    };
+
+    /**
+     * Encodes the specified SensorData message, length delimited. Does not implicitly {@link SensorData.verify|verify} messages.
+     * @function encodeDelimited
+     * @memberof SensorData
+     * @static
+     * @param {ISensorData} message SensorData message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorData.encodeDelimited = function encodeDelimited(message, writer) {
+        return this.encode(message, writer).ldelim();
+    };
+
+    /**
+     * Decodes a SensorData message from the specified reader or buffer.
+     * @function decode
+     * @memberof SensorData
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @param {number} [length] Message length if known beforehand
+     * @returns {SensorData} SensorData
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorData.decode = function decode(reader, length, error) {
+        if (!(reader instanceof $Reader))
+            reader = $Reader.create(reader);
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.SensorData();
+        while (reader.pos < end) {
+            let tag = reader.uint32();
+            if (tag === error)
+                break;
+            switch (tag >>> 3) {
+            case 1: {
+                    message.usb = $root.SensorChannelData.decode(reader, reader.uint32());
+                    break;
+                }
+            case 2: {
+                    message.main = $root.SensorChannelData.decode(reader, reader.uint32());
+                    break;
+                }
+            case 3: {
+                    message.vin = $root.SensorChannelData.decode(reader, reader.uint32());
+                    break;
+                }
+            case 4: {
+                    message.timestampMs = reader.uint64();
+                    break;
+                }
+            case 5: {
+                    message.uptimeMs = reader.uint64();
+                    break;
+                }
+            case 6: {
+                    message.sampleCount = reader.uint32();
+                    break;
+                }
+            case 7: {
+                    message.firstConversionUs = reader.uint64();
+                    break;
+                }
+            case 8: {
+                    message.lastConversionUs = reader.uint64();
+                    break;
+                }
+            default:
+                reader.skipType(tag & 7);
+                break;
+            }
+        }
+        return message;
+    };
+
+    /**
+     * Decodes a SensorData message from the specified reader or buffer, length delimited.
+     * @function decodeDelimited
+     * @memberof SensorData
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @returns {SensorData} SensorData
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorData.decodeDelimited = function decodeDelimited(reader) {
+        if (!(reader instanceof $Reader))
+            reader = new $Reader(reader);
+        return this.decode(reader, reader.uint32());
+    };
+
+    /**
+     * Verifies a SensorData message.
+     * @function verify
+     * @memberof SensorData
+     * @static
+     * @param {Object.<string,*>} message Plain object to verify
+     * @returns {string|null} `null` if valid, otherwise the reason why it is not
+     */
+    SensorData.verify = function verify(message) {
+        if (typeof message !== "object" || message === null)
+            return "object expected";
+        if (message.usb != null && message.hasOwnProperty("usb")) {
+            let error = $root.SensorChannelData.verify(message.usb);
+            if (error)
+                return "usb." + error;
+        }
+        if (message.main != null && message.hasOwnProperty("main")) {
+            let error = $root.SensorChannelData.verify(message.main);
+            if (error)
+                return "main." + error;
+        }
+        if (message.vin != null && message.hasOwnProperty("vin")) {
+            let error = $root.SensorChannelData.verify(message.vin);
+            if (error)
+                return "vin." + error;
+        }
+        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
+            if (!$util.isInteger(message.timestampMs) && !(message.timestampMs && $util.isInteger(message.timestampMs.low) && $util.isInteger(message.timestampMs.high)))
+                return "timestampMs: integer|Long expected";
+        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
+            if (!$util.isInteger(message.uptimeMs) && !(message.uptimeMs && $util.isInteger(message.uptimeMs.low) && $util.isInteger(message.uptimeMs.high)))
+                return "uptimeMs: integer|Long expected";
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            if (!$util.isInteger(message.sampleCount))
+                return "sampleCount: integer expected";
+        if (message.firstConversionUs != null && message.hasOwnProperty("firstConversionUs"))
+            if (!$util.isInteger(message.firstConversionUs) && !(message.firstConversionUs && $util.isInteger(message.firstConversionUs.low) && $util.isInteger(message.firstConversionUs.high)))
+                return "firstConversionUs: integer|Long expected";
+        if (message.lastConversionUs != null && message.hasOwnProperty("lastConversionUs"))
+            if (!$util.isInteger(message.lastConversionUs) && !(message.lastConversionUs && $util.isInteger(message.lastConversionUs.low) && $util.isInteger(message.lastConversionUs.high)))
+                return "lastConversionUs: integer|Long expected";
+        return null;
+    };
+
+    /**
+     * Creates a SensorData message from a plain object. Also converts values to their respective internal types.
+     * @function fromObject
+     * @memberof SensorData
+     * @static
+     * @param {Object.<string,*>} object Plain object
+     * @returns {SensorData} SensorData
+     */
+    SensorData.fromObject = function fromObject(object) {
+        if (object instanceof $root.SensorData)
+            return object;
+        let message = new $root.SensorData();
+        if (object.usb != null) {
+            if (typeof object.usb !== "object")
+                throw TypeError(".SensorData.usb: object expected");
+            message.usb = $root.SensorChannelData.fromObject(object.usb);
+        }
+        if (object.main != null) {
+            if (typeof object.main !== "object")
+                throw TypeError(".SensorData.main: object expected");
+            message.main = $root.SensorChannelData.fromObject(object.main);
+        }
+        if (object.vin != null) {
+            if (typeof object.vin !== "object")
+                throw TypeError(".SensorData.vin: object expected");
+            message.vin = $root.SensorChannelData.fromObject(object.vin);
+        }
+        if (object.timestampMs != null)
+            if ($util.Long)
+                (message.timestampMs = $util.Long.fromValue(object.timestampMs)).unsigned = true;
+            else if (typeof object.timestampMs === "string")
+                message.timestampMs = parseInt(object.timestampMs, 10);
+            else if (typeof object.timestampMs === "number")
+                message.timestampMs = object.timestampMs;
+            else if (typeof object.timestampMs === "object")
+                message.timestampMs = new $util.LongBits(object.timestampMs.low >>> 0, object.timestampMs.high >>> 0).toNumber(true);
+        if (object.uptimeMs != null)
+            if ($util.Long)
+                (message.uptimeMs = $util.Long.fromValue(object.uptimeMs)).unsigned = true;
+            else if (typeof object.uptimeMs === "string")
+                message.uptimeMs = parseInt(object.uptimeMs, 10);
+            else if (typeof object.uptimeMs === "number")
+                message.uptimeMs = object.uptimeMs;
+            else if (typeof object.uptimeMs === "object")
+                message.uptimeMs = new $util.LongBits(object.uptimeMs.low >>> 0, object.uptimeMs.high >>> 0).toNumber(true);
+        if (object.sampleCount != null)
+            message.sampleCount = object.sampleCount >>> 0;
+        if (object.firstConversionUs != null)
+            if ($util.Long)
+                (message.firstConversionUs = $util.Long.fromValue(object.firstConversionUs)).unsigned = true;
+            else if (typeof object.firstConversionUs === "string")
+                message.firstConversionUs = parseInt(object.firstConversionUs, 10);
+            else if (typeof object.firstConversionUs === "number")
+                message.firstConversionUs = object.firstConversionUs;
+            else if (typeof object.firstConversionUs === "object")
+                message.firstConversionUs = new $util.LongBits(object.firstConversionUs.low >>> 0, object.firstConversionUs.high >>> 0).toNumber(true);
+        if (object.lastConversionUs != null)
+            if ($util.Long)
+                (message.lastConversionUs = $util.Long.fromValue(object.lastConversionUs)).unsigned = true;
+            else if (typeof object.lastConversionUs === "string")
+                message.lastConversionUs = parseInt(object.lastConversionUs, 10);
+            else if (typeof object.lastConversionUs === "number")
+                message.lastConversionUs = object.lastConversionUs;
+            else if (typeof object.lastConversionUs === "object")
+                message.lastConversionUs = new $util.LongBits(object.lastConversionUs.low >>> 0, object.lastConversionUs.high >>> 0).toNumber(true);
+        return message;
+    };
+
+    /**
+     * Creates a plain object from a SensorData message. Also converts values to other types if specified.
+     * @function toObject
+     * @memberof SensorData
+     * @static
+     * @param {SensorData} message SensorData
+     * @param {$protobuf.IConversionOptions} [options] Conversion options
+     * @returns {Object.<string,*>} Plain object
+     */
+    SensorData.toObject = function toObject(message, options) {
+        if (!options)
+            options = {};
+        let object = {};
+        if (options.defaults) {
+            object.usb = null;
+            object.main = null;
+            object.vin = null;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.timestampMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.timestampMs = options.longs === String ? "0" : 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.uptimeMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.uptimeMs = options.longs === String ? "0" : 0;
+            object.sampleCount = 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.firstConversionUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.firstConversionUs = options.longs === String ? "0" : 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.lastConversionUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.lastConversionUs = options.longs === String ? "0" : 0;
+        }
+        if (message.usb != null && message.hasOwnProperty("usb"))
+            object.usb = $root.SensorChannelData.toObject(message.usb, options);
+        if (message.main != null && message.hasOwnProperty("main"))
+            object.main = $root.SensorChannelData.toObject(message.main, options);
+        if (message.vin != null && message.hasOwnProperty("vin"))
+            object.vin = $root.SensorChannelData.toObject(message.vin, options);
+        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
+            if (typeof message.timestampMs === "number")
+                object.timestampMs = options.longs === String ? String(message.timestampMs) : message.timestampMs;
+            else
+                object.timestampMs = options.longs === String ? $util.Long.prototype.toString.call(message.timestampMs) : options.longs === Number ? new $util.LongBits(message.timestampMs.low >>> 0, message.timestampMs.high >>> 0).toNumber(true) : message.timestampMs;
+        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
+            if (typeof message.uptimeMs === "number")
+                object.uptimeMs = options.longs === String ? String(message.uptimeMs) : message.uptimeMs;
+            else
+                object.uptimeMs = options.longs === String ? $util.Long.prototype.toString.call(message.uptimeMs) : options.longs === Number ? new $util.LongBits(message.uptimeMs.low >>> 0, message.uptimeMs.high >>> 0).toNumber(true) : message.uptimeMs;
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            object.sampleCount = message.sampleCount;
+        if (message.firstConversionUs != null && message.hasOwnProperty("firstConversionUs"))
+            if (typeof message.firstConversionUs === "number")
+                object.firstConversionUs = options.longs === String ? String(message.firstConversionUs) : message.firstConversionUs;
+            else
+                object.firstConversionUs = options.longs === String ? $util.Long.prototype.toString.call(message.firstConversionUs) : options.longs === Number ? new $util.LongBits(message.firstConversionUs.low >>> 0, message.firstConversionUs.high >>> 0).toNumber(true) : message.firstConversionUs;
+        if (message.lastConversionUs != null && message.hasOwnProperty("lastConversionUs"))
+            if (typeof message.lastConversionUs === "number")
+                object.lastConversionUs = options.longs === String ? String(message.lastConversionUs) : message.lastConversionUs;
+            else
+                object.lastConversionUs = options.longs === String ? $util.Long.prototype.toString.call(message.lastConversionUs) : options.longs === Number ? new $util.LongBits(message.lastConversionUs.low >>> 0, message.lastConversionUs.high >>> 0).toNumber(true) : message.lastConversionUs;
+        return object;
+    };
+
+    /**
+     * Converts this SensorData to JSON.
+     * @function toJSON
+     * @memberof SensorData
+     * @instance
+     * @returns {Object.<string,*>} JSON object
+     */
+    SensorData.prototype.toJSON = function toJSON() {
+        return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
+    };
+
+    /**
+     * Gets the default type url for SensorData
+     * @function getTypeUrl
+     * @memberof SensorData
+     * @static
+     * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
+     * @returns {string} The default type url
+     */
+    SensorData.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+        if (typeUrlPrefix === undefined) {
+            typeUrlPrefix = "type.googleapis.com";
+        }
+        return typeUrlPrefix + "/SensorData";
+    };
+
+    return SensorData;
+})();
+
+export const SensorDataRaw = $root.SensorDataRaw = (() => {
+
+    /**
+     * Properties of a SensorDataRaw.
+     * @exports ISensorDataRaw
+     * @interface ISensorDataRaw
+     * @property {number|Long|null} [timestampMs] SensorDataRaw timestampMs
+     * @property {number|Long|null} [uptimeMs] SensorDataRaw uptimeMs
+     * @property {number|null} [sampleCount] SensorDataRaw sampleCount
+     * @property {Array.<number>|null} [voltageMv] SensorDataRaw voltageMv
+     * @property {Array.<number>|null} [currentUa] SensorDataRaw currentUa
+     * @property {Array.<number>|null} [voltageMinMv] SensorDataRaw voltageMinMv
+     * @property {Array.<number>|null} [voltageMaxMv] SensorDataRaw voltageMaxMv
+     * @property {Array.<number>|null} [currentMinUa] SensorDataRaw currentMinUa
+     * @property {Array.<number>|null} [currentMaxUa] SensorDataRaw currentMaxUa
+     * @property {Array.<number|Long>|null} [energyUwh] SensorDataRaw energyUwh
+     * @property {Array.<number|Long>|null} [chargeUah] SensorDataRaw chargeUah
+     * @property {number|Long|null} [firstConversionUs] SensorDataRaw firstConversionUs
+     * @property {number|Long|null} [lastConversionUs] SensorDataRaw lastConversionUs
+     * @property {number|null} [disabledChannels] SensorDataRaw disabledChannels
+     */
+
+    /**
+     * Constructs a new SensorDataRaw.
+     * @exports SensorDataRaw
+     * @classdesc Represents a SensorDataRaw.
+     * @implements ISensorDataRaw
+     * @constructor
+     * @param {ISensorDataRaw=} [properties] Properties to set
+     */
+    function SensorDataRaw(properties) {
+        this.voltageMv = [];
+        this.currentUa = [];
+        this.voltageMinMv = [];
+        this.voltageMaxMv = [];
+        this.currentMinUa = [];
+        this.currentMaxUa = [];
+        this.energyUwh = [];
+        this.chargeUah = [];
+        if (properties)
+            for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
+                if (properties[keys[i]] != null)
+                    this[keys[i]] = properties[keys[i]];
+    }
+
+    /**
+     * SensorDataRaw timestampMs.
+     * @member {number|Long} timestampMs
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.timestampMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorDataRaw uptimeMs.
+     * @member {number|Long} uptimeMs
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.uptimeMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorDataRaw sampleCount.
+     * @member {number} sampleCount
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.sampleCount = 0;
+
+    /**
+     * SensorDataRaw voltageMv.
+     * @member {Array.<number>} voltageMv
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.voltageMv = $util.emptyArray;
+
+    /**
+     * SensorDataRaw currentUa.
+     * @member {Array.<number>} currentUa
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.currentUa = $util.emptyArray;
+
+    /**
+     * SensorDataRaw voltageMinMv.
+     * @member {Array.<number>} voltageMinMv
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.voltageMinMv = $util.emptyArray;
+
+    /**
+     * SensorDataRaw voltageMaxMv.
+     * @member {Array.<number>} voltageMaxMv
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.voltageMaxMv = $util.emptyArray;
+
+    /**
+     * SensorDataRaw currentMinUa.
+     * @member {Array.<number>} currentMinUa
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.currentMinUa = $util.emptyArray;
+
+    /**
+     * SensorDataRaw currentMaxUa.
+     * @member {Array.<number>} currentMaxUa
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.currentMaxUa = $util.emptyArray;
+
+    /**
+     * SensorDataRaw energyUwh.
+     * @member {Array.<number|Long>} energyUwh
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.energyUwh = $util.emptyArray;
+
+    /**
+     * SensorDataRaw chargeUah.
+     * @member {Array.<number|Long>} chargeUah
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.chargeUah = $util.emptyArray;
+
+    /**
+     * SensorDataRaw firstConversionUs.
+     * @member {number|Long} firstConversionUs
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.firstConversionUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorDataRaw lastConversionUs.
+     * @member {number|Long} lastConversionUs
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.lastConversionUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorDataRaw disabledChannels.
+     * @member {number} disabledChannels
+     * @memberof SensorDataRaw
+     * @instance
+     */
+    SensorDataRaw.prototype.disabledChannels = 0;
+
+    /**
+     * Creates a new SensorDataRaw instance using the specified properties.
+     * @function create
+     * @memberof SensorDataRaw
+     * @static
+     * @param {ISensorDataRaw=} [properties] Properties to set
+     * @returns {SensorDataRaw} SensorDataRaw instance
+     */
+    SensorDataRaw.create = function create(properties) {
+        return new SensorDataRaw(properties);
+    };
+
+    /**
+     * Encodes the specified SensorDataRaw message. Does not implicitly {@link SensorDataRaw.verify|verify} messages.
+     * @function encode
+     * @memberof SensorDataRaw
+     * @static
+     * @param {ISensorDataRaw} message SensorDataRaw message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorDataRaw.encode = function encode(message, writer) {
+        if (!writer)
+            writer = $Writer.create();
+        if (message.timestampMs != null && Object.hasOwnProperty.call(message, "timestampMs"))
+            writer.uint32(/* id 1, wireType 0 =*/8).uint64(message.timestampMs);
+        if (message.uptimeMs != null && Object.hasOwnProperty.call(message, "uptimeMs"))
+            writer.uint32(/* id 2, wireType 0 =*/16).uint64(message.uptimeMs);
+        if (message.sampleCount != null && Object.hasOwnProperty.call(message, "sampleCount"))
+            writer.uint32(/* id 3, wireType 0 =*/24).uint32(message.sampleCount);
+        if (message.voltageMv != null && message.voltageMv.length) {
+            writer.uint32(/* id 4, wireType 2 =*/34).fork();
+            for (let i = 0; i < message.voltageMv.length; ++i)
+                writer.sint32(message.voltageMv[i]);
+            writer.ldelim();
+        }
+        if (message.currentUa != null && message.currentUa.length) {
+            writer.uint32(/* id 5, wireType 2 =*/42).fork();
+            for (let i = 0; i < message.currentUa.length; ++i)
+                writer.sint32(message.currentUa[i]);
+            writer.ldelim();
+        }
+        if (message.voltageMinMv != null && message.voltageMinMv.length) {
+            writer.uint32(/* id 6, wireType 2 =*/50).fork();
+            for (let i = 0; i < message.voltageMinMv.length; ++i)
+                writer.sint32(message.voltageMinMv[i]);
+            writer.ldelim();
+        }
+        if (message.voltageMaxMv != null && message.voltageMaxMv.length) {
+            writer.uint32(/* id 7, wireType 2 =*/58).fork();
+            for (let i = 0; i < message.voltageMaxMv.length; ++i)
+                writer.sint32(message.voltageMaxMv[i]);
+            writer.ldelim();
+        }
+        if (message.currentMinUa != null && message.currentMinUa.length) {
+            writer.uint32(/* id 8, wireType 2 =*/66).fork();
+            for (let i = 0; i < message.currentMinUa.length; ++i)
+                writer.sint32(message.currentMinUa[i]);
+            writer.ldelim();
+        }
+        if (message.currentMaxUa != null && message.currentMaxUa.length) {
+            writer.uint32(/* id 9, wireType 2 =*/74).fork();
+            for (let i = 0; i < message.currentMaxUa.length; ++i)
+                writer.sint32(message.currentMaxUa[i]);
+            writer.ldelim();
+        }
+        if (message.energyUwh != null && message.energyUwh.length) {
+            writer.uint32(/* id 10, wireType 2 =*/82).fork();
+            for (let i = 0; i < message.energyUwh.length; ++i)
+                writer.sint64(message.energyUwh[i]);
+            writer.ldelim();
+        }
+        if (message.chargeUah != null && message.chargeUah.length) {
+            writer.uint32(/* id 11, wireType 2 =*/90).fork();
+            for (let i = 0; i < message.chargeUah.length; ++i)
+                writer.sint64(message.chargeUah[i]);
+            writer.ldelim();
+        }
+        if (message.firstConversionUs != null && Object.hasOwnProperty.call(message, "firstConversionUs"))
+            writer.uint32(/* id 12, wireType 0 =*/96).uint64(message.firstConversionUs);
+        if (message.lastConversionUs != null && Object.hasOwnProperty.call(message, "lastConversionUs"))
+            writer.uint32(/* id 13, wireType 0 =*/104).uint64(message.lastConversionUs);
+        if (message.disabledChannels != null && Object.hasOwnProperty.call(message, "disabledChannels"))
+            writer.uint32(/* id 14, wireType 0 =*/112).uint32(message.disabledChannels);
+        return writer;
+    };
+
+    /**
+     * Encodes the specified SensorDataRaw message, length delimited. Does not implicitly {@link SensorDataRaw.verify|verify} messages.
+     * @function encodeDelimited
+     * @memberof SensorDataRaw
+     * @static
+     * @param {ISensorDataRaw} message SensorDataRaw message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorDataRaw.encodeDelimited = function encodeDelimited(message, writer) {
+        return this.encode(message, writer).ldelim();
+    };
+
+    /**
+     * Decodes a SensorDataRaw message from the specified reader or buffer.
+     * @function decode
+     * @memberof SensorDataRaw
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @param {number} [length] Message length if known beforehand
+     * @returns {SensorDataRaw} SensorDataRaw
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorDataRaw.decode = function decode(reader, length, error) {
+        if (!(reader instanceof $Reader))
+            reader = $Reader.create(reader);
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.SensorDataRaw();
+        while (reader.pos < end) {
+            let tag = reader.uint32();
+            if (tag === error)
+                break;
+            switch (tag >>> 3) {
+            case 1: {
+                    message.timestampMs = reader.uint64();
+                    break;
+                }
+            case 2: {
+                    message.uptimeMs = reader.uint64();
+                    break;
+                }
+            case 3: {
+                    message.sampleCount = reader.uint32();
+                    break;
+                }
+            case 4: {
+                    if (!(message.voltageMv && message.voltageMv.length))
+                        message.voltageMv = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.voltageMv.push(reader.sint32());
+                    } else
+                        message.voltageMv.push(reader.sint32());
+                    break;
+                }
+            case 5: {
+                    if (!(message.currentUa && message.currentUa.length))
+                        message.currentUa = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.currentUa.push(reader.sint32());
+                    } else
+                        message.currentUa.push(reader.sint32());
+                    break;
+                }
+            case 6: {
+                    if (!(message.voltageMinMv && message.voltageMinMv.length))
+                        message.voltageMinMv = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.voltageMinMv.push(reader.sint32());
+                    } else
+                        message.voltageMinMv.push(reader.sint32());
+                    break;
+                }
+            case 7: {
+                    if (!(message.voltageMaxMv && message.voltageMaxMv.length))
+                        message.voltageMaxMv = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.voltageMaxMv.push(reader.sint32());
+                    } else
+                        message.voltageMaxMv.push(reader.sint32());
+                    break;
+                }
+            case 8: {
+                    if (!(message.currentMinUa && message.currentMinUa.length))
+                        message.currentMinUa = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.currentMinUa.push(reader.sint32());
+                    } else
+                        message.currentMinUa.push(reader.sint32());
+                    break;
+                }
+            case 9: {
+                    if (!(message.currentMaxUa && message.currentMaxUa.length))
+                        message.currentMaxUa = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.currentMaxUa.push(reader.sint32());
+                    } else
+                        message.currentMaxUa.push(reader.sint32());
+                    break;
+                }
+            case 10: {
+                    if (!(message.energyUwh && message.energyUwh.length))
+                        message.energyUwh = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.energyUwh.push(reader.sint64());
+                    } else
+                        message.energyUwh.push(reader.sint64());
+                    break;
+                }
+            case 11: {
+                    if (!(message.chargeUah && message.chargeUah.length))
+                        message.chargeUah = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.chargeUah.push(reader.sint64());
+                    } else
+                        message.chargeUah.push(reader.sint64());
+                    break;
+                }
+            case 12: {
+                    message.firstConversionUs = reader.uint64();
+                    break;
+                }
+            case 13: {
+                    message.lastConversionUs = reader.uint64();
+                    break;
+                }
+            case 14: {
+                    message.disabledChannels = reader.uint32();
+                    break;
+                }
+            default:
+                reader.skipType(tag & 7);
+                break;
+            }
+        }
+        return message;
+    };
+
+    /**
+     * Decodes a SensorDataRaw message from the specified reader or buffer, length delimited.
+     * @function decodeDelimited
+     * @memberof SensorDataRaw
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @returns {SensorDataRaw} SensorDataRaw
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorDataRaw.decodeDelimited = function decodeDelimited(reader) {
+        if (!(reader instanceof $Reader))
+            reader = new $Reader(reader);
+        return this.decode(reader, reader.uint32());
+    };
+
+    /**
+     * Verifies a SensorDataRaw message.
+     * @function verify
+     * @memberof SensorDataRaw
+     * @static
+     * @param {Object.<string,*>} message Plain object to verify
+     * @returns {string|null} `null` if valid, otherwise the reason why it is not
+     */
+    SensorDataRaw.verify = function verify(message) {
+        if (typeof message !== "object" || message === null)
+            return "object expected";
+        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
+            if (!$util.isInteger(message.timestampMs) && !(message.timestampMs && $util.isInteger(message.timestampMs.low) && $util.isInteger(message.timestampMs.high)))
+                return "timestampMs: integer|Long expected";
+        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
+            if (!$util.isInteger(message.uptimeMs) && !(message.uptimeMs && $util.isInteger(message.uptimeMs.low) && $util.isInteger(message.uptimeMs.high)))
+                return "uptimeMs: integer|Long expected";
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            if (!$util.isInteger(message.sampleCount))
+                return "sampleCount: integer expected";
+        if (message.voltageMv != null && message.hasOwnProperty("voltageMv")) {
+            if (!Array.isArray(message.voltageMv))
+                return "voltageMv: array expected";
+            for (let i = 0; i < message.voltageMv.length; ++i)
+                if (!$util.isInteger(message.voltageMv[i]))
+                    return "voltageMv: integer[] expected";
+        }
+        if (message.currentUa != null && message.hasOwnProperty("currentUa")) {
+            if (!Array.isArray(message.currentUa))
+                return "currentUa: array expected";
+            for (let i = 0; i < message.currentUa.length; ++i)
+                if (!$util.isInteger(message.currentUa[i]))
+                    return "currentUa: integer[] expected";
+        }
+        if (message.voltageMinMv != null && message.hasOwnProperty("voltageMinMv")) {
+            if (!Array.isArray(message.voltageMinMv))
+                return "voltageMinMv: array expected";
+            for (let i = 0; i < message.voltageMinMv.length; ++i)
+                if (!$util.isInteger(message.voltageMinMv[i]))
+                    return "voltageMinMv: integer[] expected";
+        }
+        if (message.voltageMaxMv != null && message.hasOwnProperty("voltageMaxMv")) {
+            if (!Array.isArray(message.voltageMaxMv))
+                return "voltageMaxMv: array expected";
+            for (let i = 0; i < message.voltageMaxMv.length; ++i)
+                if (!$util.isInteger(message.voltageMaxMv[i]))
+                    return "voltageMaxMv: integer[] expected";
+        }
+        if (message.currentMinUa != null && message.hasOwnProperty("currentMinUa")) {
+            if (!Array.isArray(message.currentMinUa))
+                return "currentMinUa: array expected";
+            for (let i = 0; i < message.currentMinUa.length; ++i)
+                if (!$util.isInteger(message.currentMinUa[i]))
+                    return "currentMinUa: integer[] expected";
+        }
+        if (message.currentMaxUa != null && message.hasOwnProperty("currentMaxUa")) {
+            if (!Array.isArray(message.currentMaxUa))
+                return "currentMaxUa: array expected";
+            for (let i = 0; i < message.currentMaxUa.length; ++i)
+                if (!$util.isInteger(message.currentMaxUa[i]))
+                    return "currentMaxUa: integer[] expected";
+        }
+        if (message.energyUwh != null && message.hasOwnProperty("energyUwh")) {
+            if (!Array.isArray(message.energyUwh))
+                return "energyUwh: array expected";
+            for (let i = 0; i < message.energyUwh.length; ++i)
+                if (!$util.isInteger(message.energyUwh[i]) && !(message.energyUwh[i] && $util.isInteger(message.energyUwh[i].low) && $util.isInteger(message.energyUwh[i].high)))
+                    return "energyUwh: integer|Long[] expected";
+        }
+        if (message.chargeUah != null && message.hasOwnProperty("chargeUah")) {
+            if (!Array.isArray(message.chargeUah))
+                return "chargeUah: array expected";
+            for (let i = 0; i < message.chargeUah.length; ++i)
+                if (!$util.isInteger(message.chargeUah[i]) && !(message.chargeUah[i] && $util.isInteger(message.chargeUah[i].low) && $util.isInteger(message.chargeUah[i].high)))
+                    return "chargeUah: integer|Long[] expected";
+        }
+        if (message.firstConversionUs != null && message.hasOwnProperty("firstConversionUs"))
+            if (!$util.isInteger(message.firstConversionUs) && !(message.firstConversionUs && $util.isInteger(message.firstConversionUs.low) && $util.isInteger(message.firstConversionUs.high)))
+                return "firstConversionUs: integer|Long expected";
+        if (message.lastConversionUs != null && message.hasOwnProperty("lastConversionUs"))
+            if (!$util.isInteger(message.lastConversionUs) && !(message.lastConversionUs && $util.isInteger(message.lastConversionUs.low) && $util.isInteger(message.lastConversionUs.high)))
+                return "lastConversionUs: integer|Long expected";
+        if (message.disabledChannels != null && message.hasOwnProperty("disabledChannels"))
+            if (!$util.isInteger(message.disabledChannels))
+                return "disabledChannels: integer expected";
+        return null;
+    };
+
+    /**
+     * Creates a SensorDataRaw message from a plain object. Also converts values to their respective internal types.
+     * @function fromObject
+     * @memberof SensorDataRaw
+     * @static
+     * @param {Object.<string,*>} object Plain object
+     * @returns {SensorDataRaw} SensorDataRaw
+     */
+    SensorDataRaw.fromObject = function fromObject(object) {
+        if (object instanceof $root.SensorDataRaw)
+            return object;
+        let message = new $root.SensorDataRaw();
+        if (object.timestampMs != null)
+            if ($util.Long)
+                (message.timestampMs = $util.Long.fromValue(object.timestampMs)).unsigned = true;
+            else if (typeof object.timestampMs === "string")
+                message.timestampMs = parseInt(object.timestampMs, 10);
+            else if (typeof object.timestampMs === "number")
+                message.timestampMs = object.timestampMs;
+            else if (typeof object.timestampMs === "object")
+                message.timestampMs = new $util.LongBits(object.timestampMs.low >>> 0, object.timestampMs.high >>> 0).toNumber(true);
+        if (object.uptimeMs != null)
+            if ($util.Long)
+                (message.uptimeMs = $util.Long.fromValue(object.uptimeMs)).unsigned = true;
+            else if (typeof object.uptimeMs === "string")
+                message.uptimeMs = parseInt(object.uptimeMs, 10);
+            else if (typeof object.uptimeMs === "number")
+                message.uptimeMs = object.uptimeMs;
+            else if (typeof object.uptimeMs === "object")
+                message.uptimeMs = new $util.LongBits(object.uptimeMs.low >>> 0, object.uptimeMs.high >>> 0).toNumber(true);
+        if (object.sampleCount != null)
+            message.sampleCount = object.sampleCount >>> 0;
+        if (object.voltageMv) {
+            if (!Array.isArray(object.voltageMv))
+                throw TypeError(".SensorDataRaw.voltageMv: array expected");
+            message.voltageMv = [];
+            for (let i = 0; i < object.voltageMv.length; ++i)
+                message.voltageMv[i] = object.voltageMv[i] | 0;
+        }
+        if (object.currentUa) {
+            if (!Array.isArray(object.currentUa))
+                throw TypeError(".SensorDataRaw.currentUa: array expected");
+            message.currentUa = [];
+            for (let i = 0; i < object.currentUa.length; ++i)
+                message.currentUa[i] = object.currentUa[i] | 0;
+        }
+        if (object.voltageMinMv) {
+            if (!Array.isArray(object.voltageMinMv))
+                throw TypeError(".SensorDataRaw.voltageMinMv: array expected");
+            message.voltageMinMv = [];
+            for (let i = 0; i < object.voltageMinMv.length; ++i)
+                message.voltageMinMv[i] = object.voltageMinMv[i] | 0;
+        }
+        if (object.voltageMaxMv) {
+            if (!Array.isArray(object.voltageMaxMv))
+                throw TypeError(".SensorDataRaw.voltageMaxMv: array expected");
+            message.voltageMaxMv = [];
+            for (let i = 0; i < object.voltageMaxMv.length; ++i)
+                message.voltageMaxMv[i] = object.voltageMaxMv[i] | 0;
+        }
+        if (object.currentMinUa) {
+            if (!Array.isArray(object.currentMinUa))
+                throw TypeError(".SensorDataRaw.currentMinUa: array expected");
+            message.currentMinUa = [];
+            for (let i = 0; i < object.currentMinUa.length; ++i)
+                message.currentMinUa[i] = object.currentMinUa[i] | 0;
+        }
+        if (object.currentMaxUa) {
+            if (!Array.isArray(object.currentMaxUa))
+                throw TypeError(".SensorDataRaw.currentMaxUa: array expected");
+            message.currentMaxUa = [];
+            for (let i = 0; i < object.currentMaxUa.length; ++i)
+                message.currentMaxUa[i] = object.currentMaxUa[i] | 0;
+        }
+        if (object.energyUwh) {
+            if (!Array.isArray(object.energyUwh))
+                throw TypeError(".SensorDataRaw.energyUwh: array expected");
+            message.energyUwh = [];
+            for (let i = 0; i < object.energyUwh.length; ++i)
+                if ($util.Long)
+                    (message.energyUwh[i] = $util.Long.fromValue(object.energyUwh[i])).unsigned = false;
+                else if (typeof object.energyUwh[i] === "string")
+                    message.energyUwh[i] = parseInt(object.energyUwh[i], 10);
+                else if (typeof object.energyUwh[i] === "number")
+                    message.energyUwh[i] = object.energyUwh[i];
+                else if (typeof object.energyUwh[i] === "object")
+                    message.energyUwh[i] = new $util.LongBits(object.energyUwh[i].low >>> 0, object.energyUwh[i].high >>> 0).toNumber();
+        }
+        if (object.chargeUah) {
+            if (!Array.isArray(object.chargeUah))
+                throw TypeError(".SensorDataRaw.chargeUah: array expected");
+            message.chargeUah = [];
+            for (let i = 0; i < object.chargeUah.length; ++i)
+                if ($util.Long)
+                    (message.chargeUah[i] = $util.Long.fromValue(object.chargeUah[i])).unsigned = false;
+                else if (typeof object.chargeUah[i] === "string")
+                    message.chargeUah[i] = parseInt(object.chargeUah[i], 10);
+                else if (typeof object.chargeUah[i] === "number")
+                    message.chargeUah[i] = object.chargeUah[i];
+                else if (typeof object.chargeUah[i] === "object")
+                    message.chargeUah[i] = new $util.LongBits(object.chargeUah[i].low >>> 0, object.chargeUah[i].high >>> 0).toNumber();
+        }
+        if (object.firstConversionUs != null)
+            if ($util.Long)
+                (message.firstConversionUs = $util.Long.fromValue(object.firstConversionUs)).unsigned = true;
+            else if (typeof object.firstConversionUs === "string")
+                message.firstConversionUs = parseInt(object.firstConversionUs, 10);
+            else if (typeof object.firstConversionUs === "number")
+                message.firstConversionUs = object.firstConversionUs;
+            else if (typeof object.firstConversionUs === "object")
+                message.firstConversionUs = new $util.LongBits(object.firstConversionUs.low >>> 0, object.firstConversionUs.high >>> 0).toNumber(true);
+        if (object.lastConversionUs != null)
+            if ($util.Long)
+                (message.lastConversionUs = $util.Long.fromValue(object.lastConversionUs)).unsigned = true;
+            else if (typeof object.lastConversionUs === "string")
+                message.lastConversionUs = parseInt(object.lastConversionUs, 10);
+            else if (typeof object.lastConversionUs === "number")
+                message.lastConversionUs = object.lastConversionUs;
+            else if (typeof object.lastConversionUs === "object")
+                message.lastConversionUs = new $util.LongBits(object.lastConversionUs.low >>> 0, object.lastConversionUs.high >>> 0).toNumber(true);
+        if (object.disabledChannels != null)
+            message.disabledChannels = object.disabledChannels >>> 0;
+        return message;
+    };
+
+    /**
+     * Creates a plain object from a SensorDataRaw message. Also converts values to other types if specified.
+     * @function toObject
+     * @memberof SensorDataRaw
+     * @static
+     * @param {SensorDataRaw} message SensorDataRaw
+     * @param {$protobuf.IConversionOptions} [options] Conversion options
+     * @returns {Object.<string,*>} Plain object
+     */
+    SensorDataRaw.toObject = function toObject(message, options) {
+        if (!options)
+            options = {};
+        let object = {};
+        if (options.arrays || options.defaults) {
+            object.voltageMv = [];
+            object.currentUa = [];
+            object.voltageMinMv = [];
+            object.voltageMaxMv = [];
+            object.currentMinUa = [];
+            object.currentMaxUa = [];
+            object.energyUwh = [];
+            object.chargeUah = [];
+        }
+        if (options.defaults) {
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.timestampMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.timestampMs = options.longs === String ? "0" : 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.uptimeMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.uptimeMs = options.longs === String ? "0" : 0;
+            object.sampleCount = 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.firstConversionUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.firstConversionUs = options.longs === String ? "0" : 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.lastConversionUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.lastConversionUs = options.longs === String ? "0" : 0;
+            object.disabledChannels = 0;
+        }
+        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
+            if (typeof message.timestampMs === "number")
+                object.timestampMs = options.longs === String ? String(message.timestampMs) : message.timestampMs;
+            else
+                object.timestampMs = options.longs === String ? $util.Long.prototype.toString.call(message.timestampMs) : options.longs === Number ? new $util.LongBits(message.timestampMs.low >>> 0, message.timestampMs.high >>> 0).toNumber(true) : message.timestampMs;
+        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
+            if (typeof message.uptimeMs === "number")
+                object.uptimeMs = options.longs === String ? String(message.uptimeMs) : message.uptimeMs;
+            else
+                object.uptimeMs = options.longs === String ? $util.Long.prototype.toString.call(message.uptimeMs) : options.longs === Number ? new $util.LongBits(message.uptimeMs.low >>> 0, message.uptimeMs.high >>> 0).toNumber(true) : message.uptimeMs;
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            object.sampleCount = message.sampleCount;
+        if (message.voltageMv && message.voltageMv.length) {
+            object.voltageMv = [];
+            for (let j = 0; j < message.voltageMv.length; ++j)
+                object.voltageMv[j] = message.voltageMv[j];
+        }
+        if (message.currentUa && message.currentUa.length) {
+            object.currentUa = [];
+            for (let j = 0; j < message.currentUa.length; ++j)
+                object.currentUa[j] = message.currentUa[j];
+        }
+        if (message.voltageMinMv && message.voltageMinMv.length) {
+            object.voltageMinMv = [];
+            for (let j = 0; j < message.voltageMinMv.length; ++j)
+                object.voltageMinMv[j] = message.voltageMinMv[j];
+        }
+        if (message.voltageMaxMv && message.voltageMaxMv.length) {
+            object.voltageMaxMv = [];
+            for (let j = 0; j < message.voltageMaxMv.length; ++j)
+                object.voltageMaxMv[j] = message.voltageMaxMv[j];
+        }
+        if (message.currentMinUa && message.currentMinUa.length) {
+            object.currentMinUa = [];
+            for (let j = 0; j < message.currentMinUa.length; ++j)
+                object.currentMinUa[j] = message.currentMinUa[j];
+        }
+        if (message.currentMaxUa && message.currentMaxUa.length) {
+            object.currentMaxUa = [];
+            for (let j = 0; j < message.currentMaxUa.length; ++j)
+                object.currentMaxUa[j] = message.currentMaxUa[j];
+        }
+        if (message.energyUwh && message.energyUwh.length) {
+            object.energyUwh = [];
+            for (let j = 0; j < message.energyUwh.length; ++j)
+                if (typeof message.energyUwh[j] === "number")
+                    object.energyUwh[j] = options.longs === String ? String(message.energyUwh[j]) : message.energyUwh[j];
+                else
+                    object.energyUwh[j] = options.longs === String ? $util.Long.prototype.toString.call(message.energyUwh[j]) : options.longs === Number ? new $util.LongBits(message.energyUwh[j].low >>> 0, message.energyUwh[j].high >>> 0).toNumber() : message.energyUwh[j];
+        }
+        if (message.chargeUah && message.chargeUah.length) {
+            object.chargeUah = [];
+            for (let j = 0; j < message.chargeUah.length; ++j)
+                if (typeof message.chargeUah[j] === "number")
+                    object.chargeUah[j] = options.longs === String ? String(message.chargeUah[j]) : message.chargeUah[j];
+                else
+                    object.chargeUah[j] = options.longs === String ? $util.Long.prototype.toString.call(message.chargeUah[j]) : options.longs === Number ? new $util.LongBits(message.chargeUah[j].low >>> 0, message.chargeUah[j].high >>> 0).toNumber() : message.chargeUah[j];
+        }
+        if (message.firstConversionUs != null && message.hasOwnProperty("firstConversionUs"))
+            if (typeof message.firstConversionUs === "number")
+                object.firstConversionUs = options.longs === String ? String(message.firstConversionUs) : message.firstConversionUs;
+            else
+                object.firstConversionUs = options.longs === String ? $util.Long.prototype.toString.call(message.firstConversionUs) : options.longs === Number ? new $util.LongBits(message.firstConversionUs.low >>> 0, message.firstConversionUs.high >>> 0).toNumber(true) : message.firstConversionUs;
+        if (message.lastConversionUs != null && message.hasOwnProperty("lastConversionUs"))
+            if (typeof message.lastConversionUs === "number")
+                object.lastConversionUs = options.longs === String ? String(message.lastConversionUs) : message.lastConversionUs;
+            else
+                object.lastConversionUs = options.longs === String ? $util.Long.prototype.toString.call(message.lastConversionUs) : options.longs === Number ? new $util.LongBits(message.lastConversionUs.low >>> 0, message.lastConversionUs.high >>> 0).toNumber(true) : message.lastConversionUs;
+        if (message.disabledChannels != null && message.hasOwnProperty("disabledChannels"))
+            object.disabledChannels = message.disabledChannels;
+        return object;
+    };
+
+    /**
+     * Converts this SensorDataRaw to JSON.
+     * @function toJSON
+     * @memberof SensorDataRaw
+     * @instance
+     * @returns {Object.<string,*>} JSON object
+     */
+    SensorDataRaw.prototype.toJSON = function toJSON() {
+        return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
+    };
+
+    /**
+     * Gets the default type url for SensorDataRaw
+     * @function getTypeUrl
+     * @memberof SensorDataRaw
+     * @static
+     * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
+     * @returns {string} The default type url
+     */
+    SensorDataRaw.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+        if (typeUrlPrefix === undefined) {
+            typeUrlPrefix = "type.googleapis.com";
+        }
+        return typeUrlPrefix + "/SensorDataRaw";
+    };
+
+    return SensorDataRaw;
+})();
+
+export const SensorBatch = $root.SensorBatch = (() => {
+
+    /**
+     * Properties of a SensorBatch.
+     * @exports ISensorBatch
+     * @interface ISensorBatch
+     * @property {number|null} [seq] SensorBatch seq
+     * @property {number|null} [sampleCount] SensorBatch sampleCount
+     * @property {number|Long|null} [firstConversionUs] SensorBatch firstConversionUs
+     * @property {Array.<number>|null} [conversionDeltaUs] SensorBatch conversionDeltaUs
+     * @property {Array.<number>|null} [busMv] SensorBatch busMv
+     * @property {Array.<number>|null} [shuntRaw] SensorBatch shuntRaw
+     * @property {Array.<number>|null} [shuntMohm] SensorBatch shuntMohm
+     * @property {number|null} [disabledChannels] SensorBatch disabledChannels
+     */
+
+    /**
+     * Constructs a new SensorBatch.
+     * @exports SensorBatch
+     * @classdesc Represents a SensorBatch.
+     * @implements ISensorBatch
+     * @constructor
+     * @param {ISensorBatch=} [properties] Properties to set
+     */
+    function SensorBatch(properties) {
+        this.conversionDeltaUs = [];
+        this.busMv = [];
+        this.shuntRaw = [];
+        this.shuntMohm = [];
+        if (properties)
+            for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
+                if (properties[keys[i]] != null)
+                    this[keys[i]] = properties[keys[i]];
+    }
+
+    /**
+     * SensorBatch seq.
+     * @member {number} seq
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.seq = 0;
+
+    /**
+     * SensorBatch sampleCount.
+     * @member {number} sampleCount
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.sampleCount = 0;
+
+    /**
+     * SensorBatch firstConversionUs.
+     * @member {number|Long} firstConversionUs
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.firstConversionUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorBatch conversionDeltaUs.
+     * @member {Array.<number>} conversionDeltaUs
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.conversionDeltaUs = $util.emptyArray;
+
+    /**
+     * SensorBatch busMv.
+     * @member {Array.<number>} busMv
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.busMv = $util.emptyArray;
+
+    /**
+     * SensorBatch shuntRaw.
+     * @member {Array.<number>} shuntRaw
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.shuntRaw = $util.emptyArray;
+
+    /**
+     * SensorBatch shuntMohm.
+     * @member {Array.<number>} shuntMohm
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.shuntMohm = $util.emptyArray;
+
+    /**
+     * SensorBatch disabledChannels.
+     * @member {number} disabledChannels
+     * @memberof SensorBatch
+     * @instance
+     */
+    SensorBatch.prototype.disabledChannels = 0;
+
+    /**
+     * Creates a new SensorBatch instance using the specified properties.
+     * @function create
+     * @memberof SensorBatch
+     * @static
+     * @param {ISensorBatch=} [properties] Properties to set
+     * @returns {SensorBatch} SensorBatch instance
+     */
+    SensorBatch.create = function create(properties) {
+        return new SensorBatch(properties);
+    };
+
+    /**
+     * Encodes the specified SensorBatch message. Does not implicitly {@link SensorBatch.verify|verify} messages.
+     * @function encode
+     * @memberof SensorBatch
+     * @static
+     * @param {ISensorBatch} message SensorBatch message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorBatch.encode = function encode(message, writer) {
+        if (!writer)
+            writer = $Writer.create();
+        if (message.seq != null && Object.hasOwnProperty.call(message, "seq"))
+            writer.uint32(/* id 1, wireType 0 =*/8).uint32(message.seq);
+        if (message.sampleCount != null && Object.hasOwnProperty.call(message, "sampleCount"))
+            writer.uint32(/* id 2, wireType 0 =*/16).uint32(message.sampleCount);
+        if (message.firstConversionUs != null && Object.hasOwnProperty.call(message, "firstConversionUs"))
+            writer.uint32(/* id 3, wireType 0 =*/24).uint64(message.firstConversionUs);
+        if (message.conversionDeltaUs != null && message.conversionDeltaUs.length) {
+            writer.uint32(/* id 4, wireType 2 =*/34).fork();
+            for (let i = 0; i < message.conversionDeltaUs.length; ++i)
+                writer.uint32(message.conversionDeltaUs[i]);
+            writer.ldelim();
+        }
+        if (message.busMv != null && message.busMv.length) {
+            writer.uint32(/* id 5, wireType 2 =*/42).fork();
+            for (let i = 0; i < message.busMv.length; ++i)
+                writer.sint32(message.busMv[i]);
+            writer.ldelim();
+        }
+        if (message.shuntRaw != null && message.shuntRaw.length) {
+            writer.uint32(/* id 6, wireType 2 =*/50).fork();
+            for (let i = 0; i < message.shuntRaw.length; ++i)
+                writer.sint32(message.shuntRaw[i]);
+            writer.ldelim();
+        }
+        if (message.shuntMohm != null && message.shuntMohm.length) {
+            writer.uint32(/* id 7, wireType 2 =*/58).fork();
+            for (let i = 0; i < message.shuntMohm.length; ++i)
+                writer.uint32(message.shuntMohm[i]);
+            writer.ldelim();
+        }
+        if (message.disabledChannels != null && Object.hasOwnProperty.call(message, "disabledChannels"))
+            writer.uint32(/* id 8, wireType 0 =*/64).uint32(message.disabledChannels);
+        return writer;
+    };
+
+    /**
+     * Encodes the specified SensorBatch message, length delimited. Does not implicitly {@link SensorBatch.verify|verify} messages.
+     * @function encodeDelimited
+     * @memberof SensorBatch
+     * @static
+     * @param {ISensorBatch} message SensorBatch message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorBatch.encodeDelimited = function encodeDelimited(message, writer) {
+        return this.encode(message, writer).ldelim();
+    };
+
+    /**
+     * Decodes a SensorBatch message from the specified reader or buffer.
+     * @function decode
+     * @memberof SensorBatch
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @param {number} [length] Message length if known beforehand
+     * @returns {SensorBatch} SensorBatch
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorBatch.decode = function decode(reader, length, error) {
+        if (!(reader instanceof $Reader))
+            reader = $Reader.create(reader);
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.SensorBatch();
+        while (reader.pos < end) {
+            let tag = reader.uint32();
+            if (tag === error)
+                break;
+            switch (tag >>> 3) {
+            case 1: {
+                    message.seq = reader.uint32();
+                    break;
+                }
+            case 2: {
+                    message.sampleCount = reader.uint32();
+                    break;
+                }
+            case 3: {
+                    message.firstConversionUs = reader.uint64();
+                    break;
+                }
+            case 4: {
+                    if (!(message.conversionDeltaUs && message.conversionDeltaUs.length))
+                        message.conversionDeltaUs = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.conversionDeltaUs.push(reader.uint32());
+                    } else
+                        message.conversionDeltaUs.push(reader.uint32());
+                    break;
+                }
+            case 5: {
+                    if (!(message.busMv && message.busMv.length))
+                        message.busMv = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.busMv.push(reader.sint32());
+                    } else
+                        message.busMv.push(reader.sint32());
+                    break;
+                }
+            case 6: {
+                    if (!(message.shuntRaw && message.shuntRaw.length))
+                        message.shuntRaw = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.shuntRaw.push(reader.sint32());
+                    } else
+                        message.shuntRaw.push(reader.sint32());
+                    break;
+                }
+            case 7: {
+                    if (!(message.shuntMohm && message.shuntMohm.length))
+                        message.shuntMohm = [];
+                    if ((tag & 7) === 2) {
+                        let end2 = reader.uint32() + reader.pos;
+                        while (reader.pos < end2)
+                            message.shuntMohm.push(reader.uint32());
+                    } else
+                        message.shuntMohm.push(reader.uint32());
+                    break;
+                }
+            case 8: {
+                    message.disabledChannels = reader.uint32();
+                    break;
+                }
+            default:
+                reader.skipType(tag & 7);
+                break;
+            }
+        }
+        return message;
+    };
+
+    /**
+     * Decodes a SensorBatch message from the specified reader or buffer, length delimited.
+     * @function decodeDelimited
+     * @memberof SensorBatch
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @returns {SensorBatch} SensorBatch
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorBatch.decodeDelimited = function decodeDelimited(reader) {
+        if (!(reader instanceof $Reader))
+            reader = new $Reader(reader);
+        return this.decode(reader, reader.uint32());
+    };
+
+    /**
+     * Verifies a SensorBatch message.
+     * @function verify
+     * @memberof SensorBatch
+     * @static
+     * @param {Object.<string,*>} message Plain object to verify
+     * @returns {string|null} `null` if valid, otherwise the reason why it is not
+     */
+    SensorBatch.verify = function verify(message) {
+        if (typeof message !== "object" || message === null)
+            return "object expected";
+        if (message.seq != null && message.hasOwnProperty("seq"))
+            if (!$util.isInteger(message.seq))
+                return "seq: integer expected";
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            if (!$util.isInteger(message.sampleCount))
+                return "sampleCount: integer expected";
+        if (message.firstConversionUs != null && message.hasOwnProperty("firstConversionUs"))
+            if (!$util.isInteger(message.firstConversionUs) && !(message.firstConversionUs && $util.isInteger(message.firstConversionUs.low) && $util.isInteger(message.firstConversionUs.high)))
+                return "firstConversionUs: integer|Long expected";
+        if (message.conversionDeltaUs != null && message.hasOwnProperty("conversionDeltaUs")) {
+            if (!Array.isArray(message.conversionDeltaUs))
+                return "conversionDeltaUs: array expected";
+            for (let i = 0; i < message.conversionDeltaUs.length; ++i)
+                if (!$util.isInteger(message.conversionDeltaUs[i]))
+                    return "conversionDeltaUs: integer[] expected";
+        }
+        if (message.busMv != null && message.hasOwnProperty("busMv")) {
+            if (!Array.isArray(message.busMv))
+                return "busMv: array expected";
+            for (let i = 0; i < message.busMv.length; ++i)
+                if (!$util.isInteger(message.busMv[i]))
+                    return "busMv: integer[] expected";
+        }
+        if (message.shuntRaw != null && message.hasOwnProperty("shuntRaw")) {
+            if (!Array.isArray(message.shuntRaw))
+                return "shuntRaw: array expected";
+            for (let i = 0; i < message.shuntRaw.length; ++i)
+                if (!$util.isInteger(message.shuntRaw[i]))
+                    return "shuntRaw: integer[] expected";
+        }
+        if (message.shuntMohm != null && message.hasOwnProperty("shuntMohm")) {
+            if (!Array.isArray(message.shuntMohm))
+                return "shuntMohm: array expected";
+            for (let i = 0; i < message.shuntMohm.length; ++i)
+                if (!$util.isInteger(message.shuntMohm[i]))
+                    return "shuntMohm: integer[] expected";
+        }
+        if (message.disabledChannels != null && message.hasOwnProperty("disabledChannels"))
+            if (!$util.isInteger(message.disabledChannels))
+                return "disabledChannels: integer expected";
+        return null;
+    };
+
+    /**
+     * Creates a SensorBatch message from a plain object. Also converts values to their respective internal types.
+     * @function fromObject
+     * @memberof SensorBatch
+     * @static
+     * @param {Object.<string,*>} object Plain object
+     * @returns {SensorBatch} SensorBatch
+     */
+    SensorBatch.fromObject = function fromObject(object) {
+        if (object instanceof $root.SensorBatch)
+            return object;
+        let message = new $root.SensorBatch();
+        if (object.seq != null)
+            message.seq = object.seq >>> 0;
+        if (object.sampleCount != null)
+            message.sampleCount = object.sampleCount >>> 0;
+        if (object.firstConversionUs != null)
+            if ($util.Long)
+                (message.firstConversionUs = $util.Long.fromValue(object.firstConversionUs)).unsigned = true;
+            else if (typeof object.firstConversionUs === "string")
+                message.firstConversionUs = parseInt(object.firstConversionUs, 10);
+            else if (typeof object.firstConversionUs === "number")
+                message.firstConversionUs = object.firstConversionUs;
+            else if (typeof object.firstConversionUs === "object")
+                message.firstConversionUs = new $util.LongBits(object.firstConversionUs.low >>> 0, object.firstConversionUs.high >>> 0).toNumber(true);
+        if (object.conversionDeltaUs) {
+            if (!Array.isArray(object.conversionDeltaUs))
+                throw TypeError(".SensorBatch.conversionDeltaUs: array expected");
+            message.conversionDeltaUs = [];
+            for (let i = 0; i < object.conversionDeltaUs.length; ++i)
+                message.conversionDeltaUs[i] = object.conversionDeltaUs[i] >>> 0;
+        }
+        if (object.busMv) {
+            if (!Array.isArray(object.busMv))
+                throw TypeError(".SensorBatch.busMv: array expected");
+            message.busMv = [];
+            for (let i = 0; i < object.busMv.length; ++i)
+                message.busMv[i] = object.busMv[i] | 0;
+        }
+        if (object.shuntRaw) {
+            if (!Array.isArray(object.shuntRaw))
+                throw TypeError(".SensorBatch.shuntRaw: array expected");
+            message.shuntRaw = [];
+            for (let i = 0; i < object.shuntRaw.length; ++i)
+                message.shuntRaw[i] = object.shuntRaw[i] | 0;
+        }
+        if (object.shuntMohm) {
+            if (!Array.isArray(object.shuntMohm))
+                throw TypeError(".SensorBatch.shuntMohm: array expected");
+            message.shuntMohm = [];
+            for (let i = 0; i < object.shuntMohm.length; ++i)
+                message.shuntMohm[i] = object.shuntMohm[i] >>> 0;
+        }
+        if (object.disabledChannels != null)
+            message.disabledChannels = object.disabledChannels >>> 0;
+        return message;
+    };
+
+    /**
+     * Creates a plain object from a SensorBatch message. Also converts values to other types if specified.
+     * @function toObject
+     * @memberof SensorBatch
+     * @static
+     * @param {SensorBatch} message SensorBatch
+     * @param {$protobuf.IConversionOptions} [options] Conversion options
+     * @returns {Object.<string,*>} Plain object
+     */
+    SensorBatch.toObject = function toObject(message, options) {
+        if (!options)
+            options = {};
+        let object = {};
+        if (options.arrays || options.defaults) {
+            object.conversionDeltaUs = [];
+            object.busMv = [];
+            object.shuntRaw = [];
+            object.shuntMohm = [];
+        }
+        if (options.defaults) {
+            object.seq = 0;
+            object.sampleCount = 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.firstConversionUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.firstConversionUs = options.longs === String ? "0" : 0;
+            object.disabledChannels = 0;
+        }
+        if (message.seq != null && message.hasOwnProperty("seq"))
+            object.seq = message.seq;
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            object.sampleCount = message.sampleCount;
+        if (message.firstConversionUs != null && message.hasOwnProperty("firstConversionUs"))
+            if (typeof message.firstConversionUs === "number")
+                object.firstConversionUs = options.longs === String ? String(message.firstConversionUs) : message.firstConversionUs;
+            else
+                object.firstConversionUs = options.longs === String ? $util.Long.prototype.toString.call(message.firstConversionUs) : options.longs === Number ? new $util.LongBits(message.firstConversionUs.low >>> 0, message.firstConversionUs.high >>> 0).toNumber(true) : message.firstConversionUs;
+        if (message.conversionDeltaUs && message.conversionDeltaUs.length) {
+            object.conversionDeltaUs = [];
+            for (let j = 0; j < message.conversionDeltaUs.length; ++j)
+                object.conversionDeltaUs[j] = message.conversionDeltaUs[j];
+        }
+        if (message.busMv && message.busMv.length) {
+            object.busMv = [];
+            for (let j = 0; j < message.busMv.length; ++j)
+                object.busMv[j] = message.busMv[j];
+        }
+        if (message.shuntRaw && message.shuntRaw.length) {
+            object.shuntRaw = [];
+            for (let j = 0; j < message.shuntRaw.length; ++j)
+                object.shuntRaw[j] = message.shuntRaw[j];
+        }
+        if (message.shuntMohm && message.shuntMohm.length) {
+            object.shuntMohm = [];
+            for (let j = 0; j < message.shuntMohm.length; ++j)
+                object.shuntMohm[j] = message.shuntMohm[j];
+        }
+        if (message.disabledChannels != null && message.hasOwnProperty("disabledChannels"))
+            object.disabledChannels = message.disabledChannels;
+        return object;
+    };
+
+    /**
+     * Converts this SensorBatch to JSON.
+     * @function toJSON
+     * @memberof SensorBatch
+     * @instance
+     * @returns {Object.<string,*>} JSON object
+     */
+    SensorBatch.prototype.toJSON = function toJSON() {
+        return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
+    };
+
+    /**
+     * Gets the default type url for SensorBatch
+     * @function getTypeUrl
+     * @memberof SensorBatch
+     * @static
+     * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
+     * @returns {string} The default type url
+     */
+    SensorBatch.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+        if (typeUrlPrefix === undefined) {
+            typeUrlPrefix = "type.googleapis.com";
+        }
+        return typeUrlPrefix + "/SensorBatch";
+    };
+
+    return SensorBatch;
+})();
+
+export const StatsSummary = $root.StatsSummary = (() => {
+
+    /**
+     * Properties of a StatsSummary.
+     * @exports IStatsSummary
+     * @interface IStatsSummary
+     * @property {number|null} [min] StatsSummary min
+     * @property {number|null} [max] StatsSummary max
+     * @property {number|null} [mean] StatsSummary mean
+     * @property {number|null} [stddev] StatsSummary stddev
+     * @property {number|null} [p99] StatsSummary p99
+     */
+
+    /**
+     * Constructs a new StatsSummary.
+     * @exports StatsSummary
+     * @classdesc Represents a StatsSummary.
+     * @implements IStatsSummary
+     * @constructor
+     * @param {IStatsSummary=} [properties] Properties to set
+     */
+    function StatsSummary(properties) {
+        if (properties)
+            for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
+                if (properties[keys[i]] != null)
+                    this[keys[i]] = properties[keys[i]];
+    }
+
+    /**
+     * StatsSummary min.
+     * @member {number} min
+     * @memberof StatsSummary
+     * @instance
+     */
+    StatsSummary.prototype.min = 0;
+
+    /**
+     * StatsSummary max.
+     * @member {number} max
+     * @memberof StatsSummary
+     * @instance
+     */
+    StatsSummary.prototype.max = 0;
+
+    /**
+     * StatsSummary mean.
+     * @member {number} mean
+     * @memberof StatsSummary
+     * @instance
+     */
+    StatsSummary.prototype.mean = 0;
+
+    /**
+     * StatsSummary stddev.
+     * @member {number} stddev
+     * @memberof StatsSummary
+     * @instance
+     */
+    StatsSummary.prototype.stddev = 0;
+
+    /**
+     * StatsSummary p99.
+     * @member {number} p99
+     * @memberof StatsSummary
+     * @instance
+     */
+    StatsSummary.prototype.p99 = 0;
+
+    /**
+     * Creates a new StatsSummary instance using the specified properties.
+     * @function create
+     * @memberof StatsSummary
+     * @static
+     * @param {IStatsSummary=} [properties] Properties to set
+     * @returns {StatsSummary} StatsSummary instance
+     */
+    StatsSummary.create = function create(properties) {
+        return new StatsSummary(properties);
+    };
+
+    /**
+     * Encodes the specified StatsSummary message. Does not implicitly {@link StatsSummary.verify|verify} messages.
+     * @function encode
+     * @memberof StatsSummary
+     * @static
+     * @param {IStatsSummary} message StatsSummary message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    StatsSummary.encode = function encode(message, writer) {
+        if (!writer)
+            writer = $Writer.create();
+        if (message.min != null && Object.hasOwnProperty.call(message, "min"))
+            writer.uint32(/* id 1, wireType 5 =*/13).float(message.min);
+        if (message.max != null && Object.hasOwnProperty.call(message, "max"))
+            writer.uint32(/* id 2, wireType 5 =*/21).float(message.max);
+        if (message.mean != null && Object.hasOwnProperty.call(message, "mean"))
+            writer.uint32(/* id 3, wireType 5 =*/29).float(message.mean);
+        if (message.stddev != null && Object.hasOwnProperty.call(message, "stddev"))
+            writer.uint32(/* id 4, wireType 5 =*/37).float(message.stddev);
+        if (message.p99 != null && Object.hasOwnProperty.call(message, "p99"))
+            writer.uint32(/* id 5, wireType 5 =*/45).float(message.p99);
+        return writer;
+    };
+
+    /**
+     * Encodes the specified StatsSummary message, length delimited. Does not implicitly {@link StatsSummary.verify|verify} messages.
+     * @function encodeDelimited
+     * @memberof StatsSummary
+     * @static
+     * @param {IStatsSummary} message StatsSummary message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    StatsSummary.encodeDelimited = function encodeDelimited(message, writer) {
+        return this.encode(message, writer).ldelim();
+    };
+
+    /**
+     * Decodes a StatsSummary message from the specified reader or buffer.
+     * @function decode
+     * @memberof StatsSummary
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @param {number} [length] Message length if known beforehand
+     * @returns {StatsSummary} StatsSummary
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    StatsSummary.decode = function decode(reader, length, error) {
+        if (!(reader instanceof $Reader))
+            reader = $Reader.create(reader);
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.StatsSummary();
+        while (reader.pos < end) {
+            let tag = reader.uint32();
+            if (tag === error)
+                break;
+            switch (tag >>> 3) {
+            case 1: {
+                    message.min = reader.float();
+                    break;
+                }
+            case 2: {
+                    message.max = reader.float();
+                    break;
+                }
+            case 3: {
+                    message.mean = reader.float();
+                    break;
+                }
+            case 4: {
+                    message.stddev = reader.float();
+                    break;
+                }
+            case 5: {
+                    message.p99 = reader.float();
+                    break;
+                }
+            default:
+                reader.skipType(tag & 7);
+                break;
+            }
+        }
+        return message;
+    };
+
+    /**
+     * Decodes a StatsSummary message from the specified reader or buffer, length delimited.
+     * @function decodeDelimited
+     * @memberof StatsSummary
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @returns {StatsSummary} StatsSummary
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    StatsSummary.decodeDelimited = function decodeDelimited(reader) {
+        if (!(reader instanceof $Reader))
+            reader = new $Reader(reader);
+        return this.decode(reader, reader.uint32());
+    };
+
+    /**
+     * Verifies a StatsSummary message.
+     * @function verify
+     * @memberof StatsSummary
+     * @static
+     * @param {Object.<string,*>} message Plain object to verify
+     * @returns {string|null} `null` if valid, otherwise the reason why it is not
+     */
+    StatsSummary.verify = function verify(message) {
+        if (typeof message !== "object" || message === null)
+            return "object expected";
+        if (message.min != null && message.hasOwnProperty("min"))
+            if (typeof message.min !== "number")
+                return "min: number expected";
+        if (message.max != null && message.hasOwnProperty("max"))
+            if (typeof message.max !== "number")
+                return "max: number expected";
+        if (message.mean != null && message.hasOwnProperty("mean"))
+            if (typeof message.mean !== "number")
+                return "mean: number expected";
+        if (message.stddev != null && message.hasOwnProperty("stddev"))
+            if (typeof message.stddev !== "number")
+                return "stddev: number expected";
+        if (message.p99 != null && message.hasOwnProperty("p99"))
+            if (typeof message.p99 !== "number")
+                return "p99: number expected";
+        return null;
+    };
+
+    /**
+     * Creates a StatsSummary message from a plain object. Also converts values to their respective internal types.
+     * @function fromObject
+     * @memberof StatsSummary
+     * @static
+     * @param {Object.<string,*>} object Plain object
+     * @returns {StatsSummary} StatsSummary
+     */
+    StatsSummary.fromObject = function fromObject(object) {
+        if (object instanceof $root.StatsSummary)
+            return object;
+        let message = new $root.StatsSummary();
+        if (object.min != null)
+            message.min = Number(object.min);
+        if (object.max != null)
+            message.max = Number(object.max);
+        if (object.mean != null)
+            message.mean = Number(object.mean);
+        if (object.stddev != null)
+            message.stddev = Number(object.stddev);
+        if (object.p99 != null)
+            message.p99 = Number(object.p99);
+        return message;
+    };
+
+    /**
+     * Creates a plain object from a StatsSummary message. Also converts values to other types if specified.
+     * @function toObject
+     * @memberof StatsSummary
+     * @static
+     * @param {StatsSummary} message StatsSummary
+     * @param {$protobuf.IConversionOptions} [options] Conversion options
+     * @returns {Object.<string,*>} Plain object
+     */
+    StatsSummary.toObject = function toObject(message, options) {
+        if (!options)
+            options = {};
+        let object = {};
+        if (options.defaults) {
+            object.min = 0;
+            object.max = 0;
+            object.mean = 0;
+            object.stddev = 0;
+            object.p99 = 0;
+        }
+        if (message.min != null && message.hasOwnProperty("min"))
+            object.min = options.json && !isFinite(message.min) ? String(message.min) : message.min;
+        if (message.max != null && message.hasOwnProperty("max"))
+            object.max = options.json && !isFinite(message.max) ? String(message.max) : message.max;
+        if (message.mean != null && message.hasOwnProperty("mean"))
+            object.mean = options.json && !isFinite(message.mean) ? String(message.mean) : message.mean;
+        if (message.stddev != null && message.hasOwnProperty("stddev"))
+            object.stddev = options.json && !isFinite(message.stddev) ? String(message.stddev) : message.stddev;
+        if (message.p99 != null && message.hasOwnProperty("p99"))
+            object.p99 = options.json && !isFinite(message.p99) ? String(message.p99) : message.p99;
+        return object;
+    };
+
+    /**
+     * Converts this StatsSummary to JSON.
+     * @function toJSON
+     * @memberof StatsSummary
+     * @instance
+     * @returns {Object.<string,*>} JSON object
+     */
+    StatsSummary.prototype.toJSON = function toJSON() {
+        return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
+    };
+
+    /**
+     * Gets the default type url for StatsSummary
+     * @function getTypeUrl
+     * @memberof StatsSummary
+     * @static
+     * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
+     * @returns {string} The default type url
+     */
+    StatsSummary.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+        if (typeUrlPrefix === undefined) {
+            typeUrlPrefix = "type.googleapis.com";
+        }
+        return typeUrlPrefix + "/StatsSummary";
+    };
+
+    return StatsSummary;
+})();
+
+export const ChannelStats = $root.ChannelStats = (() => {
+
+    /**
+     * Properties of a ChannelStats.
+     * @exports IChannelStats
+     * @interface IChannelStats
+     * @property {IStatsSummary|null} [voltage] ChannelStats voltage
+     * @property {IStatsSummary|null} [current] ChannelStats current
+     * @property {IStatsSummary|null} [power] ChannelStats power
+     */
+
+    /**
+     * Constructs a new ChannelStats.
+     * @exports ChannelStats
+     * @classdesc Represents a ChannelStats.
+     * @implements IChannelStats
+     * @constructor
+     * @param {IChannelStats=} [properties] Properties to set
+     */
+    function ChannelStats(properties) {
+        if (properties)
+            for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
+                if (properties[keys[i]] != null)
+                    this[keys[i]] = properties[keys[i]];
+    }
+
+    /**
+     * ChannelStats voltage.
+     * @member {IStatsSummary|null|undefined} voltage
+     * @memberof ChannelStats
+     * @instance
+     */
+    ChannelStats.prototype.voltage = null;
+
+    /**
+     * ChannelStats current.
+     * @member {IStatsSummary|null|undefined} current
+     * @memberof ChannelStats
+     * @instance
+     */
+    ChannelStats.prototype.current = null;
+
+    /**
+     * ChannelStats power.
+     * @member {IStatsSummary|null|undefined} power
+     * @memberof ChannelStats
+     * @instance
+     */
+    ChannelStats.prototype.power = null;
+
+    /**
+     * Creates a new ChannelStats instance using the specified properties.
+     * @function create
+     * @memberof ChannelStats
+     * @static
+     * @param {IChannelStats=} [properties] Properties to set
+     * @returns {ChannelStats} ChannelStats instance
+     */
+    ChannelStats.create = function create(properties) {
+        return new ChannelStats(properties);
+    };
+
+    /**
+     * Encodes the specified ChannelStats message. Does not implicitly {@link ChannelStats.verify|verify} messages.
+     * @function encode
+     * @memberof ChannelStats
+     * @static
+     * @param {IChannelStats} message ChannelStats message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    ChannelStats.encode = function encode(message, writer) {
+        if (!writer)
+            writer = $Writer.create();
+        if (message.voltage != null && Object.hasOwnProperty.call(message, "voltage"))
+            $root.StatsSummary.encode(message.voltage, writer.uint32(/* id 1, wireType 2 =*/10).fork()).ldelim();
+        if (message.current != null && Object.hasOwnProperty.call(message, "current"))
+            $root.StatsSummary.encode(message.current, writer.uint32(/* id 2, wireType 2 =*/18).fork()).ldelim();
+        if (message.power != null && Object.hasOwnProperty.call(message, "power"))
+            $root.StatsSummary.encode(message.power, writer.uint32(/* id 3, wireType 2 =*/26).fork()).ldelim();
+        return writer;
+    };
+
+    /**
+     * Encodes the specified ChannelStats message, length delimited. Does not implicitly {@link ChannelStats.verify|verify} messages.
+     * @function encodeDelimited
+     * @memberof ChannelStats
+     * @static
+     * @param {IChannelStats} message ChannelStats message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    ChannelStats.encodeDelimited = function encodeDelimited(message, writer) {
+        return this.encode(message, writer).ldelim();
+    };
+
+    /**
+     * Decodes a ChannelStats message from the specified reader or buffer.
+     * @function decode
+     * @memberof ChannelStats
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @param {number} [length] Message length if known beforehand
+     * @returns {ChannelStats} ChannelStats
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    ChannelStats.decode = function decode(reader, length, error) {
+        if (!(reader instanceof $Reader))
+            reader = $Reader.create(reader);
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.ChannelStats();
+        while (reader.pos < end) {
+            let tag = reader.uint32();
+            if (tag === error)
+                break;
+            switch (tag >>> 3) {
+            case 1: {
+                    message.voltage = $root.StatsSummary.decode(reader, reader.uint32());
+                    break;
+                }
+            case 2: {
+                    message.current = $root.StatsSummary.decode(reader, reader.uint32());
+                    break;
+                }
+            case 3: {
+                    message.power = $root.StatsSummary.decode(reader, reader.uint32());
+                    break;
+                }
+            default:
+                reader.skipType(tag & 7);
+                break;
+            }
+        }
+        return message;
+    };
+
+    /**
+     * Decodes a ChannelStats message from the specified reader or buffer, length delimited.
+     * @function decodeDelimited
+     * @memberof ChannelStats
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @returns {ChannelStats} ChannelStats
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    ChannelStats.decodeDelimited = function decodeDelimited(reader) {
+        if (!(reader instanceof $Reader))
+            reader = new $Reader(reader);
+        return this.decode(reader, reader.uint32());
+    };
+
+    /**
+     * Verifies a ChannelStats message.
+     * @function verify
+     * @memberof ChannelStats
+     * @static
+     * @param {Object.<string,*>} message Plain object to verify
+     * @returns {string|null} `null` if valid, otherwise the reason why it is not
+     */
+    ChannelStats.verify = function verify(message) {
+        if (typeof message !== "object" || message === null)
+            return "object expected";
+        if (message.voltage != null && message.hasOwnProperty("voltage")) {
+            let error = $root.StatsSummary.verify(message.voltage);
+            if (error)
+                return "voltage." + error;
+        }
+        if (message.current != null && message.hasOwnProperty("current")) {
+            let error = $root.StatsSummary.verify(message.current);
+            if (error)
+                return "current." + error;
+        }
+        if (message.power != null && message.hasOwnProperty("power")) {
+            let error = $root.StatsSummary.verify(message.power);
+            if (error)
+                return "power." + error;
+        }
+        return null;
+    };
+
+    /**
+     * Creates a ChannelStats message from a plain object. Also converts values to their respective internal types.
+     * @function fromObject
+     * @memberof ChannelStats
+     * @static
+     * @param {Object.<string,*>} object Plain object
+     * @returns {ChannelStats} ChannelStats
+     */
+    ChannelStats.fromObject = function fromObject(object) {
+        if (object instanceof $root.ChannelStats)
+            return object;
+        let message = new $root.ChannelStats();
+        if (object.voltage != null) {
+            if (typeof object.voltage !== "object")
+                throw TypeError(".ChannelStats.voltage: object expected");
+            message.voltage = $root.StatsSummary.fromObject(object.voltage);
+        }
+        if (object.current != null) {
+            if (typeof object.current !== "object")
+                throw TypeError(".ChannelStats.current: object expected");
+            message.current = $root.StatsSummary.fromObject(object.current);
+        }
+        if (object.power != null) {
+            if (typeof object.power !== "object")
+                throw TypeError(".ChannelStats.power: object expected");
+            message.power = $root.StatsSummary.fromObject(object.power);
+        }
+        return message;
+    };
+
+    /**
+     * Creates a plain object from a ChannelStats message. Also converts values to other types if specified.
+     * @function toObject
+     * @memberof ChannelStats
+     * @static
+     * @param {ChannelStats} message ChannelStats
+     * @param {$protobuf.IConversionOptions} [options] Conversion options
+     * @returns {Object.<string,*>} Plain object
+     */
+    ChannelStats.toObject = function toObject(message, options) {
+        if (!options)
+            options = {};
+        let object = {};
+        if (options.defaults) {
+            object.voltage = null;
+            object.current = null;
+            object.power = null;
+        }
+        if (message.voltage != null && message.hasOwnProperty("voltage"))
+            object.voltage = $root.StatsSummary.toObject(message.voltage, options);
+        if (message.current != null && message.hasOwnProperty("current"))
+            object.current = $root.StatsSummary.toObject(message.current, options);
+        if (message.power != null && message.hasOwnProperty("power"))
+            object.power = $root.StatsSummary.toObject(message.power, options);
+        return object;
+    };
+
+    /**
+     * Converts this ChannelStats to JSON.
+     * @function toJSON
+     * @memberof ChannelStats
+     * @instance
+     * @returns {Object.<string,*>} JSON object
+     */
+    ChannelStats.prototype.toJSON = function toJSON() {
+        return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
+    };
+
+    /**
+     * Gets the default type url for ChannelStats
+     * @function getTypeUrl
+     * @memberof ChannelStats
+     * @static
+     * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
+     * @returns {string} The default type url
+     */
+    ChannelStats.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+        if (typeUrlPrefix === undefined) {
+            typeUrlPrefix = "type.googleapis.com";
+        }
+        return typeUrlPrefix + "/ChannelStats";
+    };
+
+    return ChannelStats;
+})();
+
+export const SensorStats = $root.SensorStats = (() => {
+
+    /**
+     * Properties of a SensorStats.
+     * @exports ISensorStats
+     * @interface ISensorStats
+     * @property {number|null} [windowMs] SensorStats windowMs
+     * @property {number|null} [sampleCount] SensorStats sampleCount
+     * @property {number|Long|null} [timestampMs] SensorStats timestampMs
+     * @property {number|Long|null} [uptimeMs] SensorStats uptimeMs
+     * @property {IChannelStats|null} [usb] SensorStats usb
+     * @property {IChannelStats|null} [main] SensorStats main
+     * @property {IChannelStats|null} [vin] SensorStats vin
+     */
+
+    /**
+     * Constructs a new SensorStats.
+     * @exports SensorStats
+     * @classdesc Represents a SensorStats.
+     * @implements ISensorStats
+     * @constructor
+     * @param {ISensorStats=} [properties] Properties to set
+     */
+    function SensorStats(properties) {
+        if (properties)
+            for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
+                if (properties[keys[i]] != null)
+                    this[keys[i]] = properties[keys[i]];
+    }
+
+    /**
+     * SensorStats windowMs.
+     * @member {number} windowMs
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.windowMs = 0;
+
+    /**
+     * SensorStats sampleCount.
+     * @member {number} sampleCount
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.sampleCount = 0;
+
+    /**
+     * SensorStats timestampMs.
+     * @member {number|Long} timestampMs
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.timestampMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorStats uptimeMs.
+     * @member {number|Long} uptimeMs
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.uptimeMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+
+    /**
+     * SensorStats usb.
+     * @member {IChannelStats|null|undefined} usb
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.usb = null;
+
+    /**
+     * SensorStats main.
+     * @member {IChannelStats|null|undefined} main
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.main = null;
+
+    /**
+     * SensorStats vin.
+     * @member {IChannelStats|null|undefined} vin
+     * @memberof SensorStats
+     * @instance
+     */
+    SensorStats.prototype.vin = null;
+
+    /**
+     * Creates a new SensorStats instance using the specified properties.
+     * @function create
+     * @memberof SensorStats
+     * @static
+     * @param {ISensorStats=} [properties] Properties to set
+     * @returns {SensorStats} SensorStats instance
+     */
+    SensorStats.create = function create(properties) {
+        return new SensorStats(properties);
+    };
+
+    /**
+     * Encodes the specified SensorStats message. Does not implicitly {@link SensorStats.verify|verify} messages.
+     * @function encode
+     * @memberof SensorStats
+     * @static
+     * @param {ISensorStats} message SensorStats message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorStats.encode = function encode(message, writer) {
+        if (!writer)
+            writer = $Writer.create();
+        if (message.windowMs != null && Object.hasOwnProperty.call(message, "windowMs"))
+            writer.uint32(/* id 1, wireType 0 =*/8).uint32(message.windowMs);
+        if (message.sampleCount != null && Object.hasOwnProperty.call(message, "sampleCount"))
+            writer.uint32(/* id 2, wireType 0 =*/16).uint32(message.sampleCount);
+        if (message.timestampMs != null && Object.hasOwnProperty.call(message, "timestampMs"))
+            writer.uint32(/* id 3, wireType 0 =*/24).uint64(message.timestampMs);
+        if (message.uptimeMs != null && Object.hasOwnProperty.call(message, "uptimeMs"))
+            writer.uint32(/* id 4, wireType 0 =*/32).uint64(message.uptimeMs);
+        if (message.usb != null && Object.hasOwnProperty.call(message, "usb"))
+            $root.ChannelStats.encode(message.usb, writer.uint32(/* id 5, wireType 2 =*/42).fork()).ldelim();
+        if (message.main != null && Object.hasOwnProperty.call(message, "main"))
+            $root.ChannelStats.encode(message.main, writer.uint32(/* id 6, wireType 2 =*/50).fork()).ldelim();
+        if (message.vin != null && Object.hasOwnProperty.call(message, "vin"))
+            $root.ChannelStats.encode(message.vin, writer.uint32(/* id 7, wireType 2 =*/58).fork()).ldelim();
+        return writer;
+    };
+
+    /**
+     * Encodes the specified SensorStats message, length delimited. Does not implicitly {@link SensorStats.verify|verify} messages.
+     * @function encodeDelimited
+     * @memberof SensorStats
+     * @static
+     * @param {ISensorStats} message SensorStats message or plain object to encode
+     * @param {$protobuf.Writer} [writer] Writer to encode to
+     * @returns {$protobuf.Writer} Writer
+     */
+    SensorStats.encodeDelimited = function encodeDelimited(message, writer) {
+        return this.encode(message, writer).ldelim();
+    };
+
+    /**
+     * Decodes a SensorStats message from the specified reader or buffer.
+     * @function decode
+     * @memberof SensorStats
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @param {number} [length] Message length if known beforehand
+     * @returns {SensorStats} SensorStats
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorStats.decode = function decode(reader, length, error) {
+        if (!(reader instanceof $Reader))
+            reader = $Reader.create(reader);
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.SensorStats();
+        while (reader.pos < end) {
+            let tag = reader.uint32();
+            if (tag === error)
+                break;
+            switch (tag >>> 3) {
+            case 1: {
+                    message.windowMs = reader.uint32();
+                    break;
+                }
+            case 2: {
+                    message.sampleCount = reader.uint32();
+                    break;
+                }
+            case 3: {
+                    message.timestampMs = reader.uint64();
+                    break;
+                }
+            case 4: {
+                    message.uptimeMs = reader.uint64();
+                    break;
+                }
+            case 5: {
+                    message.usb = $root.ChannelStats.decode(reader, reader.uint32());
+                    break;
+                }
+            case 6: {
+                    message.main = $root.ChannelStats.decode(reader, reader.uint32());
+                    break;
+                }
+            case 7: {
+                    message.vin = $root.ChannelStats.decode(reader, reader.uint32());
+                    break;
+                }
+            default:
+                reader.skipType(tag & 7);
+                break;
+            }
+        }
+        return message;
+    };
+
+    /**
+     * Decodes a SensorStats message from the specified reader or buffer, length delimited.
+     * @function decodeDelimited
+     * @memberof SensorStats
+     * @static
+     * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
+     * @returns {SensorStats} SensorStats
+     * @throws {Error} If the payload is not a reader or valid buffer
+     * @throws {$protobuf.util.ProtocolError} If required fields are missing
+     */
+    SensorStats.decodeDelimited = function decodeDelimited(reader) {
+        if (!(reader instanceof $Reader))
+            reader = new $Reader(reader);
+        return this.decode(reader, reader.uint32());
+    };
+
+    /**
+     * Verifies a SensorStats message.
+     * @function verify
+     * @memberof SensorStats
+     * @static
+     * @param {Object.<string,*>} message Plain object to verify
+     * @returns {string|null} `null` if valid, otherwise the reason why it is not
+     */
+    SensorStats.verify = function verify(message) {
+        if (typeof message !== "object" || message === null)
+            return "object expected";
+        if (message.windowMs != null && message.hasOwnProperty("windowMs"))
+            if (!$util.isInteger(message.windowMs))
+                return "windowMs: integer expected";
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            if (!$util.isInteger(message.sampleCount))
+                return "sampleCount: integer expected";
+        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
+            if (!$util.isInteger(message.timestampMs) && !(message.timestampMs && $util.isInteger(message.timestampMs.low) && $util.isInteger(message.timestampMs.high)))
+                return "timestampMs: integer|Long expected";
+        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
+            if (!$util.isInteger(message.uptimeMs) && !(message.uptimeMs && $util.isInteger(message.uptimeMs.low) && $util.isInteger(message.uptimeMs.high)))
+                return "uptimeMs: integer|Long expected";
+        if (message.usb != null && message.hasOwnProperty("usb")) {
+            let error = $root.ChannelStats.verify(message.usb);
+            if (error)
+                return "usb." + error;
+        }
+        if (message.main != null && message.hasOwnProperty("main")) {
+            let error = $root.ChannelStats.verify(message.main);
+            if (error)
+                return "main." + error;
+        }
+        if (message.vin != null && message.hasOwnProperty("vin")) {
+            let error = $root.ChannelStats.verify(message.vin);
+            if (error)
+                return "vin." + error;
+        }
+        return null;
+    };
+
+    /**
+     * Creates a SensorStats message from a plain object. Also converts values to their respective internal types.
+     * @function fromObject
+     * @memberof SensorStats
+     * @static
+     * @param {Object.<string,*>} object Plain object
+     * @returns {SensorStats} SensorStats
+     */
+    SensorStats.fromObject = function fromObject(object) {
+        if (object instanceof $root.SensorStats)
+            return object;
+        let message = new $root.SensorStats();
+        if (object.windowMs != null)
+            message.windowMs = object.windowMs >>> 0;
+        if (object.sampleCount != null)
+            message.sampleCount = object.sampleCount >>> 0;
+        if (object.timestampMs != null)
+            if ($util.Long)
+                (message.timestampMs = $util.Long.fromValue(object.timestampMs)).unsigned = true;
+            else if (typeof object.timestampMs === "string")
+                message.timestampMs = parseInt(object.timestampMs, 10);
+            else if (typeof object.timestampMs === "number")
+                message.timestampMs = object.timestampMs;
+            else if (typeof object.timestampMs === "object")
+                message.timestampMs = new $util.LongBits(object.timestampMs.low >>> 0, object.timestampMs.high >>> 0).toNumber(true);
+        if (object.uptimeMs != null)
+            if ($util.Long)
+                (message.uptimeMs = $util.Long.fromValue(object.uptimeMs)).unsigned = true;
+            else if (typeof object.uptimeMs === "string")
+                message.uptimeMs = parseInt(object.uptimeMs, 10);
+            else if (typeof object.uptimeMs === "number")
+                message.uptimeMs = object.uptimeMs;
+            else if (typeof object.uptimeMs === "object")
+                message.uptimeMs = new $util.LongBits(object.uptimeMs.low >>> 0, object.uptimeMs.high >>> 0).toNumber(true);
+        if (object.usb != null) {
+            if (typeof object.usb !== "object")
+                throw TypeError(".SensorStats.usb: object expected");
+            message.usb = $root.ChannelStats.fromObject(object.usb);
+        }
+        if (object.main != null) {
+            if (typeof object.main !== "object")
+                throw TypeError(".SensorStats.main: object expected");
+            message.main = $root.ChannelStats.fromObject(object.main);
+        }
+        if (object.vin != null) {
+            if (typeof object.vin !== "object")
+                throw TypeError(".SensorStats.vin: object expected");
+            message.vin = $root.ChannelStats.fromObject(object.vin);
+        }
+        return message;
+    };
+
+    /**
+     * Creates a plain object from a SensorStats message. Also converts values to other types if specified.
+     * @function toObject
+     * @memberof SensorStats
+     * @static
+     * @param {SensorStats} message SensorStats
+     * @param {$protobuf.IConversionOptions} [options] Conversion options
+     * @returns {Object.<string,*>} Plain object
+     */
+    SensorStats.toObject = function toObject(message, options) {
+        if (!options)
+            options = {};
+        let object = {};
+        if (options.defaults) {
+            object.windowMs = 0;
+            object.sampleCount = 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.timestampMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.timestampMs = options.longs === String ? "0" : 0;
+            if ($util.Long) {
+                let long = new $util.Long(0, 0, true);
+                object.uptimeMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+            } else
+                object.uptimeMs = options.longs === String ? "0" : 0;
+            object.usb = null;
+            object.main = null;
+            object.vin = null;
+        }
+        if (message.windowMs != null && message.hasOwnProperty("windowMs"))
+            object.windowMs = message.windowMs;
+        if (message.sampleCount != null && message.hasOwnProperty("sampleCount"))
+            object.sampleCount = message.sampleCount;
+        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
+            if (typeof message.timestampMs === "number")
+                object.timestampMs = options.longs === String ? String(message.timestampMs) : message.timestampMs;
+            else
+                object.timestampMs = options.longs === String ? $util.Long.prototype.toString.call(message.timestampMs) : options.longs === Number ? new $util.LongBits(message.timestampMs.low >>> 0, message.timestampMs.high >>> 0).toNumber(true) : message.timestampMs;
+        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
+            if (typeof message.uptimeMs === "number")
+                object.uptimeMs = options.longs === String ? String(message.uptimeMs) : message.uptimeMs;
+            else
+                object.uptimeMs = options.longs === String ? $util.Long.prototype.toString.call(message.uptimeMs) : options.longs === Number ? new $util.LongBits(message.uptimeMs.low >>> 0, message.uptimeMs.high >>> 0).toNumber(true) : message.uptimeMs;
+        if (message.usb != null && message.hasOwnProperty("usb"))
+            object.usb = $root.ChannelStats.toObject(message.usb, options);
+        if (message.main != null && message.hasOwnProperty("main"))
+            object.main = $root.ChannelStats.toObject(message.main, options);
+        if (message.vin != null && message.hasOwnProperty("vin"))
+            object.vin = $root.ChannelStats.toObject(message.vin, options);
+        return object;
+    };
+
+    /**
+     * Converts this SensorStats to JSON.
+     * @function toJSON
+     * @memberof SensorStats
+     * @instance
+     * @returns {Object.<string,*>} JSON object
+     */
+    SensorStats.prototype.toJSON = function toJSON() {
+        return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
+    };
+
+    /**
+     * Gets the default type url for SensorStats
+     * @function getTypeUrl
+     * @memberof SensorStats
+     * @static
+     * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
+     * @returns {string} The default type url
+     */
+    SensorStats.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+        if (typeUrlPrefix === undefined) {
+            typeUrlPrefix = "type.googleapis.com";
+        }
+        return typeUrlPrefix + "/SensorStats";
+    };
+
+    return SensorStats;
+})();
+
+export const ClockSync = $root.ClockSync = (() => {
+
+    /**
+     * Properties of a ClockSync.
+     * @exports IClockSync
+     * @interface IClockSync
+     * @property {number|Long|null} [wallUs] ClockSync wallUs
+     * @property {number|Long|null} [uptimeUs] ClockSync uptimeUs
+     * @property {number|null} [uncertaintyUs] ClockSync uncertaintyUs
      */
 
     /**
-     * Constructs a new SensorData.
-     * @exports SensorData
-     * @classdesc Represents a SensorData.
-     * @implements ISensorData
+     * Constructs a new ClockSync.
+     * @exports ClockSync
+     * @classdesc Represents a ClockSync.
+     * @implements IClockSync
      * @constructor
-     * @param {ISensorData=} [properties] Properties to set
+     * @param {IClockSync=} [properties] Properties to set
      */
-    function SensorData(properties) {
+    function ClockSync(properties) {
         if (properties)
             for (let keys = Object.keys(properties), i = 0; i < keys.length; ++i)
                 if (properties[keys[i]] != null)
@@ -288,133 +3068,105 @@ export const SensorData = $root.SensorData = (() => {
     }
 
     /**
-     * SensorData usb.
-     * @member {ISensorChannelData|null|undefined} usb
-     * @memberof SensorData
-     * @instance
-     */
-    SensorData.prototype.usb = null;
-
-    /**
-     * SensorData main.
-     * @member {ISensorChannelData|null|undefined} main
-     * @memberof SensorData
-     * @instance
-     */
-    SensorData.prototype.main = null;
-
-    /**
-     * SensorData vin.
-     * @member {ISensorChannelData|null|undefined} vin
-     * @memberof SensorData
+     * ClockSync wallUs.
+     * @member {number|Long} wallUs
+     * @memberof ClockSync
      * @instance
      */
-    SensorData.prototype.vin = null;
+    ClockSync.prototype.wallUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
 
     /**
-     * SensorData timestampMs.
-     * @member {number|Long} timestampMs
-     * @memberof SensorData
+     * ClockSync uptimeUs.
+     * @member {number|Long} uptimeUs
+     * @memberof ClockSync
      * @instance
      */
-    SensorData.prototype.timestampMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+    ClockSync.prototype.uptimeUs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
 
     /**
-     * SensorData uptimeMs.
-     * @member {number|Long} uptimeMs
-     * @memberof SensorData
+     * ClockSync uncertaintyUs.
+     * @member {number} uncertaintyUs
+     * @memberof ClockSync
      * @instance
      */
-    SensorData.prototype.uptimeMs = $util.Long ? $util.Long.fromBits(0,0,true) : 0;
+    ClockSync.prototype.uncertaintyUs = 0;
 
     /**
-     * Creates a new SensorData instance using the specified properties.
+     * Creates a new ClockSync instance using the specified properties.
      * @function create
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
-     * @param {ISensorData=} [properties] Properties to set
-     * @returns {SensorData} SensorData instance
+     * @param {IClockSync=} [properties] Properties to set
+     * @returns {ClockSync} ClockSync instance
      */
-    SensorData.create = function create(properties) {
-        return new SensorData(properties);
+    ClockSync.create = function create(properties) {
+        return new ClockSync(properties);
     };
 
     /**
-     * Encodes the specified SensorData message. Does not implicitly {@link SensorData.verify|verify} messages.
+     * Encodes the specified ClockSync message. Does not implicitly {@link ClockSync.verify|verify} messages.
      * @function encode
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
-     * @param {ISensorData} message SensorData message or plain object to encode
+     * @param {IClockSync} message ClockSync message or plain object to encode
      * @param {$protobuf.Writer} [writer] Writer to encode to
      * @returns {$protobuf.Writer} Writer
      */
-    SensorData.encode = function encode(message, writer) {
+    ClockSync.encode = function encode(message, writer) {
         if (!writer)
             writer = $Writer.create();
-        if (message.usb != null && Object.hasOwnProperty.call(message, "usb"))
-            $root.SensorChannelData.encode(message.usb, writer.uint32(/* id 1, wireType 2 =*/10).fork()).ldelim();
-        if (message.main != null && Object.hasOwnProperty.call(message, "main"))
-            $root.SensorChannelData.encode(message.main, writer.uint32(/* id 2, wireType 2 =*/18).fork()).ldelim();
-        if (message.vin != null && Object.hasOwnProperty.call(message, "vin"))
-            $root.SensorChannelData.encode(message.vin, writer.uint32(/* id 3, wireType 2 =*/26).fork()).ldelim();
-        if (message.timestampMs != null && Object.hasOwnProperty.call(message, "timestampMs"))
-            writer.uint32(/* id 4, wireType 0 =*/32).uint64(message.timestampMs);
-        if (message.uptimeMs != null && Object.hasOwnProperty.call(message, "uptimeMs"))
-            writer.uint32(/* id 5, wireType 0 =*/40).uint64(message.uptimeMs);
+        if (message.wallUs != null && Object.hasOwnProperty.call(message, "wallUs"))
+            writer.uint32(/* id 1, wireType 0 =*/8).uint64(message.wallUs);
+        if (message.uptimeUs != null && Object.hasOwnProperty.call(message, "uptimeUs"))
+            writer.uint32(/* id 2, wireType 0 =*/16).uint64(message.uptimeUs);
+        if (message.uncertaintyUs != null && Object.hasOwnProperty.call(message, "uncertaintyUs"))
+            writer.uint32(/* id 3, wireType 0 =*/24).uint32(message.uncertaintyUs);
         return writer;
     };
 
     /**
-     * Encodes the specified SensorData message, length delimited. Does not implicitly {@link SensorData.verify|verify} messages.
+     * Encodes the specified ClockSync message, length delimited. Does not implicitly {@link ClockSync.verify|verify} messages.
      * @function encodeDelimited
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
-     * @param {ISensorData} message SensorData message or plain object to encode
+     * @param {IClockSync} message ClockSync message or plain object to encode
      * @param {$protobuf.Writer} [writer] Writer to encode to
      * @returns {$protobuf.Writer} Writer
      */
-    SensorData.encodeDelimited = function encodeDelimited(message, writer) {
+    ClockSync.encodeDelimited = function encodeDelimited(message, writer) {
         return this.encode(message, writer).ldelim();
     };
 
     /**
-     * Decodes a SensorData message from the specified reader or buffer.
+     * Decodes a ClockSync message from the specified reader or buffer.
      * @function decode
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
      * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
      * @param {number} [length] Message length if known beforehand
-     * @returns {SensorData} SensorData
+     * @returns {ClockSync} ClockSync
      * @throws {Error} If the payload is not a reader or valid buffer
      * @throws {$protobuf.util.ProtocolError} If required fields are missing
      */
-    SensorData.decode = function decode(reader, length, error) {
+    ClockSync.decode = function decode(reader, length, error) {
         if (!(reader instanceof $Reader))
             reader = $Reader.create(reader);
-        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.SensorData();
+        let end = length === undefined ? reader.len : reader.pos + length, message = new $root.ClockSync();
         while (reader.pos < end) {
             let tag = reader.uint32();
             if (tag === error)
                 break;
             switch (tag >>> 3) {
             case 1: {
-                    message.usb = $root.SensorChannelData.decode(reader, reader.uint32());
+                    message.wallUs = reader.uint64();
                     break;
                 }
             case 2: {
-                    message.main = $root.SensorChannelData.decode(reader, reader.uint32());
+                    message.uptimeUs = reader.uint64();
                     break;
                 }
             case 3: {
-                    message.vin = $root.SensorChannelData.decode(reader, reader.uint32());
-                    break;
-                }
-            case 4: {
-                    message.timestampMs = reader.uint64();
-                    break;
-                }
-            case 5: {
-                    message.uptimeMs = reader.uint64();
+                    message.uncertaintyUs = reader.uint32();
                     break;
                 }
             default:
@@ -426,178 +3178,147 @@ export const SensorData = $root.SensorData = (() => {
     };
 
     /**
-     * Decodes a SensorData message from the specified reader or buffer, length delimited.
+     * Decodes a ClockSync message from the specified reader or buffer, length delimited.
      * @function decodeDelimited
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
      * @param {$protobuf.Reader|Uint8Array} reader Reader or buffer to decode from
-     * @returns {SensorData} SensorData
+     * @returns {ClockSync} ClockSync
      * @throws {Error} If the payload is not a reader or valid buffer
      * @throws {$protobuf.util.ProtocolError} If required fields are missing
      */
-    SensorData.decodeDelimited = function decodeDelimited(reader) {
+    ClockSync.decodeDelimited = function decodeDelimited(reader) {
         if (!(reader instanceof $Reader))
             reader = new $Reader(reader);
         return this.decode(reader, reader.uint32());
     };
 
     /**
-     * Verifies a SensorData message.
+     * Verifies a ClockSync message.
      * @function verify
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
      * @param {Object.<string,*>} message Plain object to verify
      * @returns {string|null} `null` if valid, otherwise the reason why it is not
      */
-    SensorData.verify = function verify(message) {
+    ClockSync.verify = function verify(message) {
         if (typeof message !== "object" || message === null)
             return "object expected";
-        if (message.usb != null && message.hasOwnProperty("usb")) {
-            let error = $root.SensorChannelData.verify(message.usb);
-            if (error)
-                return "usb." + error;
-        }
-        if (message.main != null && message.hasOwnProperty("main")) {
-            let error = $root.SensorChannelData.verify(message.main);
-            if (error)
-                return "main." + error;
-        }
-        if (message.vin != null && message.hasOwnProperty("vin")) {
-            let error = $root.SensorChannelData.verify(message.vin);
-            if (error)
-                return "vin." + error;
-        }
-        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
-            if (!$util.isInteger(message.timestampMs) && !(message.timestampMs && $util.isInteger(message.timestampMs.low) && $util.isInteger(message.timestampMs.high)))
-                return "timestampMs: integer|Long expected";
-        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
-            if (!$util.isInteger(message.uptimeMs) && !(message.uptimeMs && $util.isInteger(message.uptimeMs.low) && $util.isInteger(message.uptimeMs.high)))
-                return "uptimeMs: integer|Long expected";
+        if (message.wallUs != null && message.hasOwnProperty("wallUs"))
+            if (!$util.isInteger(message.wallUs) && !(message.wallUs && $util.isInteger(message.wallUs.low) && $util.isInteger(message.wallUs.high)))
+                return "wallUs: integer|Long expected";
+        if (message.uptimeUs != null && message.hasOwnProperty("uptimeUs"))
+            if (!$util.isInteger(message.uptimeUs) && !(message.uptimeUs && $util.isInteger(message.uptimeUs.low) && $util.isInteger(message.uptimeUs.high)))
+                return "uptimeUs: integer|Long expected";
+        if (message.uncertaintyUs != null && message.hasOwnProperty("uncertaintyUs"))
+            if (!$util.isInteger(message.uncertaintyUs))
+                return "uncertaintyUs: integer expected";
         return null;
     };
 
     /**
-     * Creates a SensorData message from a plain object. Also converts values to their respective internal types.
+     * Creates a ClockSync message from a plain object. Also converts values to their respective internal types.
      * @function fromObject
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
      * @param {Object.<string,*>} object Plain object
-     * @returns {SensorData} SensorData
+     * @returns {ClockSync} ClockSync
      */
-    SensorData.fromObject = function fromObject(object) {
-        if (object instanceof $root.SensorData)
+    ClockSync.fromObject = function fromObject(object) {
+        if (object instanceof $root.ClockSync)
             return object;
-        let message = new $root.SensorData();
-        if (object.usb != null) {
-            if (typeof object.usb !== "object")
-                throw TypeError(".SensorData.usb: object expected");
-            message.usb = $root.SensorChannelData.fromObject(object.usb);
-        }
-        if (object.main != null) {
-            if (typeof object.main !== "object")
-                throw TypeError(".SensorData.main: object expected");
-            message.main = $root.SensorChannelData.fromObject(object.main);
-        }
-        if (object.vin != null) {
-            if (typeof object.vin !== "object")
-                throw TypeError(".SensorData.vin: object expected");
-            message.vin = $root.SensorChannelData.fromObject(object.vin);
-        }
-        if (object.timestampMs != null)
+        let message = new $root.ClockSync();
+        if (object.wallUs != null)
             if ($util.Long)
-                (message.timestampMs = $util.Long.fromValue(object.timestampMs)).unsigned = true;
-            else if (typeof object.timestampMs === "string")
-                message.timestampMs = parseInt(object.timestampMs, 10);
-            else if (typeof object.timestampMs === "number")
-                message.timestampMs = object.timestampMs;
-            else if (typeof object.timestampMs === "object")
-                message.timestampMs = new $util.LongBits(object.timestampMs.low >>> 0, object.timestampMs.high >>> 0).toNumber(true);
-        if (object.uptimeMs != null)
+                (message.wallUs = $util.Long.fromValue(object.wallUs)).unsigned = true;
+            else if (typeof object.wallUs === "string")
+                message.wallUs = parseInt(object.wallUs, 10);
+            else if (typeof object.wallUs === "number")
+                message.wallUs = object.wallUs;
+            else if (typeof object.wallUs === "object")
+                message.wallUs = new $util.LongBits(object.wallUs.low >>> 0, object.wallUs.high >>> 0).toNumber(true);
+        if (object.uptimeUs != null)
             if ($util.Long)
-                (message.uptimeMs = $util.Long.fromValue(object.uptimeMs)).unsigned = true;
-            else if (typeof object.uptimeMs === "string")
-                message.uptimeMs = parseInt(object.uptimeMs, 10);
-            else if (typeof object.uptimeMs === "number")
-                message.uptimeMs = object.uptimeMs;
-            else if (typeof object.uptimeMs === "object")
-                message.uptimeMs = new $util.LongBits(object.uptimeMs.low >>> 0, object.uptimeMs.high >>> 0).toNumber(true);
+                (message.uptimeUs = $util.Long.fromValue(object.uptimeUs)).unsigned = true;
+            else if (typeof object.uptimeUs === "string")
+                message.uptimeUs = parseInt(object.uptimeUs, 10);
+            else if (typeof object.uptimeUs === "number")
+                message.uptimeUs = object.uptimeUs;
+            else if (typeof object.uptimeUs === "object")
+                message.uptimeUs = new $util.LongBits(object.uptimeUs.low >>> 0, object.uptimeUs.high >>> 0).toNumber(true);
+        if (object.uncertaintyUs != null)
+            message.uncertaintyUs = object.uncertaintyUs >>> 0;
         return message;
     };
 
     /**
-     * Creates a plain object from a SensorData message. Also converts values to other types if specified.
+     * Creates a plain object from a ClockSync message. Also converts values to other types if specified.
      * @function toObject
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
-     * @param {SensorData} message SensorData
+     * @param {ClockSync} message ClockSync
      * @param {$protobuf.IConversionOptions} [options] Conversion options
      * @returns {Object.<string,*>} Plain object
      */
-    SensorData.toObject = function toObject(message, options) {
+    ClockSync.toObject = function toObject(message, options) {
         if (!options)
             options = {};
         let object = {};
         if (options.defaults) {
-            object.usb = null;
-            object.main = null;
-            object.vin = null;
             if ($util.Long) {
                 let long = new $util.Long(0, 0, true);
-                object.timestampMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+                object.wallUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
             } else
-                object.timestampMs = options.longs === String ? "0" : 0;
+                object.wallUs = options.longs === String ? "0" : 0;
             if ($util.Long) {
                 let long = new $util.Long(0, 0, true);
-                object.uptimeMs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
+                object.uptimeUs = options.longs === String ? long.toString() : options.longs === Number ? long.toNumber() : long;
             } else
-                object.uptimeMs = options.longs === String ? "0" : 0;
+                object.uptimeUs = options.longs === String ? "0" : 0;
+            object.uncertaintyUs = 0;
         }
-        if (message.usb != null && message.hasOwnProperty("usb"))
-            object.usb = $root.SensorChannelData.toObject(message.usb, options);
-        if (message.main != null && message.hasOwnProperty("main"))
-            object.main = $root.SensorChannelData.toObject(message.main, options);
-        if (message.vin != null && message.hasOwnProperty("vin"))
-            object.vin = $root.SensorChannelData.toObject(message.vin, options);
-        if (message.timestampMs != null && message.hasOwnProperty("timestampMs"))
-            if (typeof message.timestampMs === "number")
-                object.timestampMs = options.longs === String ? String(message.timestampMs) : message.timestampMs;
+        if (message.wallUs != null && message.hasOwnProperty("wallUs"))
+            if (typeof message.wallUs === "number")
+                object.wallUs = options.longs === String ? String(message.wallUs) : message.wallUs;
             else
-                object.timestampMs = options.longs === String ? $util.Long.prototype.toString.call(message.timestampMs) : options.longs === Number ? new $util.LongBits(message.timestampMs.low >>> 0, message.timestampMs.high >>> 0).toNumber(true) : message.timestampMs;
-        if (message.uptimeMs != null && message.hasOwnProperty("uptimeMs"))
-            if (typeof message.uptimeMs === "number")
-                object.uptimeMs = options.longs === String ? String(message.uptimeMs) : message.uptimeMs;
+                object.wallUs = options.longs === String ? $util.Long.prototype.toString.call(message.wallUs) : options.longs === Number ? new $util.LongBits(message.wallUs.low >>> 0, message.wallUs.high >>> 0).toNumber(true) : message.wallUs;
+        if (message.uptimeUs != null && message.hasOwnProperty("uptimeUs"))
+            if (typeof message.uptimeUs === "number")
+                object.uptimeUs = options.longs === String ? String(message.uptimeUs) : message.uptimeUs;
             else
-                object.uptimeMs = options.longs === String ? $util.Long.prototype.toString.call(message.uptimeMs) : options.longs === Number ? new $util.LongBits(message.uptimeMs.low >>> 0, message.uptimeMs.high >>> 0).toNumber(true) : message.uptimeMs;
+                object.uptimeUs = options.longs === String ? $util.Long.prototype.toString.call(message.uptimeUs) : options.longs === Number ? new $util.LongBits(message.uptimeUs.low >>> 0, message.uptimeUs.high >>> 0).toNumber(true) : message.uptimeUs;
+        if (message.uncertaintyUs != null && message.hasOwnProperty("uncertaintyUs"))
+            object.uncertaintyUs = message.uncertaintyUs;
         return object;
     };
 
     /**
-     * Converts this SensorData to JSON.
+     * Converts this ClockSync to JSON.
      * @function toJSON
-     * @memberof SensorData
+     * @memberof ClockSync
      * @instance
      * @returns {Object.<string,*>} JSON object
      */
-    SensorData.prototype.toJSON = function toJSON() {
+    ClockSync.prototype.toJSON = function toJSON() {
         return this.constructor.toObject(this, $protobuf.util.toJSONOptions);
     };
 
     /**
-     * Gets the default type url for SensorData
+     * Gets the default type url for ClockSync
      * @function getTypeUrl
-     * @memberof SensorData
+     * @memberof ClockSync
      * @static
      * @param {string} [typeUrlPrefix] your custom typeUrlPrefix(default "type.googleapis.com")
      * @returns {string} The default type url
      */
-    SensorData.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
+    ClockSync.getTypeUrl = function getTypeUrl(typeUrlPrefix) {
         if (typeUrlPrefix === undefined) {
             typeUrlPrefix = "type.googleapis.com";
         }
-        return typeUrlPrefix + "/SensorData";
+        return typeUrlPrefix + "/ClockSync";
     };
 
-    return SensorData;
+    return ClockSync;
 })();
 
 export const WifiStatus = $root.WifiStatus = (() => {
@@ -885,6 +3606,7 @@ export const EventData = $root.EventData = (() => {
      * @property {number|Long|null} [timestampMs] EventData timestampMs
      * @property {number|Long|null} [uptimeMs] EventData uptimeMs
      * @property {string|null} [message] EventData message
+     * @property {number|null} [seq] EventData seq
      */
 
     /**
@@ -934,6 +3656,14 @@ export const EventData = $root.EventData = (() => {
      */
     EventData.prototype.message = "";
 
+    /**
+     * EventData seq.
+     * @member {number} seq
+     * @memberof EventData
+     * @instance
+     */
+    EventData.prototype.seq = 0;
+
     /**
      * Creates a new EventData instance using the specified properties.
      * @function create
@@ -966,6 +3696,8 @@ export const EventData = $root.EventData = (() => {
             writer.uint32(/* id 3, wireType 0 =*/24).uint64(message.uptimeMs);
         if (message.message != null && Object.hasOwnProperty.call(message, "message"))
             writer.uint32(/* id 4, wireType 2 =*/34).string(message.message);
+        if (message.seq != null && Object.hasOwnProperty.call(message, "seq"))
+            writer.uint32(/* id 5, wireType 0 =*/40).uint32(message.seq);
         return writer;
     };
 
@@ -1018,6 +3750,10 @@ export const EventData = $root.EventData = (() => {
                     message.message = reader.string();
                     break;
                 }
+            case 5: {
+                    message.seq = reader.uint32();
+                    break;
+                }
             default:
                 reader.skipType(tag & 7);
                 break;
@@ -1065,6 +3801,9 @@ export const EventData = $root.EventData = (() => {
         if (message.message != null && message.hasOwnProperty("message"))
             if (!$util.isString(message.message))
                 return "message: string expected";
+        if (message.seq != null && message.hasOwnProperty("seq"))
+            if (!$util.isInteger(message.seq))
+                return "seq: integer expected";
         return null;
     };
 
@@ -1102,6 +3841,8 @@ export const EventData = $root.EventData = (() => {
                 message.uptimeMs = new $util.LongBits(object.uptimeMs.low >>> 0, object.uptimeMs.high >>> 0).toNumber(true);
         if (object.message != null)
             message.message = String(object.message);
+        if (object.seq != null)
+            message.seq = object.seq >>> 0;
         return message;
     };
 
@@ -1131,6 +3872,7 @@ export const EventData = $root.EventData = (() => {
             } else
                 object.uptimeMs = options.longs === String ? "0" : 0;
             object.message = "";
+            object.seq = 0;
         }
         if (message.level != null && message.hasOwnProperty("level"))
             object.level = message.level;
@@ -1146,6 +3888,8 @@ export const EventData = $root.EventData = (() => {
                 object.uptimeMs = options.longs === String ? $util.Long.prototype.toString.call(message.uptimeMs) : options.longs === Number ? new $util.LongBits(message.uptimeMs.low >>> 0, message.uptimeMs.high >>> 0).toNumber(true) : message.uptimeMs;
         if (message.message != null && message.hasOwnProperty("message"))
             object.message = message.message;
+        if (message.seq != null && message.hasOwnProperty("seq"))
+            object.seq = message.seq;
         return object;
     };
 
@@ -1632,6 +4376,10 @@ export const StatusMessage = $root.StatusMessage = (() => {
      * @property {ILoadSwStatus|null} [swStatus] StatusMessage swStatus
      * @property {IUartData|null} [uartData] StatusMessage uartData
      * @property {IEventData|null} [eventData] StatusMessage eventData
+     * @property {ISensorDataRaw|null} [sensorDataRaw] StatusMessage sensorDataRaw
+     * @property {ISensorStats|null} [sensorStats] StatusMessage sensorStats
+     * @property {IClockSync|null} [clockSync] StatusMessage clockSync
+     * @property {ISensorBatch|null} [sensorBatch] StatusMessage sensorBatch
      */
 
     /**
@@ -1689,17 +4437,49 @@ export const StatusMessage = $root.StatusMessage = (() => {
      */
     StatusMessage.prototype.eventData = null;
 
+    /**
+     * StatusMessage sensorDataRaw.
+     * @member {ISensorDataRaw|null|undefined} sensorDataRaw
+     * @memberof StatusMessage
+     * @instance
+     */
+    StatusMessage.prototype.sensorDataRaw = null;
+
+    /**
+     * StatusMessage sensorStats.
+     * @member {ISensorStats|null|undefined} sensorStats
+     * @memberof StatusMessage
+     * @instance
+     */
+    StatusMessage.prototype.sensorStats = null;
+
+    /**
+     * StatusMessage clockSync.
+     * @member {IClockSync|null|undefined} clockSync
+     * @memberof StatusMessage
+     * @instance
+     */
+    StatusMessage.prototype.clockSync = null;
+
+    /**
+     * StatusMessage sensorBatch.
+     * @member {ISensorBatch|null|undefined} sensorBatch
+     * @memberof StatusMessage
+     * @instance
+     */
+    StatusMessage.prototype.sensorBatch = null;
+
     // OneOf field names bound to virtual getters and setters
     let $oneOfFields;
 
     /**
      * StatusMessage payload.
-     * @member {"sensorData"|"wifiStatus"|"swStatus"|"uartData"|"eventData"|undefined} payload
+     * @member {"sensorData"|"wifiStatus"|"swStatus"|"uartData"|"eventData"|"sensorDataRaw"|"sensorStats"|"clockSync"|"sensorBatch"|undefined} payload
      * @memberof StatusMessage
      * @instance
      */
     Object.defineProperty(StatusMessage.prototype, "payload", {
-        get: $util.oneOfGetter($oneOfFields = ["sensorData", "wifiStatus", "swStatus", "uartData", "eventData"]),
+        get: $util.oneOfGetter($oneOfFields = ["sensorData", "wifiStatus", "swStatus", "uartData", "eventData", "sensorDataRaw", "sensorStats", "clockSync", "sensorBatch"]),
         set: $util.oneOfSetter($oneOfFields)
     });
 
@@ -1737,6 +4517,14 @@ export const StatusMessage = $root.StatusMessage = (() => {
             $root.UartData.encode(message.uartData, writer.uint32(/* id 4, wireType 2 =*/34).fork()).ldelim();
         if (message.eventData != null && Object.hasOwnProperty.call(message, "eventData"))
             $root.EventData.encode(message.eventData, writer.uint32(/* id 5, wireType 2 =*/42).fork()).ldelim();
+        if (message.sensorDataRaw != null && Object.hasOwnProperty.call(message, "sensorDataRaw"))
+            $root.SensorDataRaw.encode(message.sensorDataRaw, writer.uint32(/* id 6, wireType 2 =*/50).fork()).ldelim();
+        if (message.sensorStats != null && Object.hasOwnProperty.call(message, "sensorStats"))
+            $root.SensorStats.encode(message.sensorStats, writer.uint32(/* id 7, wireType 2 =*/58).fork()).ldelim();
+        if (message.clockSync != null && Object.hasOwnProperty.call(message, "clockSync"))
+            $root.ClockSync.encode(message.clockSync, writer.uint32(/* id 8, wireType 2 =*/66).fork()).ldelim();
+        if (message.sensorBatch != null && Object.hasOwnProperty.call(message, "sensorBatch"))
+            $root.SensorBatch.encode(message.sensorBatch, writer.uint32(/* id 9, wireType 2 =*/74).fork()).ldelim();
         return writer;
     };
 
@@ -1793,6 +4581,22 @@ export const StatusMessage = $root.StatusMessage = (() => {
                     message.eventData = $root.EventData.decode(reader, reader.uint32());
                     break;
                 }
+            case 6: {
+                    message.sensorDataRaw = $root.SensorDataRaw.decode(reader, reader.uint32());
+                    break;
+                }
+            case 7: {
+                    message.sensorStats = $root.SensorStats.decode(reader, reader.uint32());
+                    break;
+                }
+            case 8: {
+                    message.clockSync = $root.ClockSync.decode(reader, reader.uint32());
+                    break;
+                }
+            case 9: {
+                    message.sensorBatch = $root.SensorBatch.decode(reader, reader.uint32());
+                    break;
+                }
             default:
                 reader.skipType(tag & 7);
                 break;
@@ -1877,6 +4681,46 @@ export const StatusMessage = $root.StatusMessage = (() => {
                     return "eventData." + error;
             }
         }
+        if (message.sensorDataRaw != null && message.hasOwnProperty("sensorDataRaw")) {
+            if (properties.payload === 1)
+                return "payload: multiple values";
+            properties.payload = 1;
+            {
+                let error = $root.SensorDataRaw.verify(message.sensorDataRaw);
+                if (error)
+                    return "sensorDataRaw." + error;
+            }
+        }
+        if (message.sensorStats != null && message.hasOwnProperty("sensorStats")) {
+            if (properties.payload === 1)
+                return "payload: multiple values";
+            properties.payload = 1;
+            {
+                let error = $root.SensorStats.verify(message.sensorStats);
+                if (error)
+                    return "sensorStats." + error;
+            }
+        }
+        if (message.clockSync != null && message.hasOwnProperty("clockSync")) {
+            if (properties.payload === 1)
+                return "payload: multiple values";
+            properties.payload = 1;
+            {
+                let error = $root.ClockSync.verify(message.clockSync);
+                if (error)
+                    return "clockSync." + error;
+            }
+        }
+        if (message.sensorBatch != null && message.hasOwnProperty("sensorBatch")) {
+            if (properties.payload === 1)
+                return "payload: multiple values";
+            properties.payload = 1;
+            {
+                let error = $root.SensorBatch.verify(message.sensorBatch);
+                if (error)
+                    return "sensorBatch." + error;
+            }
+        }
         return null;
     };
 
@@ -1917,6 +4761,26 @@ export const StatusMessage = $root.StatusMessage = (() => {
                 throw TypeError(".StatusMessage.eventData: object expected");
             message.eventData = $root.EventData.fromObject(object.eventData);
         }
+        if (object.sensorDataRaw != null) {
+            if (typeof object.sensorDataRaw !== "object")
+                throw TypeError(".StatusMessage.sensorDataRaw: object expected");
+            message.sensorDataRaw = $root.SensorDataRaw.fromObject(object.sensorDataRaw);
+        }
+        if (object.sensorStats != null) {
+            if (typeof object.sensorStats !== "object")
+                throw TypeError(".StatusMessage.sensorStats: object expected");
+            message.sensorStats = $root.SensorStats.fromObject(object.sensorStats);
+        }
+        if (object.clockSync != null) {
+            if (typeof object.clockSync !== "object")
+                throw TypeError(".StatusMessage.clockSync: object expected");
+            message.clockSync = $root.ClockSync.fromObject(object.clockSync);
+        }
+        if (object.sensorBatch != null) {
+            if (typeof object.sensorBatch !== "object")
+                throw TypeError(".StatusMessage.sensorBatch: object expected");
+            message.sensorBatch = $root.SensorBatch.fromObject(object.sensorBatch);
+        }
         return message;
     };
 
@@ -1958,6 +4822,26 @@ export const StatusMessage = $root.StatusMessage = (() => {
             if (options.oneofs)
                 object.payload = "eventData";
         }
+        if (message.sensorDataRaw != null && message.hasOwnProperty("sensorDataRaw")) {
+            object.sensorDataRaw = $root.SensorDataRaw.toObject(message.sensorDataRaw, options);
+            if (options.oneofs)
+                object.payload = "sensorDataRaw";
+        }
+        if (message.sensorStats != null && message.hasOwnProperty("sensorStats")) {
+            object.sensorStats = $root.SensorStats.toObject(message.sensorStats, options);
+            if (options.oneofs)
+                object.payload = "sensorStats";
+        }
+        if (message.clockSync != null && message.hasOwnProperty("clockSync")) {
+            object.clockSync = $root.ClockSync.toObject(message.clockSync, options);
+            if (options.oneofs)
+                object.payload = "clockSync";
+        }
+        if (message.sensorBatch != null && message.hasOwnProperty("sensorBatch")) {
+            object.sensorBatch = $root.SensorBatch.toObject(message.sensorBatch, options);
+            if (options.oneofs)
+                object.payload = "sensorBatch";
+        }
         return object;
     };
 
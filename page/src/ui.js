@@ -81,6 +81,7 @@ export function updateSensorUI(data) {
         dom.voltageDisplay.textContent = `${data.VIN.voltage.toFixed(2)} V`;
         dom.currentDisplay.textContent = `${data.VIN.current.toFixed(2)} A`;
         dom.powerDisplay.textContent = `${data.VIN.power.toFixed(2)} W`;
+        dom.energyDisplay.textContent = `${data.VIN.energyWh.toFixed(2)} Wh`;
     }
 
     // Pass the entire multi-channel data object to the charts
@@ -407,6 +408,47 @@ export async function applyPeriodSettings() {
     }
 }
 
+/**
+ * Shows the sample rate and noise floor that follow from the sensor timing settings.
+ * @param {Object} data Settings or POST response carrying the sensor_* timing fields.
+ */
+function updateSensorTimingInfo(data) {
+    if (data.sensor_sample_rate_hz === undefined) return;
+    dom.sensorTimingInfo.textContent =
+        `Cycle ${(data.sensor_conversion_time_us / 1000).toFixed(1)} ms, ` +
+        `${data.sensor_sample_rate_hz.toFixed(1)} samples/s, ` +
+        `noise floor ~${data.sensor_noise_floor_ma.toFixed(2)} mA`;
+}
+
+/**
+ * Applies the selected INA3221 averaging, conversion times, channels and stream format.
+ */
+export async function applySensorTimingSettings() {
+    const channels = dom.sensorChannelCheckboxes.filter(box => box.checked).map(box => box.value).join(',');
+    if (!channels) {
+        alert('At least one channel must stay enabled.');
+        return;
+    }
+
+    dom.sensorTimingApplyButton.disabled = true;
+    dom.sensorTimingApplyButton.innerHTML = `<span class="spinner-border spinner-border-sm" aria-hidden="true"></span> Applying...`;
+
+    try {
+        const data = await api.postSensorTimingSetting(
+            parseInt(dom.sensorAveragingSelect.value, 10),
+            parseInt(dom.sensorBusCtSelect.value, 10),
+            parseInt(dom.sensorShuntCtSelect.value, 10),
+            dom.sensorFormatSelect.value,
+            channels);
+        updateSensorTimingInfo(data);
+    } catch (error) {
+        console.error('Error applying sensor timing:', error);
+    } finally {
+        dom.sensorTimingApplyButton.disabled = false;
+        dom.sensorTimingApplyButton.innerHTML = 'Apply';
+    }
+}
+
 /**
  * Applies the output state restore setting.
  */
@@ -467,6 +509,21 @@ export async function initializeSettings() {
             dom.periodSlider.value = data.period;
             dom.periodValue.textContent = data.period;
         }
+        if (data.sensor_averaging) {
+            dom.sensorAveragingSelect.value = data.sensor_averaging;
+            dom.sensorBusCtSelect.value = data.sensor_bus_ct_us;
+            dom.sensorShuntCtSelect.value = data.sensor_shunt_ct_us;
+            updateSensorTimingInfo(data);
+        }
+        if (data.sensor_format) {
+            dom.sensorFormatSelect.value = data.sensor_format;
+        }
+        if (data.sensor_channels !== undefined) {
+            const enabled = data.sensor_channels.split(',');
+            dom.sensorChannelCheckboxes.forEach(box => {
+                box.checked = enabled.includes(box.value);
+            });
+        }
         dom.restoreOutputStateToggle.checked = data.restore_output_state === true;
 
     } catch (error) {